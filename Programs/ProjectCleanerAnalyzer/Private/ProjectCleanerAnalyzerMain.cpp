@@ -0,0 +1,133 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "ProjectCleanerRegistryAnalyzer.h"
+#include "ProjectCleanerReportWriter.h"
+// Engine Headers
+#include "RequiredProgramMainCPPInclude.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY(LogProjectCleanerAnalyzer);
+
+IMPLEMENT_APPLICATION(ProjectCleanerAnalyzer, "ProjectCleanerAnalyzer");
+
+namespace ProjectCleanerAnalyzer
+{
+	/** Accepts project folder or .uproject file */
+	FString GetProjectDir(const FString& Project)
+	{
+		const FString ProjectPath = FPaths::ConvertRelativePathToFull(Project);
+		return FPaths::GetExtension(ProjectPath).Equals(TEXT("uproject"), ESearchCase::IgnoreCase) ? FPaths::GetPath(ProjectPath) : ProjectPath;
+	}
+
+	int32 Run(const TCHAR* CommandLine)
+	{
+		FCleanerRegistryAnalyzerSettings Settings;
+		if (!FParse::Value(CommandLine, TEXT("RegistryFile="), Settings.RegistryFile))
+		{
+			UE_LOG(LogProjectCleanerAnalyzer, Error, TEXT("-RegistryFile= is required"));
+			return 1;
+		}
+
+		FString Project;
+		if (FParse::Value(CommandLine, TEXT("Project="), Project))
+		{
+			Settings.ProjectDir = GetProjectDir(Project);
+		}
+
+		// same exclusions ProjectCleanerCLI commandlet takes, values are not validated against registry here
+		FString ExcludePaths;
+		if (FParse::Value(CommandLine, TEXT("ExcludePaths="), ExcludePaths, false) || FParse::Value(CommandLine, TEXT("ExcludeAssetsInPath="), ExcludePaths, false))
+		{
+			ExcludePaths.ParseIntoArray(Settings.ExcludedPaths, TEXT(","));
+		}
+
+		FString ExcludeAssets;
+		if (FParse::Value(CommandLine, TEXT("ExcludeAssets="), ExcludeAssets, false))
+		{
+			ExcludeAssets.ParseIntoArray(Settings.ExcludedAssets, TEXT(","));
+		}
+
+		FString ExcludeClasses;
+		if (FParse::Value(CommandLine, TEXT("ExcludeAssetsWithClass="), ExcludeClasses, false))
+		{
+			ExcludeClasses.ParseIntoArray(Settings.ExcludedClasses, TEXT(","));
+		}
+
+		Settings.bScanDeveloperContents = FParse::Param(CommandLine, TEXT("ScanDevContent"));
+
+		ECleanerReportFormat ReportFormat = ECleanerReportFormat::Json;
+		FString ReportFormatValue;
+		if (FParse::Value(CommandLine, TEXT("Report="), ReportFormatValue) && !FProjectCleanerReportWriter::ParseFormat(ReportFormatValue, ReportFormat))
+		{
+			UE_LOG(LogProjectCleanerAnalyzer, Error, TEXT("%s - Invalid report format, must be json, csv or ndjson"), *ReportFormatValue);
+			return 1;
+		}
+
+		const bool bCompressReport = FParse::Param(CommandLine, TEXT("ReportCompress"));
+		FString ReportFile;
+		if (!FParse::Value(CommandLine, TEXT("ReportFile="), ReportFile))
+		{
+			// default path is relative to saved folder of program, report belongs to analyzed project instead
+			const FString DefaultReportFile = FProjectCleanerReportWriter::GetDefaultReportPath(ReportFormat, bCompressReport);
+			ReportFile = Settings.ProjectDir.IsEmpty() ? DefaultReportFile : Settings.ProjectDir / TEXT("Saved/ProjectCleaner") / FPaths::GetCleanFilename(DefaultReportFile);
+		}
+
+		UE_LOG(LogProjectCleanerAnalyzer, Display, TEXT("Differences from editor analysis:"));
+		for (const auto& Difference : FProjectCleanerRegistryAnalyzer::GetDifferences())
+		{
+			UE_LOG(LogProjectCleanerAnalyzer, Display, TEXT("	%s"), *Difference);
+		}
+
+		FProjectCleanerRegistryAnalyzer Analyzer{Settings};
+		if (!Analyzer.Run())
+		{
+			return 1;
+		}
+
+		UE_LOG(LogProjectCleanerAnalyzer, Display, TEXT("Assets - %d (%lld bytes)"), Analyzer.GetAssetsNum(), Analyzer.GetTotalSize());
+		UE_LOG(LogProjectCleanerAnalyzer, Display, TEXT("Unused Assets - %d (%lld bytes)"), Analyzer.GetUnusedAssetsNum(), Analyzer.GetUnusedSize());
+
+		FProjectCleanerReportWriter Writer{ReportFormat, bCompressReport};
+		if (!Writer.Open(ReportFile))
+		{
+			return 1;
+		}
+
+		Analyzer.WriteReport(Writer);
+
+		if (!Writer.Close())
+		{
+			UE_LOG(LogProjectCleanerAnalyzer, Error, TEXT("Failed to write report %s"), *ReportFile);
+			return 1;
+		}
+
+		UE_LOG(LogProjectCleanerAnalyzer, Display, TEXT("Report: %lld rows written to %s"), Writer.GetRowsNum(), *ReportFile);
+		return 0;
+	}
+}
+
+INT32_MAIN_INT32_ARGC_TCHAR_ARGV()
+{
+	const double StartTime = FPlatformTime::Seconds();
+	GEngineLoop.PreInit(ArgC, ArgV);
+
+	// CLI - arguments
+	// -RegistryFile= D:/Project/Saved/ProjectCleaner/AssetRegistry.bin - written by ProjectCleanerCLI commandlet with -SaveRegistryFile=
+	// -Project= D:/Project/Project.uproject - project folder or file, needed for content files, indirect references and primary asset classes
+	// -ExcludePaths= /Game/Props,/Game/Developers (or -ExcludeAssetsInPath=)
+	// -ExcludeAssets= /Game/Props/SM_Chair.SM_Chair
+	// -ExcludeAssetsWithClass= Material,BP_Door_C
+	// -ScanDevContent
+	// -Report= json|csv|ndjson
+	// -ReportFile= D:/Reports/Cleaner.json
+	// -ReportCompress
+	UE_LOG(LogProjectCleanerAnalyzer, Display, TEXT("Startup - %.3f s"), FPlatformTime::Seconds() - StartTime);
+
+	const int32 Result = ProjectCleanerAnalyzer::Run(FCommandLine::Get());
+
+	UE_LOG(LogProjectCleanerAnalyzer, Display, TEXT("Total - %.3f s"), FPlatformTime::Seconds() - StartTime);
+
+	FEngineLoop::AppPreExit();
+	FEngineLoop::AppExit();
+	return Result;
+}
@@ -0,0 +1,663 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "ProjectCleanerRegistryAnalyzer.h"
+#include "ProjectCleanerReportWriter.h"
+// Engine Headers
+#include "AssetRegistry/AssetData.h"
+#include "Async/MappedFileHandle.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/LargeMemoryReader.h"
+#include "Serialization/MemoryReader.h"
+
+namespace ProjectCleanerRegistryAnalyzer
+{
+	const TCHAR* GameRoot = TEXT("/Game/");
+	const TCHAR* DevelopersRoot = TEXT("/Game/Developers/");
+	const TCHAR* MegascansRoot = TEXT("/Game/MSPresets");
+
+	// primary asset types of BaseGame.ini, project config only adds to them
+	const TCHAR* DefaultPrimaryAssetClasses[] = {TEXT("World"), TEXT("PrimaryAssetLabel")};
+	// lighting data of maps is used whenever map is, editor analysis keeps it same way
+	const TCHAR* MapBuildDataClass = TEXT("MapBuildDataRegistry");
+}
+
+FProjectCleanerRegistryAnalyzer::FProjectCleanerRegistryAnalyzer(const FCleanerRegistryAnalyzerSettings& InSettings) :
+	Settings(InSettings)
+{
+	for (const auto& ExcludedPath : Settings.ExcludedPaths)
+	{
+		ExcludedPathsTrie.Add(ExcludedPath);
+	}
+
+	for (const auto& ExcludedAsset : Settings.ExcludedAssets)
+	{
+		ExcludedAssets.Add(FName{*ExcludedAsset});
+	}
+
+	for (const auto& ExcludedClass : Settings.ExcludedClasses)
+	{
+		ExcludedClasses.Add(FName{*ExcludedClass});
+	}
+}
+
+bool FProjectCleanerRegistryAnalyzer::Run()
+{
+	Stages.Reset();
+
+	bool bLoaded = false;
+	RunStage(TEXT("LoadRegistry"), [&] ()
+	{
+		bLoaded = LoadRegistry();
+		return static_cast<int64>(State.GetNumAssets());
+	});
+
+	if (!bLoaded) return false;
+
+	RunStage(TEXT("BuildDependencyGraph"), [this] () { return BuildGraph(); });
+	RunStage(TEXT("FindContentFiles"), [this] () { return FindContentFiles(); });
+	RunStage(TEXT("FindPrimaryAssetClasses"), [this] () { return FindPrimaryAssetClasses(); });
+	RunStage(TEXT("FindIndirectAssets"), [this] () { return FindIndirectAssets(); });
+	RunStage(TEXT("FindUnusedAssets"), [this] () { return FindUnusedAssets(); });
+
+	return true;
+}
+
+void FProjectCleanerRegistryAnalyzer::WriteReport(FProjectCleanerReportWriter& Writer) const
+{
+	// same categories and columns editor report uses, so both can be read by same tools
+	Writer.BeginCategory(TEXT("unused"));
+	for (const FAssetData* AssetData : UnusedAssets)
+	{
+		Writer.BeginRow();
+		Writer.AddString(TEXT("path"), AssetData->ObjectPath.ToString());
+		Writer.AddString(TEXT("class"), GetClassName(*AssetData).ToString());
+		Writer.AddInteger(TEXT("size_bytes"), GetPackageSize(AssetData->PackageName));
+		Writer.EndRow();
+	}
+	Writer.EndCategory();
+
+	Writer.BeginCategory(TEXT("excluded"));
+	for (const auto& Package : ExcludedPackages)
+	{
+		Writer.BeginRow();
+		Writer.AddString(TEXT("path"), Package.ToString());
+		Writer.AddInteger(TEXT("size_bytes"), GetPackageSize(Package));
+		Writer.EndRow();
+	}
+	Writer.EndCategory();
+
+	Writer.BeginCategory(TEXT("indirect"));
+	for (const auto& IndirectReference : IndirectReferences)
+	{
+		Writer.BeginRow();
+		Writer.AddString(TEXT("path"), IndirectReference.AssetData->ObjectPath.ToString());
+		Writer.AddString(TEXT("class"), GetClassName(*IndirectReference.AssetData).ToString());
+		Writer.AddString(TEXT("file"), IndirectReference.File);
+		Writer.AddInteger(TEXT("line"), IndirectReference.Line);
+		Writer.EndRow();
+	}
+	Writer.EndCategory();
+
+	const auto WriteFiles = [&] (const TCHAR* Category, const TMap<FString, int64>& Files)
+	{
+		Writer.BeginCategory(Category);
+		for (const auto& File : Files)
+		{
+			Writer.BeginRow();
+			Writer.AddString(TEXT("path"), File.Key);
+			Writer.AddInteger(TEXT("size_bytes"), File.Value);
+			Writer.EndRow();
+		}
+		Writer.EndCategory();
+	};
+	WriteFiles(TEXT("non_engine"), NonEngineFiles);
+	WriteFiles(TEXT("orphaned"), OrphanedFiles);
+
+	Writer.BeginCategory(TEXT("empty_folders"));
+	for (const auto& EmptyFolder : EmptyFolders)
+	{
+		Writer.BeginRow();
+		Writer.AddString(TEXT("path"), EmptyFolder);
+		Writer.EndRow();
+	}
+	Writer.EndCategory();
+
+	// readers comparing with editor report see what this one can not contain
+	Writer.BeginCategory(TEXT("differences"));
+	for (const auto& Difference : GetDifferences())
+	{
+		Writer.BeginRow();
+		Writer.AddString(TEXT("name"), Difference);
+		Writer.EndRow();
+	}
+	Writer.EndCategory();
+
+	Writer.BeginCategory(TEXT("stages"));
+	for (const auto& Stage : Stages)
+	{
+		Writer.BeginRow();
+		Writer.AddString(TEXT("name"), Stage.Name.ToString());
+		Writer.AddNumber(TEXT("wall_time_sec"), Stage.WallTime);
+		Writer.AddInteger(TEXT("items"), Stage.ItemsProcessed);
+		Writer.EndRow();
+	}
+	Writer.EndCategory();
+}
+
+int32 FProjectCleanerRegistryAnalyzer::GetAssetsNum() const
+{
+	return Assets.Num();
+}
+
+int32 FProjectCleanerRegistryAnalyzer::GetUnusedAssetsNum() const
+{
+	return UnusedAssets.Num();
+}
+
+int64 FProjectCleanerRegistryAnalyzer::GetTotalSize() const
+{
+	return TotalSize;
+}
+
+int64 FProjectCleanerRegistryAnalyzer::GetUnusedSize() const
+{
+	return UnusedSize;
+}
+
+const TArray<FCleanerRegistryAnalyzerStage>& FProjectCleanerRegistryAnalyzer::GetStages() const
+{
+	return Stages;
+}
+
+const TArray<FString>& FProjectCleanerRegistryAnalyzer::GetDifferences()
+{
+	static const TArray<FString> Differences = {
+		TEXT("Native class hierarchy is not in registry, assets of C++ subclasses of primary asset classes are used only if their class is listed in DefaultGame.ini"),
+		TEXT("Primary asset types come from project DefaultGame.ini and engine defaults, not from plugin configs or types registered at runtime"),
+		TEXT("Package files missing from registry are counted but not reported as corrupted, package headers are not validated"),
+		TEXT("Duplicates, redirectors, biggest wins, folder and class sizes are not reported"),
+	};
+
+	return Differences;
+}
+
+bool FProjectCleanerRegistryAnalyzer::LoadRegistry()
+{
+	// file is mapped instead of read, registry state is deserialized straight from page cache
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const TUniquePtr<IMappedFileHandle> MappedFile{PlatformFile.OpenMapped(*Settings.RegistryFile)};
+	const TUniquePtr<IMappedFileRegion> MappedRegion{MappedFile.IsValid() ? MappedFile->MapRegion() : nullptr};
+
+	TArray<uint8> FileData;
+	TUniquePtr<FArchive> Reader;
+	if (MappedRegion.IsValid())
+	{
+		Reader = MakeUnique<FLargeMemoryReader>(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize());
+	}
+	else if (FFileHelper::LoadFileToArray(FileData, *Settings.RegistryFile))
+	{
+		Reader = MakeUnique<FMemoryReader>(FileData, true);
+	}
+	else
+	{
+		UE_LOG(LogProjectCleanerAnalyzer, Error, TEXT("Failed to open asset registry file %s"), *Settings.RegistryFile);
+		return false;
+	}
+
+	FAssetRegistryVersion::Type Version;
+	if (!FAssetRegistryVersion::SerializeVersion(*Reader, Version))
+	{
+		UE_LOG(LogProjectCleanerAnalyzer, Error, TEXT("%s is not asset registry file or was saved by newer engine version"), *Settings.RegistryFile);
+		return false;
+	}
+
+	Reader->Seek(0);
+
+	// state is used on its own, asset registry module is never started, so nothing is gathered from disk
+	if (!State.Load(*Reader) || Reader->IsError())
+	{
+		UE_LOG(LogProjectCleanerAnalyzer, Error, TEXT("Failed to read asset registry file %s"), *Settings.RegistryFile);
+		return false;
+	}
+
+	return true;
+}
+
+int64 FProjectCleanerRegistryAnalyzer::BuildGraph()
+{
+	const FName RedirectorClass{TEXT("ObjectRedirector")};
+	const TMap<FName, const FAssetData*>& ObjectPathToAssetData = State.GetObjectPathToAssetDataMap();
+
+	Assets.Reset(ObjectPathToAssetData.Num());
+	GraphPackages.Reset(ObjectPathToAssetData.Num());
+	GraphPackageIndices.Reset();
+	GraphPackageIndices.Reserve(ObjectPathToAssetData.Num());
+
+	for (const auto& Pair : ObjectPathToAssetData)
+	{
+		const FAssetData* AssetData = Pair.Value;
+		if (!GraphPackageIndices.Contains(AssetData->PackageName))
+		{
+			GraphPackageIndices.Add(AssetData->PackageName, GraphPackages.Add(AssetData->PackageName));
+		}
+
+		// redirectors stay graph nodes, references through them reach destination
+		if (AssetData->AssetClass != RedirectorClass && AssetData->PackageName.ToString().StartsWith(ProjectCleanerRegistryAnalyzer::GameRoot))
+		{
+			Assets.Add(AssetData);
+		}
+	}
+
+	TArray<TPair<int32, int32>> Edges;
+	TArray<FAssetIdentifier> Dependencies;
+	for (int32 Node = 0; Node < GraphPackages.Num(); ++Node)
+	{
+		Dependencies.Reset();
+		State.GetDependencies(FAssetIdentifier{GraphPackages[Node]}, Dependencies, UE::AssetRegistry::EDependencyCategory::Package);
+
+		for (const auto& Dependency : Dependencies)
+		{
+			// script packages and packages missing from registry are not part of graph
+			const int32* DependencyNode = GraphPackageIndices.Find(Dependency.PackageName);
+			if (DependencyNode && *DependencyNode != Node)
+			{
+				Edges.Emplace(Node, *DependencyNode);
+			}
+		}
+	}
+
+	DependencyGraph.Build(GraphPackages.Num(), Edges);
+
+	UE_LOG(LogProjectCleanerAnalyzer, Display, TEXT("Dependency graph: %d packages, %d edges"), DependencyGraph.GetNodesNum(), DependencyGraph.GetEdgesNum());
+
+	return Edges.Num();
+}
+
+int64 FProjectCleanerRegistryAnalyzer::FindContentFiles()
+{
+	PackageDiskSizes.Reset();
+	NonEngineFiles.Reset();
+	OrphanedFiles.Reset();
+	EmptyFolders.Reset();
+	UnregisteredFilesNum = 0;
+
+	if (Settings.ProjectDir.IsEmpty())
+	{
+		UE_LOG(LogProjectCleanerAnalyzer, Warning, TEXT("No -Project given, Content folder is not scanned, package sizes come from registry"));
+		return 0;
+	}
+
+	const FString ContentDir = FPaths::ConvertRelativePathToFull(Settings.ProjectDir / TEXT("Content/"));
+
+	// stat walk gives sizes together with paths, so no file is opened
+	TMap<FString, FName> PackageStems;
+	TArray<TPair<FString, int64>> PackageFiles;
+	TSet<FString> Folders;
+	TSet<FString> NonEmptyFolders;
+	int64 VisitedFilesNum = 0;
+	FPlatformFileManager::Get().GetPlatformFile().IterateDirectoryStatRecursively(*ContentDir, [&] (const TCHAR* FilenameOrDirectory, const FFileStatData& StatData)
+	{
+		const FString Path = FilenameOrDirectory;
+		if (StatData.bIsDirectory)
+		{
+			Folders.Add(Path + TEXT("/"));
+			return true;
+		}
+
+		++VisitedFilesNum;
+
+		// every folder above file is not empty, walk stops at first folder already known to be so
+		FString Folder = FPaths::GetPath(Path) + TEXT("/");
+		while (Folder.Len() > ContentDir.Len() && !NonEmptyFolders.Contains(Folder))
+		{
+			NonEmptyFolders.Add(Folder);
+			Folder = FPaths::GetPath(Folder.LeftChop(1)) + TEXT("/");
+		}
+
+		const FString Extension = FPaths::GetExtension(Path, false);
+		if (FCleanerContentFiles::IsPackageExtension(Extension))
+		{
+			const FString Stem = FCleanerContentFiles::GetPackageFileStem(Path);
+			PackageStems.Add(Stem, FName{*(ProjectCleanerRegistryAnalyzer::GameRoot + Stem.RightChop(ContentDir.Len()))});
+			PackageFiles.Emplace(Path, StatData.FileSize);
+		}
+		else if (FCleanerContentFiles::IsCompanionExtension(Extension))
+		{
+			// owning package may be visited later, so companions are matched after walk
+			PackageFiles.Emplace(Path, StatData.FileSize);
+		}
+		else
+		{
+			NonEngineFiles.Add(Path, StatData.FileSize);
+		}
+
+		return true;
+	});
+
+	for (const auto& PackageFile : PackageFiles)
+	{
+		if (const FName* PackageName = PackageStems.Find(FCleanerContentFiles::GetPackageFileStem(PackageFile.Key)))
+		{
+			PackageDiskSizes.FindOrAdd(*PackageName) += PackageFile.Value;
+			continue;
+		}
+
+		OrphanedFiles.Add(PackageFile.Key, PackageFile.Value);
+	}
+
+	// registry file may list cooked packages only, so package it does not know is not reported as corrupted
+	for (const auto& PackageStem : PackageStems)
+	{
+		if (!GraphPackageIndices.Contains(PackageStem.Value))
+		{
+			++UnregisteredFilesNum;
+		}
+	}
+
+	if (UnregisteredFilesNum > 0)
+	{
+		UE_LOG(LogProjectCleanerAnalyzer, Warning, TEXT("%d package files are not listed in registry file, they are not analysed"), UnregisteredFilesNum);
+	}
+
+	// same folders editor analysis never reports, Developers and Collections are skipped unless developer content is scanned
+	const FString CollectionsFolder = ContentDir + TEXT("Collections/");
+	const FString DevelopersFolder = ContentDir + TEXT("Developers/");
+	const FString UserFolder = DevelopersFolder + FPaths::GameUserDeveloperFolderName() + TEXT("/");
+	const TSet<FString> KeptFolders{CollectionsFolder, DevelopersFolder, UserFolder, UserFolder + TEXT("Collections/")};
+	for (const auto& Folder : Folders)
+	{
+		if (NonEmptyFolders.Contains(Folder) || KeptFolders.Contains(Folder)) continue;
+
+		if (!Settings.bScanDeveloperContents && (FPaths::IsUnderDirectory(Folder, CollectionsFolder) || FPaths::IsUnderDirectory(Folder, DevelopersFolder))) continue;
+
+		EmptyFolders.Add(Folder);
+	}
+
+	return VisitedFilesNum;
+}
+
+int64 FProjectCleanerRegistryAnalyzer::FindPrimaryAssetClasses()
+{
+	PrimaryAssetClasses.Reset();
+	for (const TCHAR* ClassName : ProjectCleanerRegistryAnalyzer::DefaultPrimaryAssetClasses)
+	{
+		PrimaryAssetClasses.Add(ClassName);
+	}
+
+	// blueprint classes keep their parent in tags, so subclasses of primary classes are found at any depth
+	ClassHierarchy.Reset();
+	FString GeneratedClassPath;
+	FString ParentClassPath;
+	for (const auto& Pair : State.GetObjectPathToAssetDataMap())
+	{
+		const FAssetData* AssetData = Pair.Value;
+		if (!AssetData->GetTagValue(TEXT("GeneratedClass"), GeneratedClassPath)) continue;
+
+		if (AssetData->GetTagValue(TEXT("ParentClass"), ParentClassPath) || AssetData->GetTagValue(TEXT("NativeParentClass"), ParentClassPath))
+		{
+			ClassHierarchy.Add(GetClassNameFromPath(GeneratedClassPath), GetClassNameFromPath(ParentClassPath));
+		}
+	}
+
+	if (Settings.ProjectDir.IsEmpty()) return PrimaryAssetClasses.Num();
+
+	// +PrimaryAssetTypesToScan=(PrimaryAssetType="Map",AssetBaseClass=/Script/Engine.World,...) lines of asset manager settings
+	TArray<FString> Lines;
+	FFileHelper::LoadFileToStringArray(Lines, *(Settings.ProjectDir / TEXT("Config/DefaultGame.ini")));
+	for (const auto& Line : Lines)
+	{
+		const FString TrimmedLine = Line.TrimStartAndEnd();
+		if (!TrimmedLine.StartsWith(TEXT("+PrimaryAssetTypesToScan=")) && !TrimmedLine.StartsWith(TEXT("PrimaryAssetTypesToScan="))) continue;
+
+		FString ClassPath;
+		if (FParse::Value(*TrimmedLine, TEXT("AssetBaseClass="), ClassPath))
+		{
+			PrimaryAssetClasses.Add(GetClassNameFromPath(ClassPath));
+		}
+	}
+
+	return PrimaryAssetClasses.Num();
+}
+
+int64 FProjectCleanerRegistryAnalyzer::FindIndirectAssets()
+{
+	IndirectReferences.Reset();
+	if (Settings.ProjectDir.IsEmpty())
+	{
+		UE_LOG(LogProjectCleanerAnalyzer, Warning, TEXT("No -Project given, source and config files are not scanned for indirect references"));
+		return 0;
+	}
+
+	// same folders editor analysis scans: project Source and Config, Source and Config of every project plugin
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	TArray<FString> Files;
+	const auto FindFiles = [&] (const FString& SourceDir, const FString& ConfigDir)
+	{
+		PlatformFile.FindFilesRecursively(Files, *SourceDir, TEXT(".cs"));
+		PlatformFile.FindFilesRecursively(Files, *SourceDir, TEXT(".cpp"));
+		PlatformFile.FindFilesRecursively(Files, *SourceDir, TEXT(".h"));
+		PlatformFile.FindFilesRecursively(Files, *ConfigDir, TEXT(".ini"));
+	};
+
+	FindFiles(Settings.ProjectDir / TEXT("Source"), Settings.ProjectDir / TEXT("Config"));
+
+	TArray<FString> Plugins;
+	IFileManager::Get().FindFiles(Plugins, *(Settings.ProjectDir / TEXT("Plugins/*")), false, true);
+	for (const auto& Plugin : Plugins)
+	{
+		const FString PluginDir = Settings.ProjectDir / TEXT("Plugins") / Plugin;
+		FindFiles(PluginDir / TEXT("Source"), PluginDir / TEXT("Config"));
+	}
+
+	// assets can be referenced both by object path and package name
+	TMap<FName, const FAssetData*> ReferencedAssets;
+	ReferencedAssets.Reserve(Assets.Num() * 2);
+	for (const FAssetData* AssetData : Assets)
+	{
+		ReferencedAssets.Add(AssetData->ObjectPath, AssetData);
+		ReferencedAssets.Add(AssetData->PackageName, AssetData);
+	}
+
+	TSet<const FAssetData*> FoundAssets;
+	TArray<FCleanerIndirectReference> References;
+	FString FileContent;
+	for (const auto& File : Files)
+	{
+		FileContent.Reset();
+		if (!FFileHelper::LoadFileToString(FileContent, *File)) continue;
+
+		References.Reset();
+		FCleanerIndirectReferenceMatcher::FindReferences(FileContent, References);
+
+		for (const auto& Reference : References)
+		{
+			// reference to path registry never saw can not match any asset
+			const FName ObjectPath{*Reference.ObjectPath, FNAME_Find};
+			if (ObjectPath.IsNone()) continue;
+
+			const FAssetData* const* AssetData = ReferencedAssets.Find(ObjectPath);
+			if (!AssetData || FoundAssets.Contains(*AssetData)) continue;
+
+			FoundAssets.Add(*AssetData);
+			IndirectReferences.Add({*AssetData, FPaths::ConvertRelativePathToFull(File), Reference.Line});
+		}
+	}
+
+	return Files.Num();
+}
+
+int64 FProjectCleanerRegistryAnalyzer::FindUnusedAssets()
+{
+	TArray<int32> Roots;
+
+	// packages outside /Game are engine and plugin content, what they reference is used
+	for (int32 Node = 0; Node < GraphPackages.Num(); ++Node)
+	{
+		if (!GraphPackages[Node].ToString().StartsWith(ProjectCleanerRegistryAnalyzer::GameRoot))
+		{
+			Roots.Add(Node);
+		}
+	}
+
+	ExcludedPackages.Reset();
+	for (const FAssetData* AssetData : Assets)
+	{
+		const int32 Node = GraphPackageIndices.FindChecked(AssetData->PackageName);
+		if (IsPrimaryAsset(*AssetData))
+		{
+			Roots.Add(Node);
+			continue;
+		}
+
+		const bool bExcluded =
+			ExcludedAssets.Contains(AssetData->ObjectPath) ||
+			ExcludedClasses.Contains(GetClassName(*AssetData)) ||
+			(!ExcludedPathsTrie.IsEmpty() && ExcludedPathsTrie.ContainsPrefixOf(AssetData->PackagePath.ToString()));
+		if (bExcluded)
+		{
+			Roots.Add(Node);
+			ExcludedPackages.Add(AssetData->PackageName);
+		}
+		else if (!Settings.bScanDeveloperContents && AssetData->PackageName.ToString().StartsWith(ProjectCleanerRegistryAnalyzer::DevelopersRoot))
+		{
+			Roots.Add(Node);
+		}
+	}
+
+	for (const auto& IndirectReference : IndirectReferences)
+	{
+		Roots.Add(GraphPackageIndices.FindChecked(IndirectReference.AssetData->PackageName));
+	}
+
+	TBitArray<> Reachable;
+	DependencyGraph.FindReachable(Roots, Reachable);
+
+	// megascans presets are never unused while its plugin is enabled in project
+	const bool bMegascansEnabled = IsPluginEnabled(TEXT("MegascansPlugin"));
+
+	// package size counts once, no matter how many assets it holds
+	UnusedAssets.Reset();
+	TotalSize = 0;
+	UnusedSize = 0;
+	TSet<FName> CountedPackages;
+	TSet<FName> UnusedPackages;
+	for (const FAssetData* AssetData : Assets)
+	{
+		bool bPackageAlreadyCounted = false;
+		CountedPackages.Add(AssetData->PackageName, &bPackageAlreadyCounted);
+		if (!bPackageAlreadyCounted)
+		{
+			TotalSize += GetPackageSize(AssetData->PackageName);
+		}
+
+		if (Reachable[GraphPackageIndices.FindChecked(AssetData->PackageName)]) continue;
+		if (bMegascansEnabled && AssetData->PackagePath.ToString().StartsWith(ProjectCleanerRegistryAnalyzer::MegascansRoot)) continue;
+
+		UnusedAssets.Add(AssetData);
+
+		bool bPackageAlreadyUnused = false;
+		UnusedPackages.Add(AssetData->PackageName, &bPackageAlreadyUnused);
+		if (!bPackageAlreadyUnused)
+		{
+			UnusedSize += GetPackageSize(AssetData->PackageName);
+		}
+	}
+
+	return Assets.Num();
+}
+
+void FProjectCleanerRegistryAnalyzer::RunStage(const FName Name, TFunctionRef<int64()> Work)
+{
+	FCleanerRegistryAnalyzerStage& Stage = Stages.AddDefaulted_GetRef();
+	Stage.Name = Name;
+
+	const double StartTime = FPlatformTime::Seconds();
+	Stage.ItemsProcessed = Work();
+	Stage.WallTime = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogProjectCleanerAnalyzer, Display, TEXT("	%-24s %10.3f ms %12lld items"), *Name.ToString(), Stage.WallTime * 1000.0, Stage.ItemsProcessed);
+}
+
+bool FProjectCleanerRegistryAnalyzer::IsPrimaryAsset(const FAssetData& AssetData) const
+{
+	if (AssetData.AssetClass == ProjectCleanerRegistryAnalyzer::MapBuildDataClass) return true;
+
+	// instances of blueprint subclasses and blueprints themselves, matched by their generated class
+	return ClassHierarchy.IsChildOfAny(AssetData.AssetClass, PrimaryAssetClasses) || ClassHierarchy.IsChildOfAny(GetClassName(AssetData), PrimaryAssetClasses);
+}
+
+bool FProjectCleanerRegistryAnalyzer::IsPluginEnabled(const FString& PluginName) const
+{
+	if (Settings.ProjectDir.IsEmpty()) return false;
+
+	TArray<FString> ProjectFiles;
+	IFileManager::Get().FindFiles(ProjectFiles, *(Settings.ProjectDir / TEXT("*.uproject")), true, false);
+
+	FString ProjectFileContent;
+	if (ProjectFiles.Num() == 0 || !FFileHelper::LoadFileToString(ProjectFileContent, *(Settings.ProjectDir / ProjectFiles[0]))) return false;
+
+	TSharedPtr<FJsonObject> ProjectObject;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(ProjectFileContent), ProjectObject) || !ProjectObject.IsValid()) return false;
+
+	const TArray<TSharedPtr<FJsonValue>>* Plugins = nullptr;
+	if (!ProjectObject->TryGetArrayField(TEXT("Plugins"), Plugins)) return false;
+
+	for (const auto& Plugin : *Plugins)
+	{
+		const TSharedPtr<FJsonObject>* PluginObject = nullptr;
+		if (!Plugin->TryGetObject(PluginObject)) continue;
+
+		FString Name;
+		bool bEnabled = false;
+		if ((*PluginObject)->TryGetStringField(TEXT("Name"), Name) && Name.Equals(PluginName) && (*PluginObject)->TryGetBoolField(TEXT("Enabled"), bEnabled))
+		{
+			return bEnabled;
+		}
+	}
+
+	return false;
+}
+
+int64 FProjectCleanerRegistryAnalyzer::GetPackageSize(const FName PackageName) const
+{
+	// registry size is package file only, without .uexp and .ubulk next to it
+	if (const int64* DiskSize = PackageDiskSizes.Find(PackageName))
+	{
+		return *DiskSize;
+	}
+
+	const FAssetPackageData* PackageData = State.GetAssetPackageData(PackageName);
+	return PackageData ? FMath::Max<int64>(0, PackageData->DiskSize) : 0;
+}
+
+FName FProjectCleanerRegistryAnalyzer::GetClassName(const FAssetData& AssetData)
+{
+	FString GeneratedClassPath;
+	if (AssetData.AssetClass == TEXT("Blueprint") && AssetData.GetTagValue(TEXT("GeneratedClass"), GeneratedClassPath))
+	{
+		return GetClassNameFromPath(GeneratedClassPath);
+	}
+
+	return AssetData.AssetClass;
+}
+
+FName FProjectCleanerRegistryAnalyzer::GetClassNameFromPath(const FString& ClassPath)
+{
+	// "/Script/Engine.World", "Class'/Script/Engine.Actor'" or "/Game/BP_Base.BP_Base_C"
+	FString ClassName = ClassPath;
+	ClassName.RemoveFromEnd(TEXT("'"));
+
+	int32 DotIndex;
+	if (ClassName.FindLastChar(TEXT('.'), DotIndex))
+	{
+		ClassName.RightChopInline(DotIndex + 1);
+	}
+
+	return FName{*ClassName};
+}
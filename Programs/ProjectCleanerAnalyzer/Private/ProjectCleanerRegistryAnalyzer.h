@@ -0,0 +1,112 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "ProjectCleanerAnalysisCore.h"
+// Engine Headers
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetRegistryState.h"
+
+class FProjectCleanerReportWriter;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogProjectCleanerAnalyzer, Log, All);
+
+struct FCleanerRegistryAnalyzerSettings
+{
+	/** Serialized editor registry, written by ProjectCleanerCLI commandlet with -SaveRegistryFile= */
+	FString RegistryFile;
+	/** Project folder, its Content is scanned for files and Source, Config and Plugins for indirect references, empty skips both */
+	FString ProjectDir;
+	/** Assets under these paths, these assets and assets of these classes are kept together with everything they depend on */
+	TArray<FString> ExcludedPaths;
+	TArray<FString> ExcludedAssets;
+	TArray<FString> ExcludedClasses;
+	/** Assets in /Game/Developers are analysed too, otherwise they are kept */
+	bool bScanDeveloperContents = false;
+};
+
+struct FCleanerRegistryAnalyzerStage
+{
+	FName Name;
+	double WallTime = 0.0;
+	int64 ItemsProcessed = 0;
+};
+
+/**
+ * Editor free read only project analysis
+ * Works on deserialized asset registry state and project files only, so it never loads packages or editor modules
+ *
+ * Used assets are reachable from primary assets, map build data, excluded paths, assets and classes, Developers folder,
+ * assets referenced from source and config files, and packages outside /Game, same roots editor analysis uses
+ * Content folder gives package sizes with companion files, non engine files, orphaned files and empty folders
+ *
+ * Differences from editor analysis, see GetDifferences
+ */
+class FProjectCleanerRegistryAnalyzer
+{
+public:
+	explicit FProjectCleanerRegistryAnalyzer(const FCleanerRegistryAnalyzerSettings& InSettings);
+
+	bool Run();
+	void WriteReport(FProjectCleanerReportWriter& Writer) const;
+
+	int32 GetAssetsNum() const;
+	int32 GetUnusedAssetsNum() const;
+	int64 GetTotalSize() const;
+	int64 GetUnusedSize() const;
+	const TArray<FCleanerRegistryAnalyzerStage>& GetStages() const;
+	/** What editor analysis finds and this one can not, printed and written to report */
+	static const TArray<FString>& GetDifferences();
+private:
+	bool LoadRegistry();
+	int64 BuildGraph();
+	int64 FindContentFiles();
+	int64 FindPrimaryAssetClasses();
+	int64 FindIndirectAssets();
+	int64 FindUnusedAssets();
+
+	void RunStage(const FName Name, TFunctionRef<int64()> Work);
+	bool IsPrimaryAsset(const FAssetData& AssetData) const;
+	bool IsPluginEnabled(const FString& PluginName) const;
+	int64 GetPackageSize(const FName PackageName) const;
+	/** Generated class for blueprints, asset class for rest, same name editor analysis reports and excludes by */
+	static FName GetClassName(const FAssetData& AssetData);
+	static FName GetClassNameFromPath(const FString& ClassPath);
+
+	FCleanerRegistryAnalyzerSettings Settings;
+	FAssetRegistryState State;
+
+	/** Game assets, redirectors excluded */
+	TArray<const FAssetData*> Assets;
+	TArray<FName> GraphPackages;
+	TMap<FName, int32> GraphPackageIndices;
+	FCleanerDependencyGraph DependencyGraph;
+	FCleanerPathTrie ExcludedPathsTrie;
+	TSet<FName> ExcludedAssets;
+	TSet<FName> ExcludedClasses;
+	TSet<FName> PrimaryAssetClasses;
+	/** Blueprint classes from registry tags, native hierarchy is not part of registry */
+	FCleanerClassHierarchy ClassHierarchy;
+
+	/** Package file with its .uexp, .ubulk and .uptnl files as found in Content folder */
+	TMap<FName, int64> PackageDiskSizes;
+	TMap<FString, int64> NonEngineFiles;
+	TMap<FString, int64> OrphanedFiles;
+	TArray<FString> EmptyFolders;
+	int32 UnregisteredFilesNum = 0;
+
+	struct FIndirectReference
+	{
+		const FAssetData* AssetData;
+		FString File;
+		int32 Line;
+	};
+	TArray<FIndirectReference> IndirectReferences;
+
+	TArray<const FAssetData*> UnusedAssets;
+	/** Kept only because they are excluded */
+	TSet<FName> ExcludedPackages;
+	int64 TotalSize = 0;
+	int64 UnusedSize = 0;
+	TArray<FCleanerRegistryAnalyzerStage> Stages;
+};
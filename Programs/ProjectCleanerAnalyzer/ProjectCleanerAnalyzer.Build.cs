@@ -0,0 +1,26 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class ProjectCleanerAnalyzer : ModuleRules
+{
+	public ProjectCleanerAnalyzer(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PublicIncludePaths.Add("Runtime/Launch/Public");
+
+		// for RequiredProgramMainCPPInclude.h
+		PrivateIncludePaths.Add("Runtime/Launch/Private");
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"AssetRegistry",
+				"Json",
+				"Projects",
+				"ProjectCleanerCore",
+			}
+		);
+	}
+}
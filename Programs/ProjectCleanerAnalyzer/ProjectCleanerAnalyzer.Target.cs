@@ -0,0 +1,23 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+using UnrealBuildTool;
+
+[SupportedPlatforms(UnrealPlatformClass.Desktop)]
+public class ProjectCleanerAnalyzerTarget : TargetRules
+{
+	public ProjectCleanerAnalyzerTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Program;
+		LinkType = TargetLinkType.Monolithic;
+		LaunchModuleName = "ProjectCleanerAnalyzer";
+
+		// console program, asset registry state needs CoreUObject, but no engine or editor modules
+		bBuildDeveloperTools = false;
+		bCompileAgainstEngine = false;
+		bCompileAgainstCoreUObject = true;
+		bIsBuildingConsoleApplication = true;
+
+		// programs see engine plugins only, ProjectCleaner must be installed under Engine/Plugins
+		EnablePlugins.Add("ProjectCleaner");
+	}
+}
@@ -0,0 +1,124 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "ProjectCleanerCoreBenchmark.h"
+// Engine Headers
+#include "RequiredProgramMainCPPInclude.h"
+#include "Misc/AutomationTest.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogProjectCleanerCoreTests, Display, All);
+
+IMPLEMENT_APPLICATION(ProjectCleanerCoreTests, "ProjectCleanerCoreTests");
+
+namespace ProjectCleanerCoreTests
+{
+	/** Runs every automation test whose path starts with Filter, returns number of failed tests */
+	int32 RunTests(const FString& Filter)
+	{
+		FAutomationTestFramework& Framework = FAutomationTestFramework::Get();
+		Framework.SetRequestedTestFilter(EAutomationTestFlags::FilterMask);
+
+		TArray<FAutomationTestInfo> TestInfos;
+		Framework.GetValidTestNames(TestInfos);
+
+		int32 TestsNum = 0;
+		int32 FailedNum = 0;
+		for (const auto& TestInfo : TestInfos)
+		{
+			if (!TestInfo.GetFullTestPath().StartsWith(Filter)) continue;
+
+			++TestsNum;
+			Framework.StartTestByName(TestInfo.GetTestName(), 0);
+
+			// specs run their expectations as latent commands
+			while (!Framework.ExecuteLatentCommands())
+			{
+			}
+
+			FAutomationTestExecutionInfo ExecutionInfo;
+			if (Framework.StopTest(ExecutionInfo))
+			{
+				UE_LOG(LogProjectCleanerCoreTests, Display, TEXT("Passed - %s"), *TestInfo.GetFullTestPath());
+				continue;
+			}
+
+			++FailedNum;
+			UE_LOG(LogProjectCleanerCoreTests, Error, TEXT("Failed - %s"), *TestInfo.GetFullTestPath());
+			for (const auto& Entry : ExecutionInfo.GetEntries())
+			{
+				if (Entry.Event.Type == EAutomationEventType::Error)
+				{
+					UE_LOG(LogProjectCleanerCoreTests, Error, TEXT("	%s"), *Entry.ToString());
+				}
+			}
+		}
+
+		UE_LOG(LogProjectCleanerCoreTests, Display, TEXT("%d tests, %d failed"), TestsNum, FailedNum);
+		return TestsNum == 0 ? 1 : FailedNum;
+	}
+
+	void RunMicroBenchmark(const FCleanerCoreBenchmarkSettings& Settings, const int32 Iterations)
+	{
+		FCleanerCoreBenchmark Benchmark{Settings};
+
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			TArray<TPair<FName, TFunction<int64()>>> Stages;
+			Benchmark.AddStages([&] (const FName Name, TFunction<int64()> Work)
+			{
+				Stages.Emplace(Name, MoveTemp(Work));
+			});
+
+			double TotalTime = 0.0;
+			for (const auto& Stage : Stages)
+			{
+				const double StartTime = FPlatformTime::Seconds();
+				const int64 ItemsNum = Stage.Value();
+				const double StageTime = FPlatformTime::Seconds() - StartTime;
+				TotalTime += StageTime;
+
+				UE_LOG(LogProjectCleanerCoreTests, Display, TEXT("	%-24s %10.3f ms %12lld items"), *Stage.Key.ToString(), StageTime * 1000.0, ItemsNum);
+			}
+
+			UE_LOG(LogProjectCleanerCoreTests, Display, TEXT("Iteration %d/%d - %.3f s, %s"), Iteration + 1, Iterations, TotalTime, *Benchmark.GetSummary());
+		}
+	}
+}
+
+INT32_MAIN_INT32_ARGC_TCHAR_ARGV()
+{
+	GEngineLoop.PreInit(ArgC, ArgV);
+
+	// CLI - arguments
+	// -Filter=ProjectCleaner.Core - automation tests to run
+	// -Micro -Nodes=100000 -Topology=Mixed|Chain|FanOut|Cycle -ClusterSize=64 -FanOut=8 -Iterations=5 - time core algorithms on generated graph instead
+	int32 Result = 0;
+	if (FParse::Param(FCommandLine::Get(), TEXT("Micro")))
+	{
+		FCleanerCoreBenchmarkSettings Settings;
+		int32 Iterations = 5;
+		FString Topology;
+
+		FParse::Value(FCommandLine::Get(), TEXT("Nodes="), Settings.NodesNum);
+		FParse::Value(FCommandLine::Get(), TEXT("ClusterSize="), Settings.ClusterSize);
+		FParse::Value(FCommandLine::Get(), TEXT("FanOut="), Settings.FanOut);
+		FParse::Value(FCommandLine::Get(), TEXT("Seed="), Settings.Seed);
+		FParse::Value(FCommandLine::Get(), TEXT("Iterations="), Iterations);
+		if (FParse::Value(FCommandLine::Get(), TEXT("Topology="), Topology) && !FCleanerCoreBenchmarkSettings::ParseTopology(Topology, Settings.Topology))
+		{
+			UE_LOG(LogProjectCleanerCoreTests, Warning, TEXT("%s - Invalid topology, using Mixed"), *Topology);
+		}
+
+		ProjectCleanerCoreTests::RunMicroBenchmark(Settings, FMath::Max(1, Iterations));
+	}
+	else
+	{
+		FString Filter = TEXT("ProjectCleaner.Core");
+		FParse::Value(FCommandLine::Get(), TEXT("Filter="), Filter);
+
+		Result = ProjectCleanerCoreTests::RunTests(Filter);
+	}
+
+	FEngineLoop::AppPreExit();
+	FEngineLoop::AppExit();
+	return Result;
+}
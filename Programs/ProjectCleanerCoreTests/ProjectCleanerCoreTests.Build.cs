@@ -0,0 +1,23 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class ProjectCleanerCoreTests : ModuleRules
+{
+	public ProjectCleanerCoreTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PublicIncludePaths.Add("Runtime/Launch/Public");
+
+		// for RequiredProgramMainCPPInclude.h
+		PrivateIncludePaths.Add("Runtime/Launch/Private");
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"Projects",
+				"ProjectCleanerCore",
+			}
+		);
+	}
+}
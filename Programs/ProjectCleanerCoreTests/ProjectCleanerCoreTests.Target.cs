@@ -0,0 +1,27 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+using UnrealBuildTool;
+
+[SupportedPlatforms(UnrealPlatformClass.Desktop)]
+public class ProjectCleanerCoreTestsTarget : TargetRules
+{
+	public ProjectCleanerCoreTestsTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Program;
+		LinkType = TargetLinkType.Monolithic;
+		LaunchModuleName = "ProjectCleanerCoreTests";
+
+		// console program linking Core and ProjectCleanerCore only
+		bBuildDeveloperTools = false;
+		bCompileAgainstEngine = false;
+		bCompileAgainstCoreUObject = false;
+		bCompileAgainstApplicationCore = false;
+		bIsBuildingConsoleApplication = true;
+
+		// specs of ProjectCleanerCore are development automation tests
+		bForceCompileDevelopmentAutomationTests = true;
+
+		// programs see engine plugins only, ProjectCleaner must be installed under Engine/Plugins
+		EnablePlugins.Add("ProjectCleaner");
+	}
+}
@@ -0,0 +1,84 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "ProjectCleanerLibrary.h"
+// Engine Headers
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Containers/Ticker.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "ProjectCleanerAnalyzeAsyncAction.generated.h"
+
+class FProjectCleanerDataManager;
+
+USTRUCT(BlueprintType)
+struct FProjectCleanerAnalysisResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "ProjectCleanerAPI")
+	TArray<FAssetData> UnusedAssets;
+
+	UPROPERTY(BlueprintReadOnly, Category = "ProjectCleanerAPI")
+	TArray<FString> EmptyFolders;
+
+	UPROPERTY(BlueprintReadOnly, Category = "ProjectCleanerAPI")
+	TArray<FString> NonEngineFiles;
+
+	UPROPERTY(BlueprintReadOnly, Category = "ProjectCleanerAPI")
+	TArray<FString> CorruptedFiles;
+
+	UPROPERTY(BlueprintReadOnly, Category = "ProjectCleanerAPI")
+	TArray<FString> IndirectlyUsedAssets;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FProjectCleanerAnalysisDelegate, float, Progress, const FProjectCleanerAnalysisResult&, Result);
+
+/**
+ * Analyzes project one stage per editor tick, so editor stays responsive
+ * Blueprint gets latent node, Python creates action with AnalyzeProjectAsync, binds delegates and calls Activate
+ */
+UCLASS()
+class PROJECTCLEANER_API UProjectCleanerAnalyzeAsyncAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category = "ProjectCleanerAPI|Async", meta = (BlueprintInternalUseOnly = "true", ToolTip = "Analyze project without blocking editor. Result is shared with synchronous API calls using same configs"))
+	static UProjectCleanerAnalyzeAsyncAction* AnalyzeProjectAsync(const FProjectCleanerConfigs& CleanerConfigs);
+
+	virtual void Activate() override;
+
+	UFUNCTION(BlueprintCallable, Category = "ProjectCleanerAPI|Async")
+	void Cancel();
+
+	UFUNCTION(BlueprintPure, Category = "ProjectCleanerAPI|Async")
+	float GetProgress() const;
+
+	UFUNCTION(BlueprintPure, Category = "ProjectCleanerAPI|Async")
+	bool IsRunning() const;
+
+	/** Called after every finished stage, Result is empty */
+	UPROPERTY(BlueprintAssignable)
+	FProjectCleanerAnalysisDelegate OnProgress;
+
+	UPROPERTY(BlueprintAssignable)
+	FProjectCleanerAnalysisDelegate OnCompleted;
+
+	UPROPERTY(BlueprintAssignable)
+	FProjectCleanerAnalysisDelegate OnCancelled;
+
+private:
+	bool Tick(float DeltaTime);
+	/** Broadcasts result of given analysis, or cancellation when there is none */
+	void Finish(const FProjectCleanerDataManager* FinishedAnalysis);
+
+	UPROPERTY()
+	FProjectCleanerConfigs CleanerConfigs;
+
+	TSharedPtr<FProjectCleanerDataManager> Analysis;
+	FDelegateHandle TickerHandle;
+	float Progress = 0.0f;
+	bool bCancelRequested = false;
+};
@@ -32,6 +32,17 @@ enum class EProjectCleanerPathReturnType : uint8
 	EPT_Game     UMETA(DisplayName = "Game"),     // /Game/NewMaterial.NewMaterial
 };
 
+UENUM(BlueprintType)
+enum class EProjectCleanerResultCategory : uint8
+{
+	ERC_UnusedAssets         UMETA(DisplayName = "Unused Assets"),
+	ERC_EmptyFolders         UMETA(DisplayName = "Empty Folders"),
+	ERC_NonEngineFiles       UMETA(DisplayName = "Non Engine Files"),
+	ERC_CorruptedFiles       UMETA(DisplayName = "Corrupted Files"),
+	ERC_IndirectlyUsedAssets UMETA(DisplayName = "Indirectly Used Assets"),
+	ERC_OrphanedFiles        UMETA(DisplayName = "Orphaned Files"),
+};
+
 /**
  * 
  */
@@ -64,9 +75,33 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = "ProjectCleanerAPI|Util", meta = (ToolTip = "Save result of API calls in directory Saved/ProjectCleaner"))
 	static bool ExportToFile(const TArray<FString>& List, const FString& FileName);
+
+	UFUNCTION(BlueprintCallable, Category = "ProjectCleanerAPI|Paging", meta = (ToolTip = "Return number of rows in given result category"))
+	static int32 GetResultNum(const FProjectCleanerConfigs& CleanerConfigs, EProjectCleanerResultCategory ResultCategory);
+
+	UFUNCTION(BlueprintCallable, Category = "ProjectCleanerAPI|Paging", meta = (ToolTip = "Return up to PageSize paths of given result category, starting at Cursor (0 for first page). NextCursor is -1 after last page. PathType applies to asset categories only. Pass AnalysisToken 0 with first page and OutAnalysisToken of previous page with next ones. Returns false when project was analyzed again since first page, paging must then restart from Cursor 0"))
+	static bool GetResultPage(const FProjectCleanerConfigs& CleanerConfigs, EProjectCleanerResultCategory ResultCategory, EProjectCleanerPathReturnType PathType, int32 Cursor, int32 PageSize, int32 AnalysisToken, TArray<FString>& OutRows, int32& NextCursor, int32& OutAnalysisToken);
+
+	UFUNCTION(BlueprintCallable, Category = "ProjectCleanerAPI|Paging", meta = (ToolTip = "Stream all paths of given result category to file in Saved/ProjectCleaner, page by page"))
+	static bool ExportResultToFile(const FProjectCleanerConfigs& CleanerConfigs, EProjectCleanerResultCategory ResultCategory, EProjectCleanerPathReturnType PathType, const FString& FileName);
+
+	UFUNCTION(BlueprintCallable, Category = "ProjectCleanerAPI|Util", meta = (ToolTip = "Forces next API call to analyze project again, instead of using cached result"))
+	static void InvalidateAnalysis();
+
+	// Converts configs to key of analysis session cache
+	static void GetSessionConfigs(const FProjectCleanerConfigs& CleanerConfigs, struct FCleanerSessionConfigs& OutSessionConfigs);
+
+	// Every row of given category from already finished analysis, never analyzes project
+	static void GetResultFromAnalysis(const class FProjectCleanerDataManager& DataManager, EProjectCleanerResultCategory ResultCategory, EProjectCleanerPathReturnType PathType, TArray<FString>& OutRows);
 	
 private:
 
-	// Fills ProjectCleanerDataManager settings based on CleanerConfigs
-	static void FillCleanerConfigs(class FProjectCleanerDataManager& DataManager, const FProjectCleanerConfigs& CleanerConfigs);
+	// Returns cached analysis for given CleanerConfigs, analyzing project only when needed
+	static const class FProjectCleanerDataManager& GetAnalysis(const FProjectCleanerConfigs& CleanerConfigs);
+
+	// Formats rows of single page, returns cursor of next page or INDEX_NONE
+	static int32 GetResultPageInternal(const FProjectCleanerDataManager& DataManager, EProjectCleanerResultCategory ResultCategory, EProjectCleanerPathReturnType PathType, int32 Cursor, int32 PageSize, TArray<FString>& OutRows);
+
+	// Creates Saved/ProjectCleaner directory and removes old file with same name
+	static bool PrepareExportFile(const FString& FileName, FString& OutSavePath);
 };
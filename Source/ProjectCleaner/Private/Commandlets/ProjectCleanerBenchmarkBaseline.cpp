@@ -0,0 +1,103 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "ProjectCleanerBenchmarkBaseline.h"
+// Engine Headers
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Dom/JsonObject.h"
+
+bool FProjectCleanerBenchmarkBaseline::Load(const FString& FilePath)
+{
+	Results.Reset();
+
+	FString Json;
+	if (!FFileHelper::LoadFileToString(Json, *FilePath) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Results))
+	{
+		Results.Reset();
+		return false;
+	}
+
+	return Results.IsValid();
+}
+
+bool FProjectCleanerBenchmarkBaseline::IsMeasuredOn(const FCleanerBenchmarkFixtureSettings& FixtureSettings) const
+{
+	const TSharedPtr<FJsonObject>* Fixture = nullptr;
+	if (!Results.IsValid() || !Results->TryGetObjectField(TEXT("fixture"), Fixture))
+	{
+		return false;
+	}
+
+	const auto IntegerEquals = [&] (const TCHAR* Field, const int32 Value)
+	{
+		int32 BaselineValue = 0;
+		return (*Fixture)->TryGetNumberField(Field, BaselineValue) && BaselineValue == Value;
+	};
+
+	double IndirectRatio = 0.0;
+	return
+		(*Fixture)->GetStringField(TEXT("root")) == FixtureSettings.RootPath &&
+		(*Fixture)->GetStringField(TEXT("topology")) == FCleanerCoreBenchmarkSettings::TopologyToString(FixtureSettings.Topology) &&
+		IntegerEquals(TEXT("assets"), FixtureSettings.AssetsNum) &&
+		IntegerEquals(TEXT("cluster_size"), FixtureSettings.ClusterSize) &&
+		IntegerEquals(TEXT("fan_out"), FixtureSettings.FanOut) &&
+		IntegerEquals(TEXT("assets_per_folder"), FixtureSettings.AssetsPerFolder) &&
+		IntegerEquals(TEXT("blueprint_hierarchies"), FixtureSettings.BlueprintHierarchies) &&
+		IntegerEquals(TEXT("blueprint_depth"), FixtureSettings.BlueprintDepth) &&
+		IntegerEquals(TEXT("non_engine_files"), FixtureSettings.NonEngineFilesNum) &&
+		IntegerEquals(TEXT("empty_folders"), FixtureSettings.EmptyFoldersNum) &&
+		IntegerEquals(TEXT("seed"), FixtureSettings.Seed) &&
+		(*Fixture)->TryGetNumberField(TEXT("indirect_ratio"), IndirectRatio) &&
+		FMath::IsNearlyEqual(IndirectRatio, static_cast<double>(FixtureSettings.IndirectRatio), 1e-4);
+}
+
+TArray<FName> FProjectCleanerBenchmarkBaseline::GetStageNames() const
+{
+	TArray<FName> StageNames;
+	const TArray<TSharedPtr<FJsonValue>>* Stages = nullptr;
+	if (!Results.IsValid() || !Results->TryGetArrayField(TEXT("stages"), Stages))
+	{
+		return StageNames;
+	}
+
+	for (const auto& StageValue : *Stages)
+	{
+		const TSharedPtr<FJsonObject>* Stage = nullptr;
+		FString StageName;
+		if (StageValue->TryGetObject(Stage) && (*Stage)->TryGetStringField(TEXT("name"), StageName))
+		{
+			StageNames.Add(FName{*StageName});
+		}
+	}
+
+	return StageNames;
+}
+
+bool FProjectCleanerBenchmarkBaseline::GetStageBudget(const FName StageName, double& OutWallTime, double& OutPeakMemoryGrowth) const
+{
+	const TArray<TSharedPtr<FJsonValue>>* Stages = nullptr;
+	if (!Results.IsValid() || !Results->TryGetArrayField(TEXT("stages"), Stages))
+	{
+		return false;
+	}
+
+	for (const auto& StageValue : *Stages)
+	{
+		const TSharedPtr<FJsonObject>* Stage = nullptr;
+		if (!StageValue->TryGetObject(Stage) || (*Stage)->GetStringField(TEXT("name")) != StageName.ToString()) continue;
+
+		const TSharedPtr<FJsonObject>* WallTime = nullptr;
+		const TSharedPtr<FJsonObject>* PeakMemoryGrowth = nullptr;
+		if (!(*Stage)->TryGetObjectField(TEXT("wall_time_sec"), WallTime) || !(*Stage)->TryGetObjectField(TEXT("peak_memory_growth_bytes"), PeakMemoryGrowth))
+		{
+			return false;
+		}
+
+		OutWallTime = (*WallTime)->GetNumberField(TEXT("p50")) * (1.0 + Tolerance) + TimeSlack;
+		OutPeakMemoryGrowth = FMath::Max(0.0, (*PeakMemoryGrowth)->GetNumberField(TEXT("max"))) * (1.0 + Tolerance) + MemorySlack;
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,31 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "ProjectCleanerBenchmarkFixture.h"
+// Engine Headers
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+/**
+ * Results json of earlier benchmark run, used as source of stage budgets
+ * Budget is baseline value grown by Tolerance plus absolute slack, so very short stages are not failed by timer noise
+ */
+class FProjectCleanerBenchmarkBaseline
+{
+public:
+	bool Load(const FString& FilePath);
+	/** Budgets only make sense when measured on same fixture */
+	bool IsMeasuredOn(const FCleanerBenchmarkFixtureSettings& FixtureSettings) const;
+	TArray<FName> GetStageNames() const;
+	/** Time budget is for median iteration, memory budget for worst one, false if baseline has no such stage */
+	bool GetStageBudget(const FName StageName, double& OutWallTime, double& OutPeakMemoryGrowth) const;
+
+	/** Allowed relative growth over baseline */
+	float Tolerance = 0.2f;
+	float TimeSlack = 0.05f;
+	int64 MemorySlack = 16 * 1024 * 1024;
+private:
+	TSharedPtr<FJsonObject> Results;
+};
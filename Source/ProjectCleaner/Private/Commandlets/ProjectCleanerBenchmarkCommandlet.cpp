@@ -0,0 +1,532 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "ProjectCleanerBenchmarkCommandlet.h"
+#include "ProjectCleanerBenchmarkBaseline.h"
+#include "Core/ProjectCleanerDataManager.h"
+#include "Core/ProjectCleanerAnalysisPipeline.h"
+#include "ProjectCleanerCoreBenchmark.h"
+// Engine Headers
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogProjectCleanerBenchmark, Display, All);
+
+namespace ProjectCleanerBenchmark
+{
+	using FJsonWriter = TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>;
+
+	/** Nearest-rank percentile, Values must be sorted */
+	double GetPercentile(const TArray<double>& Values, const double Percentile)
+	{
+		if (Values.Num() == 0) return 0.0;
+
+		const int32 Rank = FMath::CeilToInt(Percentile / 100.0 * Values.Num());
+		return Values[FMath::Clamp(Rank - 1, 0, Values.Num() - 1)];
+	}
+
+	void WriteDistribution(FJsonWriter& Writer, const FString& Identifier, TArray<double> Values)
+	{
+		Values.Sort();
+
+		double Sum = 0.0;
+		for (const double Value : Values)
+		{
+			Sum += Value;
+		}
+
+		Writer.WriteObjectStart(Identifier);
+		Writer.WriteValue(TEXT("min"), Values.Num() > 0 ? Values[0] : 0.0);
+		Writer.WriteValue(TEXT("p50"), GetPercentile(Values, 50.0));
+		Writer.WriteValue(TEXT("p90"), GetPercentile(Values, 90.0));
+		Writer.WriteValue(TEXT("p95"), GetPercentile(Values, 95.0));
+		Writer.WriteValue(TEXT("p99"), GetPercentile(Values, 99.0));
+		Writer.WriteValue(TEXT("max"), Values.Num() > 0 ? Values.Last() : 0.0);
+		Writer.WriteValue(TEXT("mean"), Values.Num() > 0 ? Sum / Values.Num() : 0.0);
+		Writer.WriteObjectEnd();
+	}
+
+	/** Stage names in order of first appearance */
+	TArray<FName> GetStageNames(const TArray<FCleanerAnalysisReport>& Reports)
+	{
+		TArray<FName> StageNames;
+		for (const auto& Report : Reports)
+		{
+			for (const auto& Stage : Report.Stages)
+			{
+				StageNames.AddUnique(Stage.Name);
+			}
+		}
+
+		return StageNames;
+	}
+
+	/** Sorted samples of given stage value across all iterations */
+	TArray<double> GetStageSamples(const TArray<FCleanerAnalysisReport>& Reports, const FName StageName, TFunctionRef<double(const FCleanerStageStats&)> Getter)
+	{
+		TArray<double> Samples;
+		for (const auto& Report : Reports)
+		{
+			for (const auto& Stage : Report.Stages)
+			{
+				if (Stage.Name == StageName)
+				{
+					Samples.Add(Getter(Stage));
+				}
+			}
+		}
+
+		Samples.Sort();
+		return Samples;
+	}
+}
+
+UProjectCleanerBenchmarkCommandlet::UProjectCleanerBenchmarkCommandlet()
+{
+	IsServer = false;
+	IsClient = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UProjectCleanerBenchmarkCommandlet::Main(const FString& Params)
+{
+	UE_LOG(LogProjectCleanerBenchmark, Display, TEXT("===================================="));
+	UE_LOG(LogProjectCleanerBenchmark, Display, TEXT("===  ProjectCleaner Benchmark    ==="));
+	UE_LOG(LogProjectCleanerBenchmark, Display, TEXT("===================================="));
+
+	ParseCommandLinesArguments(Params);
+
+	// microbenchmarks run on in-memory graphs only, nothing is written to project
+	if (bMicro)
+	{
+		RunMicroBenchmark();
+		if (!SaveResults())
+		{
+			return 1;
+		}
+
+		return BaselineFile.IsEmpty() || CheckBudgets() ? 0 : 2;
+	}
+
+	FProjectCleanerBenchmarkFixture Fixture{FixtureSettings};
+
+	if (bGenerate && !Fixture.Generate())
+	{
+		UE_LOG(LogProjectCleanerBenchmark, Error, TEXT("Failed to generate synthetic project"));
+		return 1;
+	}
+
+	if (bBenchmark)
+	{
+		if (!RunBenchmark(Fixture) || !SaveResults())
+		{
+			return 1;
+		}
+	}
+
+	const bool bWithinBudgets = !bBenchmark || BaselineFile.IsEmpty() || CheckBudgets();
+
+	if (bClean)
+	{
+		Fixture.Clean();
+	}
+
+	return bWithinBudgets ? 0 : 2;
+}
+
+void UProjectCleanerBenchmarkCommandlet::ParseCommandLinesArguments(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> Parameters;
+	ParseCommandLine(*Params, Tokens, Switches, Parameters);
+
+	// CLI - arguments
+	// -Generate - create synthetic project under -Root
+	// -Benchmark - run analysis -Iterations times and write -Output json
+	// -Delete - also measure deletion path, fixture is regenerated before every iteration
+	// -Clean - remove synthetic project at the end
+	// -Micro - benchmark analysis core algorithms on in-memory graph of same shape, no assets generated
+	// -Root=/Game/ProjectCleanerBench -Assets=10000 -Topology=Mixed|Chain|FanOut|Cycle -ClusterSize=64 -FanOut=8
+	// -AssetsPerFolder=500 -Blueprints=4 -BlueprintDepth=8 -IndirectRatio=0.1 -NonEngineFiles=100 -EmptyFolders=100 -Seed=0
+	// -Baseline=<previous -Output json> -Tolerance=0.2 -TimeSlack=0.05 -MemorySlackMB=16 - exit code 2 if any stage exceeds its budget
+	for (const auto& Switch : Switches)
+	{
+		if (Switch.Equals(TEXT("Generate"), ESearchCase::IgnoreCase))
+		{
+			bGenerate = true;
+		}
+
+		if (Switch.Equals(TEXT("Benchmark"), ESearchCase::IgnoreCase))
+		{
+			bBenchmark = true;
+		}
+
+		if (Switch.Equals(TEXT("Delete"), ESearchCase::IgnoreCase))
+		{
+			bDelete = true;
+		}
+
+		if (Switch.Equals(TEXT("Clean"), ESearchCase::IgnoreCase))
+		{
+			bClean = true;
+		}
+
+		if (Switch.Equals(TEXT("Micro"), ESearchCase::IgnoreCase))
+		{
+			bMicro = true;
+		}
+	}
+
+	// if no action given then we generate and benchmark
+	if (!bGenerate && !bBenchmark && !bClean)
+	{
+		bGenerate = true;
+		bBenchmark = true;
+	}
+
+	const auto ParseInt = [&] (const TCHAR* Key, int32& OutValue)
+	{
+		if (const FString* Value = Parameters.Find(Key))
+		{
+			OutValue = FMath::Max(0, FCString::Atoi(**Value));
+		}
+	};
+
+	ParseInt(TEXT("Iterations"), Iterations);
+	ParseInt(TEXT("Assets"), FixtureSettings.AssetsNum);
+	ParseInt(TEXT("ClusterSize"), FixtureSettings.ClusterSize);
+	ParseInt(TEXT("FanOut"), FixtureSettings.FanOut);
+	ParseInt(TEXT("AssetsPerFolder"), FixtureSettings.AssetsPerFolder);
+	ParseInt(TEXT("Blueprints"), FixtureSettings.BlueprintHierarchies);
+	ParseInt(TEXT("BlueprintDepth"), FixtureSettings.BlueprintDepth);
+	ParseInt(TEXT("NonEngineFiles"), FixtureSettings.NonEngineFilesNum);
+	ParseInt(TEXT("EmptyFolders"), FixtureSettings.EmptyFoldersNum);
+	ParseInt(TEXT("Seed"), FixtureSettings.Seed);
+
+	if (const FString* Value = Parameters.Find(TEXT("IndirectRatio")))
+	{
+		FixtureSettings.IndirectRatio = FMath::Clamp(FCString::Atof(**Value), 0.0f, 1.0f);
+	}
+
+	if (const FString* Value = Parameters.Find(TEXT("Baseline")))
+	{
+		BaselineFile = *Value;
+	}
+
+	if (const FString* Value = Parameters.Find(TEXT("Tolerance")))
+	{
+		Tolerance = FMath::Max(0.0f, FCString::Atof(**Value));
+	}
+
+	if (const FString* Value = Parameters.Find(TEXT("TimeSlack")))
+	{
+		TimeSlack = FMath::Max(0.0f, FCString::Atof(**Value));
+	}
+
+	if (const FString* Value = Parameters.Find(TEXT("MemorySlackMB")))
+	{
+		MemorySlack = FMath::Max<int64>(0, FCString::Atoi64(**Value)) * 1024 * 1024;
+	}
+
+	if (const FString* Value = Parameters.Find(TEXT("Topology")))
+	{
+		if (!FCleanerCoreBenchmarkSettings::ParseTopology(*Value, FixtureSettings.Topology))
+		{
+			UE_LOG(LogProjectCleanerBenchmark, Warning, TEXT("%s - Invalid topology, using Mixed"), **Value);
+		}
+	}
+
+	if (const FString* Value = Parameters.Find(TEXT("Root")))
+	{
+		if (Value->StartsWith(TEXT("/Game/")))
+		{
+			FixtureSettings.RootPath = *Value;
+		}
+		else
+		{
+			UE_LOG(LogProjectCleanerBenchmark, Warning, TEXT("%s - Root must be under /Game/, using %s"), **Value, *FixtureSettings.RootPath);
+		}
+	}
+
+	const FString* Output = Parameters.Find(TEXT("Output"));
+	OutputFile = Output ? *Output : FPaths::ProjectSavedDir() / TEXT("ProjectCleaner") / TEXT("Benchmark.json");
+
+	Iterations = FMath::Max(1, Iterations);
+	if (bDelete && !bGenerate && Iterations > 1)
+	{
+		UE_LOG(LogProjectCleanerBenchmark, Warning, TEXT("Deletion destroys fixture, without -Generate only single iteration possible"));
+		Iterations = 1;
+	}
+
+	ShowArgumentsInLog();
+}
+
+void UProjectCleanerBenchmarkCommandlet::ShowArgumentsInLog() const
+{
+	UE_LOG(LogProjectCleanerBenchmark, Display, TEXT(""));
+	UE_LOG(LogProjectCleanerBenchmark, Display, TEXT("Benchmark arguments"));
+	UE_LOG(LogProjectCleanerBenchmark, Display, TEXT("	Generate - %s"), bGenerate ? TEXT("True") : TEXT("False"));
+	UE_LOG(LogProjectCleanerBenchmark, Display, TEXT("	Benchmark - %s, %d iterations, output %s"), bBenchmark ? TEXT("True") : TEXT("False"), Iterations, *OutputFile);
+	UE_LOG(LogProjectCleanerBenchmark, Display, TEXT("	Delete - %s"), bDelete ? TEXT("True") : TEXT("False"));
+	UE_LOG(LogProjectCleanerBenchmark, Display, TEXT("	Clean - %s"), bClean ? TEXT("True") : TEXT("False"));
+	UE_LOG(LogProjectCleanerBenchmark, Display, TEXT("	Micro - %s"), bMicro ? TEXT("True") : TEXT("False"));
+	UE_LOG(LogProjectCleanerBenchmark, Display, TEXT("	Baseline - %s, tolerance %.0f%%, time slack %.3f s, memory slack %lld MB"),
+		BaselineFile.IsEmpty() ? TEXT("None") : *BaselineFile,
+		Tolerance * 100.0f,
+		TimeSlack,
+		MemorySlack / (1024 * 1024)
+	);
+	UE_LOG(LogProjectCleanerBenchmark, Display, TEXT("	Fixture - %s, %d assets, %s topology, cluster %d, fan-out %d, %d assets per folder"),
+		*FixtureSettings.RootPath,
+		FixtureSettings.AssetsNum,
+		FCleanerCoreBenchmarkSettings::TopologyToString(FixtureSettings.Topology),
+		FixtureSettings.ClusterSize,
+		FixtureSettings.FanOut,
+		FixtureSettings.AssetsPerFolder
+	);
+	UE_LOG(LogProjectCleanerBenchmark, Display, TEXT("	Fixture - %d blueprint hierarchies of depth %d, indirect ratio %.2f, %d non engine files, %d empty folders, seed %d"),
+		FixtureSettings.BlueprintHierarchies,
+		FixtureSettings.BlueprintDepth,
+		FixtureSettings.IndirectRatio,
+		FixtureSettings.NonEngineFilesNum,
+		FixtureSettings.EmptyFoldersNum,
+		FixtureSettings.Seed
+	);
+}
+
+bool UProjectCleanerBenchmarkCommandlet::RunBenchmark(FProjectCleanerBenchmarkFixture& Fixture)
+{
+	Reports.Reset(Iterations);
+
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		// previous iteration deleted unused part of fixture
+		if (bDelete && Iteration > 0 && !Fixture.Generate())
+		{
+			UE_LOG(LogProjectCleanerBenchmark, Error, TEXT("Failed to regenerate synthetic project"));
+			return false;
+		}
+
+		FProjectCleanerDataManager CleanerDataManager;
+		CleanerDataManager.SetSilentMode(true);
+		CleanerDataManager.AnalyzeProject();
+
+		FCleanerAnalysisReport Report = CleanerDataManager.GetAnalysisReport();
+
+		// planning only reads analysis results, so it is measured even when nothing is deleted
+		FProjectCleanerAnalysisPipeline DeletionPipeline;
+		DeletionPipeline.AddStage(TEXT("PlanDeletion"), [&] ()
+		{
+			TArray<TArray<FAssetData>> Buckets;
+			return CleanerDataManager.PlanDeletion(FProjectCleanerDataManager::DeletionBucketSize, Buckets);
+		});
+
+		if (bDelete)
+		{
+			DeletionPipeline.AddStage(TEXT("DeleteAllUnusedAssets"), [&] ()
+			{
+				return CleanerDataManager.DeleteAllUnusedAssets();
+			});
+			DeletionPipeline.AddStage(TEXT("DeleteEmptyFolders"), [&] ()
+			{
+				return CleanerDataManager.DeleteEmptyFolders();
+			});
+		}
+
+		FCleanerAnalysisReport DeletionReport;
+		DeletionPipeline.Run(DeletionReport);
+
+		Report.Stages.Append(DeletionReport.Stages);
+		Report.TotalWallTime += DeletionReport.TotalWallTime;
+		Report.TotalCpuTime += DeletionReport.TotalCpuTime;
+		Report.PeakUsedMemory = FMath::Max(Report.PeakUsedMemory, DeletionReport.PeakUsedMemory);
+
+		UE_LOG(LogProjectCleanerBenchmark, Display, TEXT("Iteration %d/%d - %.3f s (CPU %.3f s)"), Iteration + 1, Iterations, Report.TotalWallTime, Report.TotalCpuTime);
+		Reports.Add(MoveTemp(Report));
+	}
+
+	return true;
+}
+
+void UProjectCleanerBenchmarkCommandlet::RunMicroBenchmark()
+{
+	Reports.Reset(Iterations);
+
+	FCleanerCoreBenchmarkSettings CoreSettings;
+	CoreSettings.RootPath = FixtureSettings.RootPath;
+	CoreSettings.NodesNum = FixtureSettings.AssetsNum;
+	CoreSettings.Topology = FixtureSettings.Topology;
+	CoreSettings.ClusterSize = FixtureSettings.ClusterSize;
+	CoreSettings.FanOut = FixtureSettings.FanOut;
+	CoreSettings.NodesPerFolder = FixtureSettings.AssetsPerFolder;
+	CoreSettings.IndirectRatio = FixtureSettings.IndirectRatio;
+	CoreSettings.Seed = FixtureSettings.Seed;
+
+	FCleanerCoreBenchmark CoreBenchmark{CoreSettings};
+
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		FProjectCleanerAnalysisPipeline Pipeline;
+		CoreBenchmark.AddStages([&] (const FName Name, TFunction<int64()> Work)
+		{
+			Pipeline.AddStage(Name, MoveTemp(Work));
+		});
+
+		FCleanerAnalysisReport Report;
+		Pipeline.Run(Report);
+
+		UE_LOG(LogProjectCleanerBenchmark, Display, TEXT("Iteration %d/%d - %.3f s, %s"),
+			Iteration + 1,
+			Iterations,
+			Report.TotalWallTime,
+			*CoreBenchmark.GetSummary()
+		);
+		Reports.Add(MoveTemp(Report));
+	}
+}
+
+bool UProjectCleanerBenchmarkCommandlet::SaveResults() const
+{
+	using namespace ProjectCleanerBenchmark;
+
+	FString Json;
+	const TSharedRef<FJsonWriter> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&Json);
+
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("iterations"), Reports.Num());
+
+	Writer->WriteObjectStart(TEXT("fixture"));
+	Writer->WriteValue(TEXT("root"), FixtureSettings.RootPath);
+	Writer->WriteValue(TEXT("assets"), FixtureSettings.AssetsNum);
+	Writer->WriteValue(TEXT("topology"), FString{FCleanerCoreBenchmarkSettings::TopologyToString(FixtureSettings.Topology)});
+	Writer->WriteValue(TEXT("cluster_size"), FixtureSettings.ClusterSize);
+	Writer->WriteValue(TEXT("fan_out"), FixtureSettings.FanOut);
+	Writer->WriteValue(TEXT("assets_per_folder"), FixtureSettings.AssetsPerFolder);
+	Writer->WriteValue(TEXT("blueprint_hierarchies"), FixtureSettings.BlueprintHierarchies);
+	Writer->WriteValue(TEXT("blueprint_depth"), FixtureSettings.BlueprintDepth);
+	Writer->WriteValue(TEXT("indirect_ratio"), FixtureSettings.IndirectRatio);
+	Writer->WriteValue(TEXT("non_engine_files"), FixtureSettings.NonEngineFilesNum);
+	Writer->WriteValue(TEXT("empty_folders"), FixtureSettings.EmptyFoldersNum);
+	Writer->WriteValue(TEXT("seed"), FixtureSettings.Seed);
+	Writer->WriteValue(TEXT("delete"), bDelete);
+	Writer->WriteObjectEnd();
+
+	TArray<double> TotalWallTimes;
+	TArray<double> TotalCpuTimes;
+	TArray<double> PeakMemory;
+	for (const auto& Report : Reports)
+	{
+		TotalWallTimes.Add(Report.TotalWallTime);
+		TotalCpuTimes.Add(Report.TotalCpuTime);
+		PeakMemory.Add(Report.PeakUsedMemory);
+	}
+
+	Writer->WriteObjectStart(TEXT("total"));
+	WriteDistribution(*Writer, TEXT("wall_time_sec"), TotalWallTimes);
+	WriteDistribution(*Writer, TEXT("cpu_time_sec"), TotalCpuTimes);
+	WriteDistribution(*Writer, TEXT("peak_used_memory_bytes"), PeakMemory);
+	Writer->WriteObjectEnd();
+
+	UE_LOG(LogProjectCleanerBenchmark, Display, TEXT(""));
+	UE_LOG(LogProjectCleanerBenchmark, Display, TEXT("	%-28s %12s %12s %12s"), TEXT("Stage"), TEXT("p50 (s)"), TEXT("p90 (s)"), TEXT("max (s)"));
+
+	Writer->WriteArrayStart(TEXT("stages"));
+	for (const FName& StageName : GetStageNames(Reports))
+	{
+		const TArray<double> WallTimes = GetStageSamples(Reports, StageName, [] (const FCleanerStageStats& Stage) { return Stage.WallTime; });
+
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), StageName.ToString());
+		Writer->WriteValue(TEXT("samples"), WallTimes.Num());
+		WriteDistribution(*Writer, TEXT("wall_time_sec"), WallTimes);
+		WriteDistribution(*Writer, TEXT("cpu_time_sec"), GetStageSamples(Reports, StageName, [] (const FCleanerStageStats& Stage) { return Stage.CpuTime; }));
+		WriteDistribution(*Writer, TEXT("memory_delta_bytes"), GetStageSamples(Reports, StageName, [] (const FCleanerStageStats& Stage) { return static_cast<double>(Stage.MemoryDelta); }));
+		WriteDistribution(*Writer, TEXT("peak_memory_growth_bytes"), GetStageSamples(Reports, StageName, [] (const FCleanerStageStats& Stage) { return static_cast<double>(Stage.PeakMemoryGrowth); }));
+		WriteDistribution(*Writer, TEXT("items_processed"), GetStageSamples(Reports, StageName, [] (const FCleanerStageStats& Stage) { return static_cast<double>(Stage.ItemsProcessed); }));
+		Writer->WriteObjectEnd();
+
+		UE_LOG(LogProjectCleanerBenchmark, Display, TEXT("	%-28s %12.3f %12.3f %12.3f"),
+			*StageName.ToString(),
+			GetPercentile(WallTimes, 50.0),
+			GetPercentile(WallTimes, 90.0),
+			WallTimes.Num() > 0 ? WallTimes.Last() : 0.0
+		);
+	}
+	Writer->WriteArrayEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	if (!FFileHelper::SaveStringToFile(Json, *OutputFile))
+	{
+		UE_LOG(LogProjectCleanerBenchmark, Error, TEXT("Failed to save benchmark results to %s"), *OutputFile);
+		return false;
+	}
+
+	UE_LOG(LogProjectCleanerBenchmark, Display, TEXT("Benchmark results saved to %s"), *OutputFile);
+	return true;
+}
+
+bool UProjectCleanerBenchmarkCommandlet::CheckBudgets() const
+{
+	using namespace ProjectCleanerBenchmark;
+
+	FProjectCleanerBenchmarkBaseline Baseline;
+	Baseline.Tolerance = Tolerance;
+	Baseline.TimeSlack = TimeSlack;
+	Baseline.MemorySlack = MemorySlack;
+	if (!Baseline.Load(BaselineFile))
+	{
+		UE_LOG(LogProjectCleanerBenchmark, Error, TEXT("Failed to read baseline %s"), *BaselineFile);
+		return false;
+	}
+
+	if (!Baseline.IsMeasuredOn(FixtureSettings))
+	{
+		UE_LOG(LogProjectCleanerBenchmark, Error, TEXT("Baseline %s was measured on different fixture"), *BaselineFile);
+		return false;
+	}
+
+	UE_LOG(LogProjectCleanerBenchmark, Display, TEXT(""));
+	UE_LOG(LogProjectCleanerBenchmark, Display, TEXT("	%-28s %12s %12s %14s %14s  %s"), TEXT("Stage"), TEXT("p50 (s)"), TEXT("budget (s)"), TEXT("peak (KB)"), TEXT("budget (KB)"), TEXT("Status"));
+
+	bool bWithinBudgets = true;
+	for (const FName& StageName : Baseline.GetStageNames())
+	{
+		const TArray<double> WallTimes = GetStageSamples(Reports, StageName, [] (const FCleanerStageStats& Stage) { return Stage.WallTime; });
+		double WallTimeBudget = 0.0;
+		double MemoryBudget = 0.0;
+		if (WallTimes.Num() == 0 || !Baseline.GetStageBudget(StageName, WallTimeBudget, MemoryBudget))
+		{
+			UE_LOG(LogProjectCleanerBenchmark, Warning, TEXT("	%-28s not measured in this run"), *StageName.ToString());
+			continue;
+		}
+
+		const TArray<double> PeakMemoryGrowths = GetStageSamples(Reports, StageName, [] (const FCleanerStageStats& Stage) { return static_cast<double>(Stage.PeakMemoryGrowth); });
+
+		// median time is robust to single noisy iteration, memory is checked against worst case
+		const double WallTime = GetPercentile(WallTimes, 50.0);
+		const double PeakMemoryGrowth = PeakMemoryGrowths.Last();
+
+		const bool bStageWithinBudget = WallTime <= WallTimeBudget && PeakMemoryGrowth <= MemoryBudget;
+		bWithinBudgets &= bStageWithinBudget;
+
+		UE_LOG(LogProjectCleanerBenchmark, Display, TEXT("	%-28s %12.3f %12.3f %14.0f %14.0f  %s"),
+			*StageName.ToString(),
+			WallTime,
+			WallTimeBudget,
+			PeakMemoryGrowth / 1024.0,
+			MemoryBudget / 1024.0,
+			bStageWithinBudget ? TEXT("OK") : TEXT("REGRESSION")
+		);
+	}
+
+	if (!bWithinBudgets)
+	{
+		UE_LOG(LogProjectCleanerBenchmark, Error, TEXT("Some stages exceeded their budgets from %s"), *BaselineFile);
+	}
+
+	return bWithinBudgets;
+}
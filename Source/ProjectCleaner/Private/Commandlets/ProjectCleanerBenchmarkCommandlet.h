@@ -0,0 +1,49 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "StructsContainer.h"
+#include "ProjectCleanerBenchmarkFixture.h"
+// Engine Headers
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ProjectCleanerBenchmarkCommandlet.generated.h"
+
+/**
+ * Commandlet for generating synthetic projects and measuring analysis and deletion performance
+ */
+UCLASS()
+class PROJECTCLEANER_API UProjectCleanerBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+public:
+	UProjectCleanerBenchmarkCommandlet();
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	void ParseCommandLinesArguments(const FString& Params);
+	void ShowArgumentsInLog() const;
+	bool RunBenchmark(FProjectCleanerBenchmarkFixture& Fixture);
+	void RunMicroBenchmark();
+	bool SaveResults() const;
+	/** Compares stage timings and per stage peak memory growth with baseline results, false on regression */
+	bool CheckBudgets() const;
+
+	bool bGenerate = false;
+	bool bBenchmark = false;
+	bool bDelete = false;
+	bool bClean = false;
+	bool bMicro = false;
+	int32 Iterations = 5;
+	FString OutputFile;
+	FString BaselineFile;
+	/** Allowed relative growth over baseline */
+	float Tolerance = 0.2f;
+	/** Absolute allowances, so very short stages are not failed by timer noise */
+	float TimeSlack = 0.05f;
+	int64 MemorySlack = 16 * 1024 * 1024;
+	FCleanerBenchmarkFixtureSettings FixtureSettings;
+
+	/** Every iteration's report, stage lists are merged by stage name */
+	TArray<FCleanerAnalysisReport> Reports;
+};
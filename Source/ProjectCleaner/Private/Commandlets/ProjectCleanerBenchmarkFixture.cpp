@@ -0,0 +1,359 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "ProjectCleanerBenchmarkFixture.h"
+#include "ProjectCleaner.h"
+// Engine Headers
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/ObjectLibrary.h"
+#include "GameFramework/Actor.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "ObjectTools.h"
+#include "UObject/Package.h"
+
+namespace ProjectCleanerBenchmarkFixture
+{
+	// generated objects are unrooted and collected every N assets, so 1M asset fixtures fit in memory
+	constexpr int32 GarbageCollectionInterval = 4096;
+	constexpr int32 DeletionBucketSize = 500;
+	const TCHAR* NonEngineExtensions[] = {TEXT("txt"), TEXT("psd"), TEXT("fbx"), TEXT("blend")};
+}
+
+FProjectCleanerBenchmarkFixture::FProjectCleanerBenchmarkFixture(const FCleanerBenchmarkFixtureSettings& InSettings) :
+	Settings(InSettings),
+	Random(InSettings.Seed)
+{
+	Settings.RootPath.RemoveFromEnd(TEXT("/"));
+	Settings.ClusterSize = FMath::Max(1, Settings.ClusterSize);
+	Settings.FanOut = FMath::Max(1, Settings.FanOut);
+	Settings.AssetsPerFolder = FMath::Max(1, Settings.AssetsPerFolder);
+}
+
+bool FProjectCleanerBenchmarkFixture::Generate()
+{
+	Clean();
+
+	Random.Initialize(Settings.Seed);
+	IndirectObjectPaths.Reset();
+	GeneratedAssetsNum = 0;
+	UsedAssetsNum = 0;
+
+	UE_LOG(LogProjectCleaner, Display, TEXT("Generating %d assets (%s topology) under %s"),
+		Settings.AssetsNum,
+		FCleanerCoreBenchmarkSettings::TopologyToString(Settings.Topology),
+		*Settings.RootPath
+	);
+
+	if (!GenerateClusters() || !GenerateBlueprintHierarchies())
+	{
+		return false;
+	}
+
+	if (!WriteIndirectReferences() || !WriteNonEngineFiles() || !WriteEmptyFolders())
+	{
+		return false;
+	}
+
+	// dependencies are read from package headers, so registry must see saved files before analysis
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+	AssetRegistry.ScanPathsSynchronous({Settings.RootPath}, true);
+
+	UE_LOG(LogProjectCleaner, Display, TEXT("Generated %d assets, %d of them used"), GeneratedAssetsNum, UsedAssetsNum);
+
+	return true;
+}
+
+void FProjectCleanerBenchmarkFixture::Clean() const
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssetsByPath(FName{*Settings.RootPath}, Assets, true);
+
+	// deleting through ObjectTools keeps registry in sync, so fixture can be regenerated in same session
+	TArray<UObject*> Objects;
+	Objects.Reserve(ProjectCleanerBenchmarkFixture::DeletionBucketSize);
+	for (int32 i = 0; i < Assets.Num(); ++i)
+	{
+		if (UObject* Object = Assets[i].GetAsset())
+		{
+			Objects.Add(Object);
+		}
+
+		if (Objects.Num() == ProjectCleanerBenchmarkFixture::DeletionBucketSize || i == Assets.Num() - 1)
+		{
+			ObjectTools::ForceDeleteObjects(Objects, false);
+			Objects.Reset();
+		}
+	}
+
+	IFileManager::Get().DeleteDirectory(*GetContentDir(), false, true);
+	IFileManager::Get().DeleteDirectory(*FPaths::GetPath(GetIndirectSourceFile()), false, true);
+	IFileManager::Get().Delete(*GetIndirectConfigFile(), false, true, true);
+	AssetRegistry.RemovePath(Settings.RootPath);
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+int32 FProjectCleanerBenchmarkFixture::GetUsedAssetsNum() const
+{
+	return UsedAssetsNum;
+}
+
+int32 FProjectCleanerBenchmarkFixture::GetGeneratedAssetsNum() const
+{
+	return GeneratedAssetsNum;
+}
+
+int32 FProjectCleanerBenchmarkFixture::GetIndirectReferencesNum() const
+{
+	return IndirectObjectPaths.Num();
+}
+
+bool FProjectCleanerBenchmarkFixture::GenerateClusters()
+{
+	const int32 ClustersNum = FMath::DivideAndRoundUp(Settings.AssetsNum, Settings.ClusterSize);
+	int32 AssetsSinceCollect = 0;
+
+	TArray<UObjectLibrary*> Cluster;
+	Cluster.Reserve(Settings.ClusterSize);
+
+	for (int32 ClusterIndex = 0; ClusterIndex < ClustersNum; ++ClusterIndex)
+	{
+		const int32 FirstIndex = ClusterIndex * Settings.ClusterSize;
+		const int32 Num = FMath::Min(Settings.ClusterSize, Settings.AssetsNum - FirstIndex);
+		const ECleanerFixtureTopology Topology = Settings.Topology == ECleanerFixtureTopology::Mixed
+			? static_cast<ECleanerFixtureTopology>(1 + ClusterIndex % 3)
+			: Settings.Topology;
+
+		Cluster.Reset();
+		for (int32 i = 0; i < Num; ++i)
+		{
+			const FString PackageName = GetAssetPackageName(FirstIndex + i);
+			UPackage* Package = CreatePackage(*PackageName);
+			UObjectLibrary* Library = NewObject<UObjectLibrary>(Package, *FPackageName::GetShortName(PackageName), RF_Public | RF_Standalone);
+			Cluster.Add(Library);
+		}
+
+		// first node of every cluster is its root, all other nodes are reachable from it
+		for (int32 i = 0; i < Num; ++i)
+		{
+			auto& Objects = Cluster[i]->Objects;
+			switch (Topology)
+			{
+				case ECleanerFixtureTopology::Chain:
+					if (i + 1 < Num)
+					{
+						Objects.Add(Cluster[i + 1]);
+					}
+					break;
+				case ECleanerFixtureTopology::FanOut:
+					for (int32 Child = i * Settings.FanOut + 1; Child <= i * Settings.FanOut + Settings.FanOut && Child < Num; ++Child)
+					{
+						Objects.Add(Cluster[Child]);
+					}
+					break;
+				default:
+					if (Num > 1)
+					{
+						Objects.Add(Cluster[(i + 1) % Num]);
+					}
+					break;
+			}
+		}
+
+		for (UObjectLibrary* Library : Cluster)
+		{
+			FAssetRegistryModule::AssetCreated(Library);
+			if (!SaveAsset(Library))
+			{
+				return false;
+			}
+		}
+
+		if (Random.FRand() < Settings.IndirectRatio)
+		{
+			IndirectObjectPaths.Add(Cluster[0]->GetPathName());
+			UsedAssetsNum += Num;
+		}
+
+		for (UObjectLibrary* Library : Cluster)
+		{
+			Library->ClearFlags(RF_Standalone);
+		}
+
+		GeneratedAssetsNum += Num;
+		AssetsSinceCollect += Num;
+		if (AssetsSinceCollect >= ProjectCleanerBenchmarkFixture::GarbageCollectionInterval)
+		{
+			Cluster.Reset();
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			AssetsSinceCollect = 0;
+			UE_LOG(LogProjectCleaner, Display, TEXT("	%d of %d assets generated"), GeneratedAssetsNum, Settings.AssetsNum);
+		}
+	}
+
+	return true;
+}
+
+bool FProjectCleanerBenchmarkFixture::GenerateBlueprintHierarchies()
+{
+	for (int32 Hierarchy = 0; Hierarchy < Settings.BlueprintHierarchies; ++Hierarchy)
+	{
+		UClass* ParentClass = AActor::StaticClass();
+		UBlueprint* Blueprint = nullptr;
+
+		for (int32 Depth = 0; Depth < Settings.BlueprintDepth; ++Depth)
+		{
+			const FString AssetName = FString::Printf(TEXT("BP_H%03d_D%03d"), Hierarchy, Depth);
+			const FString PackageName = FString::Printf(TEXT("%s/Blueprints/H%03d/%s"), *Settings.RootPath, Hierarchy, *AssetName);
+
+			Blueprint = FKismetEditorUtilities::CreateBlueprint(
+				ParentClass,
+				CreatePackage(*PackageName),
+				*AssetName,
+				BPTYPE_Normal,
+				UBlueprint::StaticClass(),
+				UBlueprintGeneratedClass::StaticClass()
+			);
+
+			if (!Blueprint || !Blueprint->GeneratedClass)
+			{
+				UE_LOG(LogProjectCleaner, Error, TEXT("Failed to create blueprint %s"), *PackageName);
+				return false;
+			}
+
+			FAssetRegistryModule::AssetCreated(Blueprint);
+			if (!SaveAsset(Blueprint))
+			{
+				return false;
+			}
+
+			ParentClass = Blueprint->GeneratedClass;
+			++GeneratedAssetsNum;
+		}
+
+		// deepest child depends on whole hierarchy, referencing its class keeps every level used
+		if (Blueprint && Hierarchy % 2 == 0)
+		{
+			IndirectObjectPaths.Add(Blueprint->GeneratedClass->GetPathName());
+			UsedAssetsNum += Settings.BlueprintDepth;
+		}
+	}
+
+	return true;
+}
+
+bool FProjectCleanerBenchmarkFixture::WriteIndirectReferences() const
+{
+	FString Source = TEXT("// Generated by ProjectCleanerBenchmark commandlet\n\n#pragma once\n\n");
+	FString Config = TEXT("; Generated by ProjectCleanerBenchmark commandlet\n\n[ProjectCleanerBench]\n");
+
+	// alternating between source and config, so both scanners get same share of work
+	for (int32 i = 0; i < IndirectObjectPaths.Num(); ++i)
+	{
+		if (i % 2 == 0)
+		{
+			Source += FString::Printf(TEXT("static const TCHAR* BenchReference%d = TEXT(\"%s\");\n"), i, *IndirectObjectPaths[i]);
+		}
+		else
+		{
+			Config += FString::Printf(TEXT("+Assets=%s\n"), *IndirectObjectPaths[i]);
+		}
+	}
+
+	if (!FFileHelper::SaveStringToFile(Source, *GetIndirectSourceFile()) || !FFileHelper::SaveStringToFile(Config, *GetIndirectConfigFile()))
+	{
+		UE_LOG(LogProjectCleaner, Error, TEXT("Failed to write indirect references"));
+		return false;
+	}
+
+	return true;
+}
+
+bool FProjectCleanerBenchmarkFixture::WriteNonEngineFiles() const
+{
+	const FString ContentDir = GetContentDir();
+	const int32 ExtensionsNum = UE_ARRAY_COUNT(ProjectCleanerBenchmarkFixture::NonEngineExtensions);
+
+	for (int32 i = 0; i < Settings.NonEngineFilesNum; ++i)
+	{
+		const FString FilePath = FString::Printf(TEXT("%sNonEngine/F%03d/File_%05d.%s"),
+			*ContentDir,
+			i % 16,
+			i,
+			ProjectCleanerBenchmarkFixture::NonEngineExtensions[i % ExtensionsNum]
+		);
+
+		if (!FFileHelper::SaveStringToFile(FString::Printf(TEXT("Synthetic non engine file %d"), i), *FilePath))
+		{
+			UE_LOG(LogProjectCleaner, Error, TEXT("Failed to write %s"), *FilePath);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FProjectCleanerBenchmarkFixture::WriteEmptyFolders() const
+{
+	const FString ContentDir = GetContentDir();
+
+	for (int32 i = 0; i < Settings.EmptyFoldersNum; ++i)
+	{
+		// every fourth folder is nested, to exercise recursive emptiness check
+		FString FolderPath = FString::Printf(TEXT("%sEmpty/E%05d"), *ContentDir, i);
+		if (i % 4 == 0)
+		{
+			FolderPath /= TEXT("Nested");
+		}
+
+		if (!IFileManager::Get().MakeDirectory(*FolderPath, true))
+		{
+			UE_LOG(LogProjectCleaner, Error, TEXT("Failed to create %s"), *FolderPath);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+FString FProjectCleanerBenchmarkFixture::GetAssetPackageName(const int32 Index) const
+{
+	return FString::Printf(TEXT("%s/F%04d/A%07d"), *Settings.RootPath, Index / Settings.AssetsPerFolder, Index);
+}
+
+FString FProjectCleanerBenchmarkFixture::GetContentDir() const
+{
+	return FPaths::ConvertRelativePathToFull(FPackageName::LongPackageNameToFilename(Settings.RootPath + TEXT("/")));
+}
+
+FString FProjectCleanerBenchmarkFixture::GetIndirectSourceFile() const
+{
+	// folder has no Build.cs, so UBT never compiles it
+	return FPaths::ProjectDir() / TEXT("Source/ProjectCleanerBench/ProjectCleanerBenchReferences.h");
+}
+
+FString FProjectCleanerBenchmarkFixture::GetIndirectConfigFile() const
+{
+	return FPaths::ProjectConfigDir() / TEXT("DefaultProjectCleanerBench.ini");
+}
+
+bool FProjectCleanerBenchmarkFixture::SaveAsset(UObject* Asset)
+{
+	UPackage* Package = Asset->GetOutermost();
+	Package->MarkPackageDirty();
+
+	const FString FileName = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+	if (!UPackage::SavePackage(Package, Asset, RF_Public | RF_Standalone, *FileName, GError, nullptr, false, true, SAVE_NoError))
+	{
+		UE_LOG(LogProjectCleaner, Error, TEXT("Failed to save %s"), *FileName);
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,69 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "ProjectCleanerCoreBenchmark.h"
+// Engine Headers
+#include "CoreMinimal.h"
+
+/**
+ * Shape of generated synthetic project
+ */
+struct FCleanerBenchmarkFixtureSettings
+{
+	/** Package path all generated assets live under */
+	FString RootPath = TEXT("/Game/ProjectCleanerBench");
+	int32 AssetsNum = 10000;
+	ECleanerFixtureTopology Topology = ECleanerFixtureTopology::Mixed;
+	/** Assets in single chain, fan-out or cycle cluster */
+	int32 ClusterSize = 64;
+	/** Max children of single fan-out node */
+	int32 FanOut = 8;
+	int32 AssetsPerFolder = 500;
+	/** Number of blueprint inheritance chains and depth of each */
+	int32 BlueprintHierarchies = 4;
+	int32 BlueprintDepth = 8;
+	/** Fraction of clusters whose root is referenced from generated source or config files */
+	float IndirectRatio = 0.1f;
+	int32 NonEngineFilesNum = 100;
+	int32 EmptyFoldersNum = 100;
+	int32 Seed = 0;
+};
+
+/**
+ * Generates and removes reproducible synthetic /Game tree for benchmarking
+ * Assets are ObjectLibraries referencing each other, so dependency graph is exactly what settings describe
+ */
+class FProjectCleanerBenchmarkFixture
+{
+public:
+	explicit FProjectCleanerBenchmarkFixture(const FCleanerBenchmarkFixtureSettings& InSettings);
+
+	bool Generate();
+	void Clean() const;
+
+	/** Number of generated assets that are reachable from indirect references */
+	int32 GetUsedAssetsNum() const;
+	int32 GetGeneratedAssetsNum() const;
+	/** Number of object paths written to generated source and config files */
+	int32 GetIndirectReferencesNum() const;
+	/** Absolute directory generated assets, non engine files and empty folders live in */
+	FString GetContentDir() const;
+private:
+	bool GenerateClusters();
+	bool GenerateBlueprintHierarchies();
+	bool WriteIndirectReferences() const;
+	bool WriteNonEngineFiles() const;
+	bool WriteEmptyFolders() const;
+
+	FString GetAssetPackageName(const int32 Index) const;
+	FString GetIndirectSourceFile() const;
+	FString GetIndirectConfigFile() const;
+	static bool SaveAsset(UObject* Asset);
+
+	FCleanerBenchmarkFixtureSettings Settings;
+	FRandomStream Random;
+	TArray<FString> IndirectObjectPaths;
+	int32 GeneratedAssetsNum = 0;
+	int32 UsedAssetsNum = 0;
+};
@@ -5,6 +5,7 @@
 #include "Kismet/KismetStringLibrary.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Core/ProjectCleanerDataManager.h"
+#include "Core/ProjectCleanerUtility.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogProjectCleanerCLI, Display, All);
 
@@ -21,17 +22,15 @@ int32 UProjectCleanerCLICommandlet::Main(const FString& Params)
 
 	ParseCommandLinesArguments(Params);
 
-	if (ProjectHasRedirectors())
-	{
-		UE_LOG(LogProjectCleanerCLI, Error, TEXT("Project contains redirectors. Please fix up them before procceding."));
-		UE_LOG(LogProjectCleanerCLI, Error, TEXT("Run 'UE4Editor-Cmd.exe <GameName or uproject> -run=ResavePackages -fixupredirects -autocheckout -projectonly -unattended'"));
-		return 1;
-	}
-	
 	if (IsArgumentsValid())
 	{
 		FProjectCleanerDataManager CleanerDataManager;
 		CleanerDataManager.SetSilentMode(true);
+		CleanerDataManager.SetReadOnly(bReadOnly);
+		CleanerDataManager.SetReadPackageHeaders(bReadPackageHeaders);
+		CleanerDataManager.SetValidatePackages(bValidatePackages);
+		CleanerDataManager.SetFindDuplicates(bFindDuplicates);
+		CleanerDataManager.SetRegistryFromFile(!RegistryFile.IsEmpty());
 		CleanerDataManager.SetUserExcludedAssets(ExcludedAssets);
 		CleanerDataManager.SetExcludePaths(ExcludedPaths);
 		CleanerDataManager.SetExcludeClasses(ExcludedClasses);
@@ -45,7 +44,17 @@ int32 UProjectCleanerCLICommandlet::Main(const FString& Params)
 		UE_LOG(LogProjectCleanerCLI, Display, TEXT("===================================="));
 		UE_LOG(LogProjectCleanerCLI, Display, TEXT(""));
 
-		if (bCheckOnly)
+		if (bWriteReport && !WriteReport(CleanerDataManager))
+		{
+			return 1;
+		}
+
+		if (!SaveRegistryFilePath.IsEmpty() && !SaveRegistryFile())
+		{
+			return 1;
+		}
+
+		if (bCheckOnly || bReadOnly)
 		{
 			return 0;
 		}
@@ -74,24 +83,44 @@ void UProjectCleanerCLICommandlet::ParseCommandLinesArguments(const FString& Par
 	ParseCommandLine(*Params, Tokens, Switches, Parameters);
 
 	// CLI - arguments
-	// -Check
+	// -Check - implies -ReadOnly
+	// -ReadOnly
+	// -ReadPackageHeaders
+	// -ValidatePackages
+	// -FindDuplicates
 	// -ScanDevContent
 	// -DeleteEmptyFolders
 	// -ExcludeAssets= /Game/Blueprint/aaa.uasset
 	// -ExcludeAssetsInPath = /Game/Blueprint/
 	// -ExcludeAssetWithClass= UBlueprint,UMaterial
+	// -Report= json|csv|ndjson
+	// -ReportFile= D:/Reports/Cleaner.json
+	// -ReportCompress
+	// -RegistryFile= - implies -ReadOnly, D:/Project/Saved/ProjectCleaner/AssetRegistry.bin written by -SaveRegistryFile=
+	//                  cook registries (DevelopmentAssetRegistry.bin) list cooked packages only, rest of package files are not analysed
+	// -SaveRegistryFile= - D:/Project/Saved/ProjectCleaner/AssetRegistry.bin, full editor registry for -RegistryFile= and ProjectCleanerAnalyzer
 
 	// if no argument given then we set default scenario
 	// -Check - false
+	// -ReadOnly - false
+	// -ReadPackageHeaders - false
+	// -ValidatePackages - false
+	// -FindDuplicates - false
 	// -ScanDevContent - false
 	// -DeleteEmptyFolders - true
 	// -ExcludeAssets - empty
 	// -ExcludeAssetsInPath - empty 
 	// -ExcludeAssetWithClass - empty
+	// -Report - no report
+	// -ReportFile - Saved/ProjectCleaner/Report.<format>
+	// -ReportCompress - false
+	// -RegistryFile - asset registry is gathered from disk
+	// -SaveRegistryFile - registry is not saved
 	if (Switches.Num() == 0 && Parameters.Num() == 1 && Tokens.Num() == 0) // Parameters contain -run=ProjectCleanerCLI - argument only
 	{
 		bArgumentsValid = true;
 		bCheckOnly = false;
+		bReadOnly = false;
 		bScanDeveloperContents = false;
 		bAutomaticallyDeleteEmptyFolders = true;
 		ExcludedAssets.Empty();
@@ -108,6 +137,27 @@ void UProjectCleanerCLICommandlet::ParseCommandLinesArguments(const FString& Par
 		if (Switch.Equals(TEXT("Check"), ESearchCase::IgnoreCase))
 		{
 			bCheckOnly = true;
+			bReadOnly = true;
+		}
+
+		if (Switch.Equals(TEXT("ReadOnly"), ESearchCase::IgnoreCase))
+		{
+			bReadOnly = true;
+		}
+
+		if (Switch.Equals(TEXT("ReadPackageHeaders"), ESearchCase::IgnoreCase))
+		{
+			bReadPackageHeaders = true;
+		}
+
+		if (Switch.Equals(TEXT("ValidatePackages"), ESearchCase::IgnoreCase))
+		{
+			bValidatePackages = true;
+		}
+
+		if (Switch.Equals(TEXT("FindDuplicates"), ESearchCase::IgnoreCase))
+		{
+			bFindDuplicates = true;
 		}
 
 		if (Switch.Equals(TEXT("ScanDevContent"), ESearchCase::IgnoreCase))
@@ -119,6 +169,11 @@ void UProjectCleanerCLICommandlet::ParseCommandLinesArguments(const FString& Par
 		{
 			bAutomaticallyDeleteEmptyFolders = true;
 		}
+
+		if (Switch.Equals(TEXT("ReportCompress"), ESearchCase::IgnoreCase))
+		{
+			bCompressReport = true;
+		}
 	}
 	
 	FAssetRegistryModule& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName);
@@ -126,6 +181,17 @@ void UProjectCleanerCLICommandlet::ParseCommandLinesArguments(const FString& Par
 	TSet<FString> InvalidObjectPaths;
 	TSet<FString> InvalidPaths;
 	TSet<FString> InvalidClasses;
+	bool bInvalidReportFormat = false;
+	bool bInvalidRegistryFile = false;
+
+	// excluded assets, paths and classes below are validated against loaded registry
+	if (const FString* RegistryFileParam = Parameters.Find(TEXT("RegistryFile")))
+	{
+		RegistryFile = *RegistryFileParam;
+		// registry snapshot may be older than files on disk, so nothing is deleted based on it
+		bReadOnly = true;
+		bInvalidRegistryFile = !ProjectCleanerUtility::LoadAssetRegistryFromFile(RegistryFile);
+	}
 	
 	for (const auto Param : Parameters)
 	{
@@ -189,9 +255,30 @@ void UProjectCleanerCLICommandlet::ParseCommandLinesArguments(const FString& Par
 				}
 			}
 		}
+
+		if (Param.Key.Equals(TEXT("Report"), ESearchCase::IgnoreCase))
+		{
+			bWriteReport = FProjectCleanerReportWriter::ParseFormat(Param.Value, ReportFormat);
+			bInvalidReportFormat = !bWriteReport;
+		}
+
+		if (Param.Key.Equals(TEXT("ReportFile"), ESearchCase::IgnoreCase))
+		{
+			ReportFile = Param.Value;
+		}
+
+		if (Param.Key.Equals(TEXT("SaveRegistryFile"), ESearchCase::IgnoreCase))
+		{
+			SaveRegistryFilePath = Param.Value;
+		}
 	}
 
-	if (InvalidObjectPaths.Num() > 0 || InvalidPaths.Num() > 0 || InvalidClasses.Num() > 0)
+	if (bWriteReport && ReportFile.IsEmpty())
+	{
+		ReportFile = FProjectCleanerReportWriter::GetDefaultReportPath(ReportFormat, bCompressReport);
+	}
+
+	if (InvalidObjectPaths.Num() > 0 || InvalidPaths.Num() > 0 || InvalidClasses.Num() > 0 || bInvalidReportFormat || bInvalidRegistryFile)
 	{
 		UE_LOG(LogProjectCleanerCLI, Display, TEXT(""));
 		UE_LOG(LogProjectCleanerCLI, Display, TEXT(""));
@@ -215,6 +302,16 @@ void UProjectCleanerCLICommandlet::ParseCommandLinesArguments(const FString& Par
 			UE_LOG(LogProjectCleanerCLI, Error, TEXT("%s - Invalid path.Does not exists in AssetRegistry"), *InvalidClass);
 		}
 
+		if (bInvalidReportFormat)
+		{
+			UE_LOG(LogProjectCleanerCLI, Error, TEXT("Invalid report format. Supported formats are json, csv and ndjson"));
+		}
+
+		if (bInvalidRegistryFile)
+		{
+			UE_LOG(LogProjectCleanerCLI, Error, TEXT("%s - Invalid asset registry file"), *RegistryFile);
+		}
+
 		UE_LOG(LogProjectCleanerCLI, Display, TEXT(""));
 		UE_LOG(LogProjectCleanerCLI, Display, TEXT(""));
 		UE_LOG(LogProjectCleanerCLI, Warning, TEXT("Tip: ObjectPaths must be of format /Game/Materials/NewMaterial.NewMaterial"));
@@ -240,18 +337,55 @@ void UProjectCleanerCLICommandlet::ShowArgumentsInLog()
 	UE_LOG(LogProjectCleanerCLI, Display, TEXT(""));
 	UE_LOG(LogProjectCleanerCLI, Display, TEXT("CLI arguments - %s"), IsArgumentsValid() ? TEXT("OK") : TEXT("Invalid"));
 	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	Check [Just show information, no actions performed] - %s"), bCheckOnly ? TEXT("True") : TEXT("False"));
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	ReadOnly [Never load, save or fix up packages and never change editor settings] - %s"), bReadOnly ? TEXT("True") : TEXT("False"));
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	ReadPackageHeaders [Read assets and dependencies from package headers instead of asset registry] - %s"), bReadPackageHeaders ? TEXT("True") : TEXT("False"));
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	ValidatePackages [Check package headers for truncated or broken files] - %s"), bValidatePackages ? TEXT("True") : TEXT("False"));
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	FindDuplicates [Find assets with same content in different packages] - %s"), bFindDuplicates ? TEXT("True") : TEXT("False"));
 	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	ScanDevContent [Scan Developers Folder] - %s"), bScanDeveloperContents ? TEXT("True") : TEXT("False"));
 	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	DeleteEmptyFolders [Automatically delete all empty folders after assets deleted] - %s"), bAutomaticallyDeleteEmptyFolders ? TEXT("True") : TEXT("False"));
 	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	ExcludeAssets [Assets paths to exclude from scanning] - %s"), ExcludedAssets.Num() > 0 ? *UKismetStringLibrary::JoinStringArray(ExcludedAssets, TEXT(",")) : TEXT("[]"));
 	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	ExcludeAssetsInPath [Paths to exclude from scanning] - %s"), ExcludedPaths.Num() > 0 ? *UKismetStringLibrary::JoinStringArray(ExcludedPaths, TEXT(",")) : TEXT("[]"));
 	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	ExcludeAssetsWithClass [Asset Classes to exclude from scanning] - %s"), ExcludedClasses.Num() > 0 ? *UKismetStringLibrary::JoinStringArray(ExcludedClasses, TEXT(",")) : TEXT("[]"));
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	Report [Write machine-readable report to file] - %s"), bWriteReport ? *ReportFile : TEXT("False"));
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	RegistryFile [Serialized asset registry used instead of gathering assets from disk] - %s"), RegistryFile.IsEmpty() ? TEXT("False") : *RegistryFile);
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	SaveRegistryFile [Save gathered asset registry with all packages, tags and dependencies] - %s"), SaveRegistryFilePath.IsEmpty() ? TEXT("False") : *SaveRegistryFilePath);
 }
 
-bool UProjectCleanerCLICommandlet::ProjectHasRedirectors() const
+bool UProjectCleanerCLICommandlet::WriteReport(const FProjectCleanerDataManager& DataManager) const
 {
-	const auto AssetRegistry = &FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName);
- 	TArray<FAssetData> RedirectAssets;
- 	AssetRegistry->Get().GetAssetsByClass(UObjectRedirector::StaticClass()->GetFName(), RedirectAssets);
+	FProjectCleanerReportWriter Writer{ReportFormat, bCompressReport};
+	if (!Writer.Open(ReportFile))
+	{
+		return false;
+	}
+
+	DataManager.WriteReport(Writer);
+
+	if (!Writer.Close())
+	{
+		UE_LOG(LogProjectCleanerCLI, Error, TEXT("Failed to write report %s"), *ReportFile);
+		return false;
+	}
+
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("Report: %lld rows written to %s"), Writer.GetRowsNum(), *ReportFile);
+	return true;
+}
+
+bool UProjectCleanerCLICommandlet::SaveRegistryFile() const
+{
+	// development serialization options keep every package with its tags and dependencies, unlike registry written by cook
+	const FAssetRegistryModule& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName);
+	const bool bSaved = ProjectCleanerUtility::SaveFileAtomically(SaveRegistryFilePath, [&] (FArchive& Writer)
+	{
+		AssetRegistry.Get().Serialize(Writer);
+	});
+
+	if (!bSaved)
+	{
+		UE_LOG(LogProjectCleanerCLI, Error, TEXT("Failed to save asset registry %s"), *SaveRegistryFilePath);
+		return false;
+	}
 
-	return RedirectAssets.Num() > 0;
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("Asset registry saved to %s"), *SaveRegistryFilePath);
+	return true;
 }
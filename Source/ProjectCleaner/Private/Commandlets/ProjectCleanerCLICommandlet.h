@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "ProjectCleanerReportWriter.h"
 #include "CoreMinimal.h"
 #include "Commandlets/Commandlet.h"
 #include "ProjectCleanerCLICommandlet.generated.h"
@@ -21,12 +22,23 @@ private:
 	void ParseCommandLinesArguments(const FString& Params);
 	bool IsArgumentsValid() const;
 	void ShowArgumentsInLog();
-	bool ProjectHasRedirectors() const;
+	bool WriteReport(const class FProjectCleanerDataManager& DataManager) const;
+	bool SaveRegistryFile() const;
 
 	bool bArgumentsValid = false;
 	bool bCheckOnly = false;
+	bool bReadOnly = false;
+	bool bReadPackageHeaders = false;
+	bool bValidatePackages = false;
+	bool bFindDuplicates = false;
 	bool bScanDeveloperContents;
 	bool bAutomaticallyDeleteEmptyFolders;
+	bool bWriteReport = false;
+	bool bCompressReport = false;
+	ECleanerReportFormat ReportFormat = ECleanerReportFormat::Json;
+	FString ReportFile;
+	FString RegistryFile;
+	FString SaveRegistryFilePath;
 
 	TArray<FString> ExcludedAssets;
 	TArray<FString> ExcludedPaths;
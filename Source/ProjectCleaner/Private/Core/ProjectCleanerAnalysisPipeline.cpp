@@ -0,0 +1,285 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "Core/ProjectCleanerAnalysisPipeline.h"
+#include "Core/ProjectCleanerStats.h"
+#include "ProjectCleaner.h"
+// Engine Headers
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Async/Async.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <windows.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#elif PLATFORM_UNIX || PLATFORM_MAC
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+	/**
+	 * High water mark of memory used while single stage runs
+	 * Tracks ProjectCleaner LLM tag when LLM is running (-llm), otherwise process used physical memory
+	 * Sampled on separate thread, so short spikes between samples can be missed
+	 */
+	class FCleanerMemoryHighWaterMark
+	{
+	public:
+		FCleanerMemoryHighWaterMark() :
+			StartValue(GetTrackedMemory()),
+			PeakValue(StartValue)
+		{
+			if (FPlatformProcess::SupportsMultithreading())
+			{
+				Sampler = Async(EAsyncExecution::Thread, [this] ()
+				{
+					while (!bStopRequested)
+					{
+						Sample();
+						FPlatformProcess::Sleep(SampleInterval);
+					}
+				});
+			}
+		}
+
+		/** Stops sampling, returns how much tracked memory peaked above value at start */
+		int64 Stop()
+		{
+			bStopRequested = true;
+			if (Sampler.IsValid())
+			{
+				Sampler.Wait();
+			}
+			Sample();
+
+			return FMath::Max<int64>(0, PeakValue - StartValue);
+		}
+
+		int64 GetStartValue() const
+		{
+			return StartValue;
+		}
+
+		static int64 GetTrackedMemory()
+		{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+			if (FLowLevelMemTracker::IsEnabled())
+			{
+				return FLowLevelMemTracker::Get().GetTagAmountForTracker(ELLMTracker::Default, LLM_TAG_NAME(ProjectCleaner));
+			}
+#endif
+			return static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+		}
+	private:
+		void Sample()
+		{
+			PeakValue = FMath::Max(PeakValue, GetTrackedMemory());
+		}
+
+		static constexpr float SampleInterval = 0.001f;
+
+		const int64 StartValue;
+		int64 PeakValue;
+		FThreadSafeBool bStopRequested;
+		TFuture<void> Sampler;
+	};
+}
+
+FProjectCleanerAnalysisStage::FProjectCleanerAnalysisStage(const FName InName, TFunction<int64()> InWork) :
+	Name(InName),
+	Work(MoveTemp(InWork))
+{
+}
+
+void FProjectCleanerAnalysisStage::Run(FCleanerStageStats& OutStats) const
+{
+	OutStats.Name = Name;
+
+	FCleanerMemoryHighWaterMark HighWaterMark;
+	const double CpuTimeBefore = FProjectCleanerAnalysisPipeline::GetProcessCpuTime();
+	const double WallTimeBefore = FPlatformTime::Seconds();
+
+	{
+		LLM_SCOPE_BYTAG(ProjectCleaner);
+		OutStats.ItemsProcessed = Work ? Work() : 0;
+	}
+
+	OutStats.WallTime = FPlatformTime::Seconds() - WallTimeBefore;
+	OutStats.CpuTime = FProjectCleanerAnalysisPipeline::GetProcessCpuTime() - CpuTimeBefore;
+
+	OutStats.PeakMemoryGrowth = HighWaterMark.Stop();
+	OutStats.MemoryDelta = FCleanerMemoryHighWaterMark::GetTrackedMemory() - HighWaterMark.GetStartValue();
+}
+
+FName FProjectCleanerAnalysisStage::GetName() const
+{
+	return Name;
+}
+
+void FProjectCleanerAnalysisPipeline::AddStage(const FName Name, TFunction<int64()> Work)
+{
+	Stages.Emplace(Name, MoveTemp(Work));
+}
+
+void FProjectCleanerAnalysisPipeline::SkipStage(const FName Name)
+{
+	SkippedStages.Add(Name);
+}
+
+void FProjectCleanerAnalysisPipeline::Run(FCleanerAnalysisReport& OutReport) const
+{
+	Begin(OutReport);
+
+	for (int32 Index = 0; Index < Stages.Num(); ++Index)
+	{
+		RunStage(Index, OutReport);
+	}
+
+	End(OutReport);
+}
+
+void FProjectCleanerAnalysisPipeline::Begin(FCleanerAnalysisReport& OutReport) const
+{
+	OutReport = FCleanerAnalysisReport{};
+	OutReport.StartTime = FDateTime::Now();
+	OutReport.Stages.Reserve(Stages.Num());
+	OutReport.SkippedStages = SkippedStages;
+}
+
+void FProjectCleanerAnalysisPipeline::RunStage(const int32 Index, FCleanerAnalysisReport& OutReport) const
+{
+	FCleanerStageStats& StageStats = OutReport.Stages.AddDefaulted_GetRef();
+	Stages[Index].Run(StageStats);
+
+	OutReport.TotalWallTime += StageStats.WallTime;
+	OutReport.TotalCpuTime += StageStats.CpuTime;
+}
+
+void FProjectCleanerAnalysisPipeline::End(FCleanerAnalysisReport& OutReport) const
+{
+	OutReport.PeakUsedMemory = FPlatformMemory::GetStats().PeakUsedPhysical;
+}
+
+int32 FProjectCleanerAnalysisPipeline::GetStagesNum() const
+{
+	return Stages.Num();
+}
+
+FName FProjectCleanerAnalysisPipeline::GetStageName(const int32 Index) const
+{
+	return Stages[Index].GetName();
+}
+
+void FProjectCleanerAnalysisPipeline::PrintReport(const FCleanerAnalysisReport& Report)
+{
+	UE_LOG(LogProjectCleaner, Display, TEXT("Analysis took %.3f s (CPU %.3f s), process peak memory %s"),
+		Report.TotalWallTime,
+		Report.TotalCpuTime,
+		*FText::AsMemory(Report.PeakUsedMemory).ToString()
+	);
+
+	for (const auto& Stage : Report.Stages)
+	{
+		UE_LOG(LogProjectCleaner, Display, TEXT("	%-28s %9.3f s | CPU %9.3f s | Mem %+10lld KB | Peak +%lld KB | %lld items (%.0f/s)"),
+			*Stage.Name.ToString(),
+			Stage.WallTime,
+			Stage.CpuTime,
+			Stage.MemoryDelta / 1024,
+			Stage.PeakMemoryGrowth / 1024,
+			Stage.ItemsProcessed,
+			Stage.GetThroughput()
+		);
+	}
+
+	for (const auto& SkippedStage : Report.SkippedStages)
+	{
+		UE_LOG(LogProjectCleaner, Display, TEXT("	%-28s skipped (read only)"), *SkippedStage.ToString());
+	}
+}
+
+FString FProjectCleanerAnalysisPipeline::ReportToJson(const FCleanerAnalysisReport& Report)
+{
+	FString Json;
+	const TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&Json);
+
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("start_time"), Report.StartTime.ToIso8601());
+	Writer->WriteValue(TEXT("total_wall_time_sec"), Report.TotalWallTime);
+	Writer->WriteValue(TEXT("total_cpu_time_sec"), Report.TotalCpuTime);
+	Writer->WriteValue(TEXT("peak_used_memory_bytes"), Report.PeakUsedMemory);
+	Writer->WriteArrayStart(TEXT("stages"));
+	for (const auto& Stage : Report.Stages)
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), Stage.Name.ToString());
+		Writer->WriteValue(TEXT("wall_time_sec"), Stage.WallTime);
+		Writer->WriteValue(TEXT("cpu_time_sec"), Stage.CpuTime);
+		Writer->WriteValue(TEXT("memory_delta_bytes"), Stage.MemoryDelta);
+		Writer->WriteValue(TEXT("peak_memory_growth_bytes"), Stage.PeakMemoryGrowth);
+		Writer->WriteValue(TEXT("items_processed"), Stage.ItemsProcessed);
+		Writer->WriteValue(TEXT("items_per_sec"), Stage.GetThroughput());
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+	Writer->WriteArrayStart(TEXT("skipped_stages"));
+	for (const auto& SkippedStage : Report.SkippedStages)
+	{
+		Writer->WriteValue(SkippedStage.ToString());
+	}
+	Writer->WriteArrayEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	return Json;
+}
+
+bool FProjectCleanerAnalysisPipeline::SaveReport(const FCleanerAnalysisReport& Report, const FString& FilePath)
+{
+	if (!FFileHelper::SaveStringToFile(ReportToJson(Report), *FilePath))
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Failed to save analysis report to %s"), *FilePath);
+		return false;
+	}
+
+	return true;
+}
+
+FString FProjectCleanerAnalysisPipeline::GetDefaultReportPath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("ProjectCleaner") / TEXT("AnalysisReport.json");
+}
+
+double FProjectCleanerAnalysisPipeline::GetProcessCpuTime()
+{
+#if PLATFORM_WINDOWS
+	FILETIME CreationTime, ExitTime, KernelTime, UserTime;
+	if (!::GetProcessTimes(::GetCurrentProcess(), &CreationTime, &ExitTime, &KernelTime, &UserTime))
+	{
+		return 0.0;
+	}
+
+	// FILETIME is in 100 nanosecond units
+	const auto ToSeconds = [] (const FILETIME& Time)
+	{
+		return ((static_cast<uint64>(Time.dwHighDateTime) << 32) | Time.dwLowDateTime) * 1e-7;
+	};
+	return ToSeconds(KernelTime) + ToSeconds(UserTime);
+#elif PLATFORM_UNIX || PLATFORM_MAC
+	struct rusage Usage;
+	if (getrusage(RUSAGE_SELF, &Usage) != 0)
+	{
+		return 0.0;
+	}
+
+	return Usage.ru_utime.tv_sec + Usage.ru_utime.tv_usec * 1e-6 + Usage.ru_stime.tv_sec + Usage.ru_stime.tv_usec * 1e-6;
+#else
+	return 0.0;
+#endif
+}
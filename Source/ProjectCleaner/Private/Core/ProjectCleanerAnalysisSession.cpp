@@ -0,0 +1,220 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "Core/ProjectCleanerAnalysisSession.h"
+#include "ProjectCleaner.h"
+#include "Core/ProjectCleanerDataManager.h"
+// Engine Headers
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
+#include "Misc/Paths.h"
+
+TUniquePtr<FProjectCleanerAnalysisSession> FProjectCleanerAnalysisSession::Instance;
+
+FSHAHash FCleanerSessionConfigs::GetHash() const
+{
+	FSHA1 Sha;
+
+	const auto AddSorted = [&] (TArray<FString> Values)
+	{
+		Values.Sort();
+
+		const int32 Num = Values.Num();
+		Sha.Update(reinterpret_cast<const uint8*>(&Num), sizeof(Num));
+		for (const auto& Value : Values)
+		{
+			Sha.UpdateWithString(*Value, Value.Len() + 1);
+		}
+	};
+
+	AddSorted(ExcludedAssets);
+	AddSorted(ExcludedPaths);
+	AddSorted(ExcludedClasses);
+	Sha.Update(reinterpret_cast<const uint8*>(&bScanDeveloperContents), sizeof(bScanDeveloperContents));
+	Sha.Final();
+
+	FSHAHash Hash;
+	Sha.GetHash(Hash.Hash);
+	return Hash;
+}
+
+FProjectCleanerAnalysisSession& FProjectCleanerAnalysisSession::Get()
+{
+	if (!Instance.IsValid())
+	{
+		Instance.Reset(new FProjectCleanerAnalysisSession());
+	}
+
+	return *Instance;
+}
+
+void FProjectCleanerAnalysisSession::Shutdown()
+{
+	Instance.Reset();
+}
+
+FProjectCleanerAnalysisSession::FProjectCleanerAnalysisSession()
+{
+	RegisterWatchers();
+}
+
+FProjectCleanerAnalysisSession::~FProjectCleanerAnalysisSession()
+{
+	UnregisterWatchers();
+}
+
+const FProjectCleanerDataManager& FProjectCleanerAnalysisSession::GetAnalysis(const FCleanerSessionConfigs& Configs)
+{
+	if (const FProjectCleanerDataManager* Analysis = FindAnalysis(Configs))
+	{
+		return *Analysis;
+	}
+
+	const TSharedRef<FProjectCleanerDataManager> Analysis = StartAnalysis(Configs);
+	Analysis->AnalyzeProject();
+	FinishAnalysis(Analysis);
+
+	return *Analysis;
+}
+
+const FProjectCleanerDataManager* FProjectCleanerAnalysisSession::FindAnalysis(const FCleanerSessionConfigs& Configs) const
+{
+	if (bValid && DataManager.IsValid() && Configs.GetHash() == ConfigsHash)
+	{
+		return DataManager.Get();
+	}
+
+	return nullptr;
+}
+
+TSharedRef<FProjectCleanerDataManager> FProjectCleanerAnalysisSession::StartAnalysis(const FCleanerSessionConfigs& Configs)
+{
+	// exclude setters only add to existing configs, so every analysis starts from fresh data manager
+	const TSharedRef<FProjectCleanerDataManager> Analysis = MakeShared<FProjectCleanerDataManager>();
+	Analysis->SetSilentMode(true);
+	Analysis->SetReadOnly(true);
+	Analysis->SetUserExcludedAssets(Configs.ExcludedAssets);
+	Analysis->SetExcludePaths(Configs.ExcludedPaths);
+	Analysis->SetExcludeClasses(Configs.ExcludedClasses);
+	Analysis->SetScanDeveloperContents(Configs.bScanDeveloperContents);
+
+	DataManager = Analysis;
+	ConfigsHash = Configs.GetHash();
+	bValid = false;
+	AnalysisGeneration = ProjectGeneration;
+	// 0 is reserved for callers that have no analysis yet
+	AnalysisToken = AnalysisToken == MAX_int32 ? 1 : AnalysisToken + 1;
+
+	return Analysis;
+}
+
+void FProjectCleanerAnalysisSession::FinishAnalysis(const TSharedRef<FProjectCleanerDataManager>& Analysis)
+{
+	// nothing was analyzed while registry is still scanning, next query must try again
+	bValid =
+		DataManager.Get() == &Analysis.Get() &&
+		AnalysisGeneration == ProjectGeneration &&
+		!Analysis->IsLoadingAssets() &&
+		!Analysis->IsAnalysisRunning();
+}
+
+void FProjectCleanerAnalysisSession::Invalidate()
+{
+	bValid = false;
+	++ProjectGeneration;
+}
+
+bool FProjectCleanerAnalysisSession::IsValid() const
+{
+	return bValid;
+}
+
+int32 FProjectCleanerAnalysisSession::GetAnalysisToken() const
+{
+	return AnalysisToken;
+}
+
+void FProjectCleanerAnalysisSession::RegisterWatchers()
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+	OnAssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FProjectCleanerAnalysisSession::OnAssetChanged);
+	OnAssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FProjectCleanerAnalysisSession::OnAssetChanged);
+	OnAssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FProjectCleanerAnalysisSession::OnAssetRenamed);
+	OnPathAddedHandle = AssetRegistry.OnPathAdded().AddRaw(this, &FProjectCleanerAnalysisSession::OnPathChanged);
+	OnPathRemovedHandle = AssetRegistry.OnPathRemoved().AddRaw(this, &FProjectCleanerAnalysisSession::OnPathChanged);
+
+	// saved packages, non engine files and indirect references in code and configs are only visible on disk
+	IDirectoryWatcher* DirectoryWatcher = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")).Get();
+	if (!DirectoryWatcher) return;
+
+	const TArray<FString> Directories{
+		FPaths::ProjectContentDir(),
+		FPaths::ProjectConfigDir(),
+		FPaths::GameSourceDir(),
+		FPaths::ProjectPluginsDir(),
+	};
+
+	for (const auto& Directory : Directories)
+	{
+		const FString FullPath = FPaths::ConvertRelativePathToFull(Directory);
+		if (!FPaths::DirectoryExists(FullPath)) continue;
+
+		FDelegateHandle Handle;
+		DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(
+			FullPath,
+			IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FProjectCleanerAnalysisSession::OnDirectoryChanged),
+			Handle,
+			IDirectoryWatcher::WatchOptions::IncludeDirectoryChanges
+		);
+		DirectoryWatcherHandles.Emplace(FullPath, Handle);
+	}
+}
+
+void FProjectCleanerAnalysisSession::UnregisterWatchers()
+{
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(AssetRegistryConstants::ModuleName))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().Remove(OnAssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(OnAssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(OnAssetRenamedHandle);
+		AssetRegistry.OnPathAdded().Remove(OnPathAddedHandle);
+		AssetRegistry.OnPathRemoved().Remove(OnPathRemovedHandle);
+	}
+
+	if (FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+	{
+		if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule->Get())
+		{
+			for (const auto& WatcherHandle : DirectoryWatcherHandles)
+			{
+				DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(WatcherHandle.Key, WatcherHandle.Value);
+			}
+		}
+	}
+
+	DirectoryWatcherHandles.Reset();
+}
+
+void FProjectCleanerAnalysisSession::OnAssetChanged(const FAssetData& AssetData)
+{
+	Invalidate();
+}
+
+void FProjectCleanerAnalysisSession::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	OnAssetChanged(AssetData);
+}
+
+void FProjectCleanerAnalysisSession::OnPathChanged(const FString& Path)
+{
+	Invalidate();
+}
+
+void FProjectCleanerAnalysisSession::OnDirectoryChanged(const TArray<FFileChangeData>& FileChanges)
+{
+	if (FileChanges.Num() > 0)
+	{
+		Invalidate();
+	}
+}
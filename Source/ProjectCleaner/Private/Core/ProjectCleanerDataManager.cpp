@@ -3,8 +3,17 @@
 #include "Core/ProjectCleanerDataManager.h"
 #include "ProjectCleaner.h"
 #include "Core/ProjectCleanerUtility.h"
+#include "Core/ProjectCleanerAnalysisPipeline.h"
+#include "ProjectCleanerAnalysisCore.h"
+#include "ProjectCleanerReportWriter.h"
+#include "Core/ProjectCleanerRedirectorFixup.h"
+#include "Core/ProjectCleanerPackageHeaderReader.h"
+#include "Core/ProjectCleanerPackageValidator.h"
+#include "Core/ProjectCleanerDuplicateFinder.h"
+#include "Core/ProjectCleanerStats.h"
 // Engine Headers
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
 #include "AssetToolsModule.h"
 #include "AssetViewUtils.h"
 #include "ObjectTools.h"
@@ -13,22 +22,35 @@
 #include "Engine/AssetManagerSettings.h"
 #include "Engine/MapBuildDataRegistry.h"
 #include "Misc/Paths.h"
+#include "Misc/PackageName.h"
+#include "UObject/ObjectRedirector.h"
 #include "Misc/FileHelper.h"
 #include "Misc/ScopedSlowTask.h"
 #include "GenericPlatform/GenericPlatformFile.h"
 #include "HAL/PlatformFilemanager.h"
-#include "Internationalization/Regex.h"
+#include "HAL/FileManager.h"
 #include "Settings/ContentBrowserSettings.h"
+#include "FileHelpers.h"
 
 FProjectCleanerDataManager::FProjectCleanerDataManager() :
+	TotalProjectSize(0),
+	TotalUnusedSize(0),
+	OrphanedFilesSize(0),
+	NextAnalysisStage(0),
 	bSilentMode(false),
+	bReadOnly(false),
+	bReadPackageHeaders(false),
+	bValidatePackages(false),
+	bFindDuplicates(false),
+	bRegistryFromFile(false),
 	bScanDeveloperContents(false),
 	bAutomaticallyDeleteEmptyFolders(true),
 	bCancelledByUser(false),
 	AssetRegistry(nullptr),
 	AssetTools(nullptr),
 	PlatformFile(nullptr),
-	RelativeRoot(TEXT("/Game"))
+	RelativeRoot(TEXT("/Game")),
+	BiggestWinsNum(20)
 {
 	AssetRegistry = &FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName);
 	AssetTools = &FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
@@ -46,17 +68,179 @@ FProjectCleanerDataManager::~FProjectCleanerDataManager()
 
 void FProjectCleanerDataManager::AnalyzeProject()
 {
-	if (IsLoadingAssets()) return;
-	
-	FixupRedirectors();
-	ProjectCleanerUtility::SaveAllAssets(!bSilentMode);
-	FindAllAssets();
-	FindInvalidFilesAndAssets();
-	FindIndirectAssets();
-	FindEmptyFolders(bScanDeveloperContents);
-	FindPrimaryAssetClasses();
-	FindAssetsWithExternalReferencers();
-	FindUnusedAssets();
+	LLM_SCOPE_BYTAG(ProjectCleaner);
+	PROJECTCLEANER_SCOPE(AnalyzeProject);
+
+	if (!BeginAnalysis()) return;
+
+	while (RunNextAnalysisStage())
+	{
+	}
+
+	FinishAnalysis();
+}
+
+bool FProjectCleanerDataManager::BeginAnalysis()
+{
+	if (IsLoadingAssets()) return false;
+
+	PROJECTCLEANER_COUNTER_RESET(FilesVisited);
+	PROJECTCLEANER_COUNTER_RESET(RegistryQueries);
+	PROJECTCLEANER_COUNTER_RESET(DependencyEdges);
+	PROJECTCLEANER_BYTES_COUNTER_RESET(BytesScanned);
+
+	ActivePipeline = MakeUnique<FProjectCleanerAnalysisPipeline>();
+	NextAnalysisStage = 0;
+	BuildAnalysisPipeline(*ActivePipeline);
+	ActivePipeline->Begin(AnalysisReport);
+
+	return true;
+}
+
+bool FProjectCleanerDataManager::RunNextAnalysisStage()
+{
+	LLM_SCOPE_BYTAG(ProjectCleaner);
+
+	if (!ActivePipeline.IsValid() || NextAnalysisStage >= ActivePipeline->GetStagesNum()) return false;
+
+	ActivePipeline->RunStage(NextAnalysisStage++, AnalysisReport);
+
+	return NextAnalysisStage < ActivePipeline->GetStagesNum();
+}
+
+void FProjectCleanerDataManager::FinishAnalysis()
+{
+	if (!ActivePipeline.IsValid()) return;
+
+	ActivePipeline->End(AnalysisReport);
+	ActivePipeline.Reset();
+
+	// concurrent read only runs would all write same file
+	if (!bReadOnly)
+	{
+		FProjectCleanerAnalysisPipeline::SaveReport(AnalysisReport, FProjectCleanerAnalysisPipeline::GetDefaultReportPath());
+	}
+}
+
+void FProjectCleanerDataManager::CancelAnalysis()
+{
+	ActivePipeline.Reset();
+}
+
+bool FProjectCleanerDataManager::IsAnalysisRunning() const
+{
+	return ActivePipeline.IsValid();
+}
+
+float FProjectCleanerDataManager::GetAnalysisProgress() const
+{
+	if (!ActivePipeline.IsValid() || ActivePipeline->GetStagesNum() == 0) return 0.0f;
+
+	return static_cast<float>(NextAnalysisStage) / ActivePipeline->GetStagesNum();
+}
+
+FName FProjectCleanerDataManager::GetNextAnalysisStageName() const
+{
+	if (!ActivePipeline.IsValid() || NextAnalysisStage >= ActivePipeline->GetStagesNum()) return NAME_None;
+
+	return ActivePipeline->GetStageName(NextAnalysisStage);
+}
+
+void FProjectCleanerDataManager::BuildAnalysisPipeline(FProjectCleanerAnalysisPipeline& Pipeline)
+{
+	if (bReadOnly)
+	{
+		// redirectors stay in registry, dependency walk passes through them to their destinations
+		Pipeline.SkipStage(TEXT("FixupRedirectors"));
+		Pipeline.SkipStage(TEXT("SaveAllAssets"));
+	}
+	else
+	{
+		Pipeline.AddStage(TEXT("FixupRedirectors"), [this] ()
+		{
+			return FixupRedirectors();
+		});
+		Pipeline.AddStage(TEXT("SaveAllAssets"), [this] ()
+		{
+			TArray<UPackage*> DirtyPackages;
+			FEditorFileUtils::GetDirtyContentPackages(DirtyPackages);
+			ProjectCleanerUtility::SaveAllAssets(!bSilentMode);
+			return DirtyPackages.Num();
+		});
+	}
+	Pipeline.AddStage(TEXT("FindAllAssets"), [this] ()
+	{
+		FindAllAssets();
+		return AllAssets.Num();
+	});
+	Pipeline.AddStage(TEXT("FindInvalidFilesAndAssets"), [this] ()
+	{
+		return FindInvalidFilesAndAssets();
+	});
+	// after invalid files search, which expects redirector files to be known assets
+	Pipeline.AddStage(TEXT("ResolveRedirectors"), [this] ()
+	{
+		return ResolveRedirectors();
+	});
+	Pipeline.AddStage(TEXT("FindIndirectAssets"), [this] ()
+	{
+		return FindIndirectAssets();
+	});
+	Pipeline.AddStage(TEXT("FindEmptyFolders"), [this] ()
+	{
+		FindEmptyFolders(bScanDeveloperContents);
+		return EmptyFolders.Num();
+	});
+	Pipeline.AddStage(TEXT("FindPrimaryAssetClasses"), [this] ()
+	{
+		FindPrimaryAssetClasses();
+		return PrimaryAssetClasses.Num();
+	});
+	Pipeline.AddStage(TEXT("FindAssetsWithExternalRefs"), [this] ()
+	{
+		FindAssetsWithExternalReferencers();
+		return AllAssets.Num();
+	});
+	// reachability and classification are separate stages, so each of them can be measured and budgeted alone
+	// sets passed between them are owned by stages, so they are freed together with pipeline
+	const TSharedRef<TSet<FName>> UsedAssets = MakeShared<TSet<FName>>();
+	const TSharedRef<TSet<FName>> UsedAssetsDependencies = MakeShared<TSet<FName>>();
+	Pipeline.AddStage(TEXT("FindUsedAssets"), [this, UsedAssets] ()
+	{
+		ExcludedAssets.Empty();
+		ExcludedAssets.Reserve(AllAssets.Num());
+		UsedAssets->Reserve(AllAssets.Num());
+		FindUsedAssets(*UsedAssets);
+		FindExcludedAssets(*UsedAssets);
+		return UsedAssets->Num();
+	});
+	Pipeline.AddStage(TEXT("BuildDependencyGraph"), [this] ()
+	{
+		return BuildDependencyGraph();
+	});
+	Pipeline.AddStage(TEXT("FindUsedAssetsDependencies"), [this, UsedAssets, UsedAssetsDependencies] ()
+	{
+		UsedAssetsDependencies->Reserve(AllAssets.Num());
+		FindUsedAssetsDependencies(*UsedAssets, *UsedAssetsDependencies);
+		return UsedAssetsDependencies->Num();
+	});
+	Pipeline.AddStage(TEXT("ClassifyAssets"), [this, UsedAssetsDependencies] ()
+	{
+		ClassifyAssets(*UsedAssetsDependencies);
+		return AllAssets.Num();
+	});
+	if (bFindDuplicates)
+	{
+		Pipeline.AddStage(TEXT("FindDuplicateAssets"), [this] ()
+		{
+			return FindDuplicateAssets();
+		});
+	}
+	else
+	{
+		DuplicateGroups.Reset();
+		Pipeline.SkipStage(TEXT("FindDuplicateAssets"));
+	}
 }
 
 void FProjectCleanerDataManager::PrintInfo()
@@ -65,9 +249,29 @@ void FProjectCleanerDataManager::PrintInfo()
 	UE_LOG(LogProjectCleaner, Display, TEXT("Unused Assets - %d"), UnusedAssets.Num());
 	UE_LOG(LogProjectCleaner, Display, TEXT("Corrupted Assets - %d"), CorruptedAssets.Num());
 	UE_LOG(LogProjectCleaner, Display, TEXT("Non Engine Files - %d"), NonEngineFiles.Num());
+	UE_LOG(LogProjectCleaner, Display, TEXT("Orphaned Files - %d (%lld bytes)"), OrphanedFiles.Num(), OrphanedFilesSize);
 	UE_LOG(LogProjectCleaner, Display, TEXT("IndirectAssets - %d"), IndirectAssets.Num());
 	UE_LOG(LogProjectCleaner, Display, TEXT("Empty Folders - %d"), EmptyFolders.Num());
 	UE_LOG(LogProjectCleaner, Display, TEXT("Excluded Assets - %d"), ExcludedAssets.Num());
+	UE_LOG(LogProjectCleaner, Display, TEXT("Redirectors - %d"), Redirectors.Num());
+	UE_LOG(LogProjectCleaner, Display, TEXT("Duplicate Groups - %d"), DuplicateGroups.Num());
+
+	const auto PrintBiggestWins = [] (const TCHAR* Title, const FCleanerTopK& TopK)
+	{
+		TArray<FCleanerTopK::FEntry> Entries;
+		TopK.GetSorted(Entries);
+		if (Entries.Num() == 0) return;
+
+		UE_LOG(LogProjectCleaner, Display, TEXT("Biggest %s:"), Title);
+		for (const auto& Entry : Entries)
+		{
+			UE_LOG(LogProjectCleaner, Display, TEXT("	%s - %lld bytes"), *Entry.Name.ToString(), Entry.Size);
+		}
+	};
+	PrintBiggestWins(TEXT("Unused Assets"), BiggestUnusedAssets);
+	PrintBiggestWins(TEXT("Non Engine Files"), BiggestNonEngineFiles);
+	PrintBiggestWins(TEXT("Unused Folders"), BiggestUnusedFolders);
+	FProjectCleanerAnalysisPipeline::PrintReport(AnalysisReport);
 }
 
 void FProjectCleanerDataManager::SetExcludeClasses(const TArray<FString>& Classes)
@@ -84,6 +288,8 @@ void FProjectCleanerDataManager::SetExcludePaths(const TArray<FString>& Paths)
 	{
 		ExcludedPaths.Add(FName{*Path});
 	}
+
+	RebuildExcludedPathsTrie();
 }
 
 void FProjectCleanerDataManager::SetUserExcludedAssets(const TArray<FString>& Assets)
@@ -91,12 +297,177 @@ void FProjectCleanerDataManager::SetUserExcludedAssets(const TArray<FString>& As
 	for (const auto& Asset : Assets)
 	{
 		const FAssetData AssetData = AssetRegistry->Get().GetAssetByObjectPath(FName{*Asset});
+		PROJECTCLEANER_COUNTER_ADD(RegistryQueries, 1);
 		if (!AssetData.IsValid()) continue;
 		
 		UserExcludedAssets.AddUnique(AssetData);
 	}
 }
 
+void FProjectCleanerDataManager::WriteReport(FProjectCleanerReportWriter& Writer) const
+{
+	PROJECTCLEANER_SCOPE(WriteReport);
+
+	// rows are written straight from analysis containers, nothing is copied
+	Writer.BeginCategory(TEXT("unused"));
+	for (const auto& Asset : UnusedAssets)
+	{
+		Writer.BeginRow();
+		Writer.AddString(TEXT("path"), Asset.ObjectPath.ToString());
+		Writer.AddString(TEXT("class"), ProjectCleanerUtility::GetClassName(Asset).ToString());
+		Writer.AddInteger(TEXT("size_bytes"), GetPackageSize(Asset.PackageName));
+		Writer.EndRow();
+	}
+	Writer.EndCategory();
+
+	Writer.BeginCategory(TEXT("excluded"));
+	for (const auto& Package : ExcludedAssets)
+	{
+		Writer.BeginRow();
+		Writer.AddString(TEXT("path"), Package.ToString());
+		Writer.AddInteger(TEXT("size_bytes"), GetPackageSize(Package));
+		Writer.EndRow();
+	}
+	Writer.EndCategory();
+
+	Writer.BeginCategory(TEXT("indirect"));
+	for (const auto& IndirectAsset : IndirectAssets)
+	{
+		Writer.BeginRow();
+		Writer.AddString(TEXT("path"), IndirectAsset.Key.ObjectPath.ToString());
+		Writer.AddString(TEXT("class"), ProjectCleanerUtility::GetClassName(IndirectAsset.Key).ToString());
+		Writer.AddString(TEXT("file"), IndirectAsset.Value.File);
+		Writer.AddInteger(TEXT("line"), IndirectAsset.Value.Line);
+		Writer.EndRow();
+	}
+	Writer.EndCategory();
+
+	Writer.BeginCategory(TEXT("redirectors"));
+	for (const auto& Redirector : Redirectors)
+	{
+		const FName* Destination = RedirectorDestinations.Find(Redirector.PackageName);
+		Writer.BeginRow();
+		Writer.AddString(TEXT("path"), Redirector.ObjectPath.ToString());
+		Writer.AddString(TEXT("destination"), Destination ? Destination->ToString() : FString{});
+		Writer.EndRow();
+	}
+	Writer.EndCategory();
+
+	Writer.BeginCategory(TEXT("duplicates"));
+	for (int32 GroupIndex = 0; GroupIndex < DuplicateGroups.Num(); ++GroupIndex)
+	{
+		const FCleanerDuplicateGroup& Group = DuplicateGroups[GroupIndex];
+		for (const auto& Asset : Group.Assets)
+		{
+			Writer.BeginRow();
+			Writer.AddInteger(TEXT("group"), GroupIndex);
+			Writer.AddNumber(TEXT("similarity"), Group.Similarity);
+			Writer.AddString(TEXT("path"), Asset.ObjectPath.ToString());
+			Writer.AddString(TEXT("class"), Group.AssetClass.ToString());
+			Writer.AddInteger(TEXT("size_bytes"), GetPackageSize(Asset.PackageName));
+			Writer.EndRow();
+		}
+	}
+	Writer.EndCategory();
+
+	const auto WriteBiggestWins = [&] (const TCHAR* Category, const FCleanerTopK& TopK)
+	{
+		TArray<FCleanerTopK::FEntry> Entries;
+		TopK.GetSorted(Entries);
+
+		Writer.BeginCategory(Category);
+		for (const auto& Entry : Entries)
+		{
+			Writer.BeginRow();
+			Writer.AddString(TEXT("path"), Entry.Name.ToString());
+			Writer.AddInteger(TEXT("size_bytes"), Entry.Size);
+			Writer.EndRow();
+		}
+		Writer.EndCategory();
+	};
+	WriteBiggestWins(TEXT("biggest_unused_assets"), BiggestUnusedAssets);
+	WriteBiggestWins(TEXT("biggest_non_engine_files"), BiggestNonEngineFiles);
+	WriteBiggestWins(TEXT("biggest_unused_folders"), BiggestUnusedFolders);
+
+	Writer.BeginCategory(TEXT("corrupted"));
+	for (const auto& CorruptedAsset : CorruptedAssets)
+	{
+		Writer.BeginRow();
+		Writer.AddString(TEXT("path"), CorruptedAsset.ToString());
+		Writer.EndRow();
+	}
+	Writer.EndCategory();
+
+	Writer.BeginCategory(TEXT("non_engine"));
+	for (const auto& NonEngineFile : NonEngineFiles)
+	{
+		Writer.BeginRow();
+		Writer.AddString(TEXT("path"), NonEngineFile.ToString());
+		Writer.AddInteger(TEXT("size_bytes"), LooseFileSizes.FindRef(NonEngineFile));
+		Writer.EndRow();
+	}
+	Writer.EndCategory();
+
+	Writer.BeginCategory(TEXT("orphaned"));
+	for (const auto& OrphanedFile : OrphanedFiles)
+	{
+		Writer.BeginRow();
+		Writer.AddString(TEXT("path"), OrphanedFile.ToString());
+		Writer.AddInteger(TEXT("size_bytes"), LooseFileSizes.FindRef(OrphanedFile));
+		Writer.EndRow();
+	}
+	Writer.EndCategory();
+
+	Writer.BeginCategory(TEXT("empty_folders"));
+	for (const auto& EmptyFolder : EmptyFolders)
+	{
+		Writer.BeginRow();
+		Writer.AddString(TEXT("path"), EmptyFolder.ToString());
+		Writer.EndRow();
+	}
+	Writer.EndCategory();
+
+	const auto WriteAggregateStats = [&] (const TCHAR* Category, const TCHAR* KeyColumn, const TMap<FName, FCleanerAggregateStats>& Stats)
+	{
+		Writer.BeginCategory(Category);
+		for (const auto& Stat : Stats)
+		{
+			Writer.BeginRow();
+			Writer.AddString(KeyColumn, Stat.Value.Name.ToString());
+			Writer.AddInteger(TEXT("assets"), Stat.Value.AssetsNum);
+			Writer.AddInteger(TEXT("unused_assets"), Stat.Value.UnusedAssetsNum);
+			Writer.AddInteger(TEXT("size_bytes"), Stat.Value.TotalSize);
+			Writer.AddInteger(TEXT("unused_size_bytes"), Stat.Value.UnusedSize);
+			Writer.EndRow();
+		}
+		Writer.EndCategory();
+	};
+	WriteAggregateStats(TEXT("folder_sizes"), TEXT("path"), FolderStats);
+	WriteAggregateStats(TEXT("class_sizes"), TEXT("class"), ClassStats);
+
+	Writer.BeginCategory(TEXT("skipped_stages"));
+	for (const auto& SkippedStage : AnalysisReport.SkippedStages)
+	{
+		Writer.BeginRow();
+		Writer.AddString(TEXT("name"), SkippedStage.ToString());
+		Writer.EndRow();
+	}
+	Writer.EndCategory();
+
+	Writer.BeginCategory(TEXT("stages"));
+	for (const auto& Stage : AnalysisReport.Stages)
+	{
+		Writer.BeginRow();
+		Writer.AddString(TEXT("name"), Stage.Name.ToString());
+		Writer.AddNumber(TEXT("wall_time_sec"), Stage.WallTime);
+		Writer.AddNumber(TEXT("cpu_time_sec"), Stage.CpuTime);
+		Writer.AddInteger(TEXT("memory_delta_bytes"), Stage.MemoryDelta);
+		Writer.AddInteger(TEXT("items"), Stage.ItemsProcessed);
+		Writer.EndRow();
+	}
+	Writer.EndCategory();
+}
+
 void FProjectCleanerDataManager::ExcludeSelectedAssets(const TArray<FAssetData>& Assets)
 {
 	if (Assets.Num() == 0) return;
@@ -153,6 +524,7 @@ void FProjectCleanerDataManager::IncludeAllAssets()
 	ExcludedClasses.Empty();
 	UserExcludedAssets.Empty();
 	ExcludedAssets.Empty();
+	RebuildExcludedPathsTrie();
 }
 
 bool FProjectCleanerDataManager::ExcludePath(const FString& InPath)
@@ -160,6 +532,7 @@ bool FProjectCleanerDataManager::ExcludePath(const FString& InPath)
 	if (InPath.IsEmpty()) return false;
 	
 	ExcludedPaths.Add(FName{*InPath});
+	RebuildExcludedPathsTrie();
 
 	return true;
 }
@@ -179,51 +552,63 @@ bool FProjectCleanerDataManager::IncludePath(const FString& InPath)
 	}
 	
 	ExcludedPaths.Remove(FName{*InPath});
+	RebuildExcludedPathsTrie();
 
 	return true;
 }
 
 int32 FProjectCleanerDataManager::DeleteSelectedAssets(const TArray<FAssetData>& Assets)
 {
+	if (bReadOnly)
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Read only mode, assets are not deleted"));
+		return 0;
+	}
+
 	return ObjectTools::DeleteAssets(Assets);
 }
 
 int32 FProjectCleanerDataManager::DeleteAllUnusedAssets()
 {
+	LLM_SCOPE_BYTAG(ProjectCleaner);
+	PROJECTCLEANER_SCOPE(DeleteAllUnusedAssets);
+
+	if (bReadOnly)
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Read only mode, assets are not deleted"));
+		return 0;
+	}
+
 	if (bCancelledByUser)
 	{
 		AnalyzeProject();
 	}
 	
-	constexpr int32 BucketSize = 500;
 	int32 DeletedAssetNum = 0;
 	const int32 Total = UnusedAssets.Num();
+
+	TArray<TArray<FAssetData>> PlannedBuckets;
+	PlanDeletion(DeletionBucketSize, PlannedBuckets);
 	
-	TArray<FAssetData> Bucket;
 	TArray<UObject*> LoadedAssets;
-	LoadedAssets.Reserve(BucketSize);
-	Bucket.Reserve(BucketSize);
+	LoadedAssets.Reserve(DeletionBucketSize);
 
 	FScopedSlowTask DeleteSlowTask(
 		UnusedAssets.Num(),
 		FText::FromString(FStandardCleanerText::DeletingUnusedAssets)
 	);
 	DeleteSlowTask.MakeDialog(true);
+
+	PROJECTCLEANER_COUNTER_RESET(AssetsDeleted);
+	const double DeletionStartTime = FPlatformTime::Seconds();
 	
-	while (UnusedAssets.Num() > 0)
+	for (const auto& Bucket : PlannedBuckets)
 	{
 		if (DeleteSlowTask.ShouldCancel())
 		{
 			bCancelledByUser = true;
 			break;
 		}
-		
-		FillBucketWithAssets(Bucket,BucketSize);
-
-		if (Bucket.Num() == 0)
-		{
-			break;
-		}
 
 		if (!PrepareBucketForDeletion(Bucket, LoadedAssets))
 		{
@@ -231,13 +616,20 @@ int32 FProjectCleanerDataManager::DeleteAllUnusedAssets()
 			break;
 		}
 
-		DeletedAssetNum += DeleteBucket(LoadedAssets);
+		const int32 DeletedInBucketNum = DeleteBucket(LoadedAssets);
+		DeletedAssetNum += DeletedInBucketNum;
+		PROJECTCLEANER_COUNTER_ADD(AssetsDeleted, DeletedInBucketNum);
+
+		const double DeletionTime = FPlatformTime::Seconds() - DeletionStartTime;
+		const float DeletedPerSecond = DeletionTime > 0.0 ? DeletedAssetNum / DeletionTime : 0.0f;
+		SET_FLOAT_STAT(STAT_ProjectCleaner_AssetsDeletedPerSecond, DeletedPerSecond);
+		TRACE_COUNTER_SET(ProjectCleaner_AssetsDeletedPerSecond, DeletedPerSecond);
+
 		DeleteSlowTask.EnterProgressFrame(
 			Bucket.Num(),
 			ProjectCleanerUtility::GetDeletionProgressText(DeletedAssetNum, Total, false)
 		);
 
-		Bucket.Reset();
 		LoadedAssets.Reset();
 	}
 	
@@ -263,8 +655,62 @@ int32 FProjectCleanerDataManager::DeleteAllUnusedAssets()
 	return DeletedAssetNum;
 }
 
+int32 FProjectCleanerDataManager::PlanDeletion(const int32 BucketSize, TArray<TArray<FAssetData>>& OutBuckets) const
+{
+	LLM_SCOPE_BYTAG(ProjectCleaner);
+	PROJECTCLEANER_SCOPE(PlanDeletion);
+
+	OutBuckets.Reset();
+
+	// assets of every package as linked list over UnusedAssets indices
+	TBitArray<> Deletable{false, GraphPackages.Num()};
+	TArray<int32> FirstAssetOfPackage;
+	TArray<int32> NextAssetOfPackage;
+	FirstAssetOfPackage.Init(INDEX_NONE, GraphPackages.Num());
+	NextAssetOfPackage.Init(INDEX_NONE, UnusedAssets.Num());
+	for (int32 i = 0; i < UnusedAssets.Num(); ++i)
+	{
+		const int32* Node = GraphPackageIndices.Find(UnusedAssets[i].PackageName);
+		if (!Node) continue;
+
+		Deletable[*Node] = true;
+		NextAssetOfPackage[i] = FirstAssetOfPackage[*Node];
+		FirstAssetOfPackage[*Node] = i;
+	}
+
+	TArray<TArray<int32>> PlannedBuckets;
+	FCleanerDeletionPlanner::Plan(DependencyGraph, Deletable, BucketSize, PlannedBuckets);
+
+	int32 PlannedAssetsNum = 0;
+	OutBuckets.Reserve(PlannedBuckets.Num());
+	for (const auto& PlannedBucket : PlannedBuckets)
+	{
+		TArray<FAssetData>& Bucket = OutBuckets.AddDefaulted_GetRef();
+		for (const int32 Node : PlannedBucket)
+		{
+			for (int32 i = FirstAssetOfPackage[Node]; i != INDEX_NONE; i = NextAssetOfPackage[i])
+			{
+				Bucket.Add(UnusedAssets[i]);
+			}
+		}
+
+		PlannedAssetsNum += Bucket.Num();
+	}
+
+	return PlannedAssetsNum;
+}
+
 int32 FProjectCleanerDataManager::DeleteEmptyFolders()
 {
+	LLM_SCOPE_BYTAG(ProjectCleaner);
+	PROJECTCLEANER_SCOPE(DeleteEmptyFolders);
+
+	if (bReadOnly)
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Read only mode, empty folders are not deleted"));
+		return 0;
+	}
+
 	FindEmptyFolders(bScanDeveloperContents);
 	
 	if (EmptyFolders.Num() == 0)
@@ -319,6 +765,21 @@ const TArray<FAssetData>& FProjectCleanerDataManager::GetUnusedAssets() const
 	return UnusedAssets;
 }
 
+const TSet<FName>& FProjectCleanerDataManager::GetUnusedPackages() const
+{
+	return UnusedPackages;
+}
+
+int64 FProjectCleanerDataManager::GetTotalProjectSize() const
+{
+	return TotalProjectSize;
+}
+
+int64 FProjectCleanerDataManager::GetTotalUnusedSize() const
+{
+	return TotalUnusedSize;
+}
+
 const TSet<FName>& FProjectCleanerDataManager::GetExcludedAssets() const
 {
 	return ExcludedAssets;
@@ -334,11 +795,66 @@ const TSet<FName>& FProjectCleanerDataManager::GetNonEngineFiles() const
 	return NonEngineFiles;
 }
 
+const TSet<FName>& FProjectCleanerDataManager::GetOrphanedFiles() const
+{
+	return OrphanedFiles;
+}
+
+int64 FProjectCleanerDataManager::GetOrphanedFilesSize() const
+{
+	return OrphanedFilesSize;
+}
+
 const TMap<FAssetData, FIndirectAsset>& FProjectCleanerDataManager::GetIndirectAssets() const
 {
 	return IndirectAssets;
 }
 
+const TArray<FAssetData>& FProjectCleanerDataManager::GetIndirectAssetsList() const
+{
+	return IndirectAssetsList;
+}
+
+const TArray<FAssetData>& FProjectCleanerDataManager::GetRedirectors() const
+{
+	return Redirectors;
+}
+
+const TArray<FCleanerDuplicateGroup>& FProjectCleanerDataManager::GetDuplicateGroups() const
+{
+	return DuplicateGroups;
+}
+
+const FCleanerTopK& FProjectCleanerDataManager::GetBiggestUnusedAssets() const
+{
+	return BiggestUnusedAssets;
+}
+
+const FCleanerTopK& FProjectCleanerDataManager::GetBiggestNonEngineFiles() const
+{
+	return BiggestNonEngineFiles;
+}
+
+const FCleanerTopK& FProjectCleanerDataManager::GetBiggestUnusedFolders() const
+{
+	return BiggestUnusedFolders;
+}
+
+const TMap<FName, FCleanerAggregateStats>& FProjectCleanerDataManager::GetFolderStats() const
+{
+	return FolderStats;
+}
+
+const TMap<FName, FCleanerAggregateStats>& FProjectCleanerDataManager::GetClassStats() const
+{
+	return ClassStats;
+}
+
+const FCleanerAnalysisReport& FProjectCleanerDataManager::GetAnalysisReport() const
+{
+	return AnalysisReport;
+}
+
 const TSet<FName>& FProjectCleanerDataManager::GetEmptyFolders() const
 {
 	return EmptyFolders;
@@ -355,11 +871,16 @@ void FProjectCleanerDataManager::SetCleanerConfigs(const UCleanerConfigs* Cleane
 
 	bScanDeveloperContents = CleanerConfigs->bScanDeveloperContents;
 	
-	const auto Settings = GetMutableDefault<UContentBrowserSettings>();
-	Settings->SetDisplayDevelopersFolder(bScanDeveloperContents);
-	Settings->PostEditChange();
+	if (!bReadOnly)
+	{
+		const auto Settings = GetMutableDefault<UContentBrowserSettings>();
+		Settings->SetDisplayDevelopersFolder(bScanDeveloperContents);
+		Settings->PostEditChange();
+	}
 	
 	bAutomaticallyDeleteEmptyFolders = CleanerConfigs->bAutomaticallyDeleteEmptyFolders;
+	bValidatePackages = CleanerConfigs->bValidatePackages;
+	bFindDuplicates = CleanerConfigs->bFindDuplicates;
 
 	ExcludedPaths.Empty();
 	ExcludedClasses.Empty();
@@ -372,6 +893,7 @@ void FProjectCleanerDataManager::SetCleanerConfigs(const UCleanerConfigs* Cleane
 		
 		ExcludedPaths.Add(FName{*DirectoryPath.Path});
 	}
+	RebuildExcludedPathsTrie();
 	for (const auto& ExcludedClass : CleanerConfigs->Classes)
 	{
 		if (!ExcludedClass) continue;
@@ -389,85 +911,266 @@ void FProjectCleanerDataManager::SetScanDeveloperContents(const bool bScan)
 	bScanDeveloperContents = bScan;
 }
 
+void FProjectCleanerDataManager::SetReadOnly(const bool bInReadOnly)
+{
+	bReadOnly = bInReadOnly;
+}
+
+bool FProjectCleanerDataManager::IsReadOnly() const
+{
+	return bReadOnly;
+}
+
+void FProjectCleanerDataManager::SetReadPackageHeaders(const bool bInReadPackageHeaders)
+{
+	bReadPackageHeaders = bInReadPackageHeaders;
+}
+
+void FProjectCleanerDataManager::SetValidatePackages(const bool bInValidatePackages)
+{
+	bValidatePackages = bInValidatePackages;
+}
+
+void FProjectCleanerDataManager::SetFindDuplicates(const bool bInFindDuplicates)
+{
+	bFindDuplicates = bInFindDuplicates;
+}
+
+void FProjectCleanerDataManager::SetRegistryFromFile(const bool bInRegistryFromFile)
+{
+	bRegistryFromFile = bInRegistryFromFile;
+}
+
 // PRIVATE Functions
-void FProjectCleanerDataManager::FixupRedirectors() const
+int32 FProjectCleanerDataManager::FixupRedirectors() const
 {
-	FScopedSlowTask FixRedirectorsTask{
-		1.0f,
-		FText::FromString(FStandardCleanerText::FixingUpRedirectors)
-	};
-	FixRedirectorsTask.MakeDialog();
-	
-	FARFilter Filter;
-	Filter.bRecursivePaths = true;
-	Filter.PackagePaths.Emplace(RelativeRoot);
-	Filter.ClassNames.Emplace(UObjectRedirector::StaticClass()->GetFName());
+	PROJECTCLEANER_SCOPE(FixupRedirectors);
 
-	// Getting all redirectors in project
-	TArray<FAssetData> AssetList;
-	AssetRegistry->Get().GetAssets(Filter, AssetList);
-	
-	if (AssetList.Num() > 0)
+	const FProjectCleanerRedirectorFixup RedirectorFixup{RelativeRoot};
+	return RedirectorFixup.Run().RedirectorsNum;
+}
+
+void FProjectCleanerDataManager::FindAllAssets()
+{
+	PROJECTCLEANER_SCOPE(FindAllAssets);
+
+	PackageHeaders.Reset();
+	PackageHeaderIndices.Reset();
+
+	if (bReadPackageHeaders)
 	{
-		FScopedSlowTask FixRedirectorsLoadingTask(
-			AssetList.Num(),
-			FText::FromString(FStandardCleanerText::LoadingAssets)
-		);
-		FixRedirectorsLoadingTask.MakeDialog();
+		FindAllAssetsFromPackageHeaders();
+		return;
+	}
 
-		TArray<UObjectRedirector*> Redirectors;
-		Redirectors.Reserve(AssetList.Num());
-		
-		for (const auto& Asset : AssetList)
+	AllAssets.Empty();
+	AllAssets.Reserve(AssetRegistry->Get().GetAllocatedSize());
+	AssetRegistry->Get().GetAssetsByPath(RelativeRoot, AllAssets, true);
+	PROJECTCLEANER_COUNTER_ADD(RegistryQueries, 1);
+}
+
+void FProjectCleanerDataManager::FindAllAssetsFromPackageHeaders()
+{
+	const FString ContentDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir());
+
+	TArray<FString> PackageFiles;
+	IFileManager::Get().FindFilesRecursive(PackageFiles, *ContentDir, *(TEXT("*") + FPackageName::GetAssetPackageExtension()), true, false);
+	IFileManager::Get().FindFilesRecursive(PackageFiles, *ContentDir, *(TEXT("*") + FPackageName::GetMapPackageExtension()), true, false, false);
+	PROJECTCLEANER_COUNTER_ADD(FilesVisited, PackageFiles.Num());
+
+	const FProjectCleanerPackageHeaderReader HeaderReader;
+	HeaderReader.Read(PackageFiles, PackageHeaders);
+
+	AllAssets.Empty();
+	AllAssets.Reserve(PackageHeaders.Num());
+	PackageHeaderIndices.Reserve(PackageHeaders.Num());
+
+	// packages with unreadable header are not added, so file scan reports them as corrupted
+	for (int32 i = 0; i < PackageHeaders.Num(); ++i)
+	{
+		const FCleanerPackageHeader& Header = PackageHeaders[i];
+		if (!Header.bValid) continue;
+
+		PackageHeaderIndices.Add(Header.PackageName, i);
+
+		const FName PackagePath = FName{*FPackageName::GetLongPackagePath(Header.PackageName.ToString())};
+		for (const auto& Asset : Header.Assets)
 		{
-			FixRedirectorsLoadingTask.EnterProgressFrame();
-			
-			UObject* AssetObj = Asset.GetAsset();
-			if (!AssetObj) continue;
+			// same tags registry gathers for blueprints, class checks below work for both sources
+			FAssetDataTagMap Tags;
+			if (!Asset.GeneratedClass.IsNone())
+			{
+				Tags.Add(TEXT("GeneratedClass"), Asset.GeneratedClass.ToString());
+				Tags.Add(TEXT("ParentClass"), Asset.ParentClass.ToString());
+			}
+
+			AllAssets.Emplace(Header.PackageName, PackagePath, Asset.AssetName, Asset.AssetClass, MoveTemp(Tags));
+		}
+	}
+}
+
+void FProjectCleanerDataManager::GetPackageDependencies(const FName PackageName, TArray<FName>& OutDependencies) const
+{
+	if (!bReadPackageHeaders)
+	{
+		AssetRegistry->Get().GetDependencies(PackageName, OutDependencies);
+		PROJECTCLEANER_COUNTER_ADD(RegistryQueries, 1);
+		return;
+	}
+
+	if (const int32* HeaderIndex = PackageHeaderIndices.Find(PackageName))
+	{
+		OutDependencies.Append(PackageHeaders[*HeaderIndex].Dependencies);
+	}
+}
+
+void FProjectCleanerDataManager::GetAssets(const FARFilter& Filter, TArray<FAssetData>& OutAssets) const
+{
+	if (!bReadPackageHeaders)
+	{
+		AssetRegistry->Get().GetAssets(Filter, OutAssets);
+		PROJECTCLEANER_COUNTER_ADD(RegistryQueries, 1);
+		return;
+	}
 
-			const auto Redirector = CastChecked<UObjectRedirector>(AssetObj);
-			if (!Redirector) continue;
+	// registry knows class hierarchy, but not paths it never gathered, so paths are matched here
+	TArray<FAssetData> Assets;
+	for (const auto& Asset : AllAssets)
+	{
+		const FString AssetPath = Asset.PackagePath.ToString();
+		const bool bInPath = Filter.PackagePaths.Num() == 0 || Filter.PackagePaths.ContainsByPredicate([&] (const FName& Path)
+		{
+			const FString PathString = Path.ToString();
+			return AssetPath.Equals(PathString) || (Filter.bRecursivePaths && AssetPath.StartsWith(PathString + TEXT("/")));
+		});
 
-			Redirectors.Add(Redirector);
+		if (bInPath)
+		{
+			Assets.Add(Asset);
 		}
+	}
+
+	FARFilter ClassFilter = Filter;
+	ClassFilter.PackagePaths.Reset();
+	ClassFilter.bRecursivePaths = false;
+	AssetRegistry->Get().RunAssetsThroughFilter(Assets, ClassFilter);
+
+	OutAssets.Append(Assets);
+}
+
+int64 FProjectCleanerDataManager::GetTotalSize(const TArray<FAssetData>& Assets) const
+{
+	PROJECTCLEANER_SCOPE(GetTotalSize);
+
+	// package with several assets is still one set of files on disk
+	TSet<FName> Packages;
+	Packages.Reserve(Assets.Num());
+
+	int64 Size = 0;
+	for (const auto& Asset : Assets)
+	{
+		bool bAlreadyCounted = false;
+		Packages.Add(Asset.PackageName, &bAlreadyCounted);
+		if (bAlreadyCounted) continue;
+
+		Size += GetPackageSize(Asset.PackageName);
+	}
+
+	return Size;
+}
 
-		Redirectors.Shrink();
+void FProjectCleanerDataManager::GetAssetsFootprint(const TArray<FAssetData>& Assets, FCleanerFootprint& OutFootprint) const
+{
+	PROJECTCLEANER_SCOPE(GetAssetsFootprint);
+
+	TArray<int32> Nodes;
+	Nodes.Reserve(Assets.Num());
+	for (const auto& Asset : Assets)
+	{
+		if (const int32* Node = GraphPackageIndices.Find(Asset.PackageName))
+		{
+			Nodes.Add(*Node);
+		}
+	}
+
+	FootprintCalculator.Calculate(Nodes, OutFootprint);
+}
+
+void FProjectCleanerDataManager::GetFoldersFootprint(const TArray<FString>& Folders, FCleanerFootprint& OutFootprint) const
+{
+	PROJECTCLEANER_SCOPE(GetFoldersFootprint);
+
+	FCleanerPathTrie FoldersTrie;
+	for (const auto& Folder : Folders)
+	{
+		FoldersTrie.Add(Folder);
+	}
+
+	// folders are far fewer than packages, every node is in one folder list so overlapping selection adds it once
+	TArray<int32> Nodes;
+	for (const auto& FolderNodes : FolderGraphNodes)
+	{
+		if (FoldersTrie.ContainsPrefixOf(FolderNodes.Key.ToString()))
+		{
+			Nodes.Append(FolderNodes.Value);
+		}
+	}
+
+	FootprintCalculator.Calculate(Nodes, OutFootprint);
+}
+
+int64 FProjectCleanerDataManager::GetPackageSize(const FName PackageName) const
+{
+	// header and registry sizes are .uasset or .umap only, without .uexp and .ubulk next to it
+	if (const int64* DiskSize = PackageDiskSizes.Find(PackageName))
+	{
+		return *DiskSize;
+	}
 
-		// Fix up all founded redirectors
-		AssetTools->Get().FixupReferencers(Redirectors);
+	if (const int32* HeaderIndex = PackageHeaderIndices.Find(PackageName))
+	{
+		return PackageHeaders[*HeaderIndex].FileSize;
 	}
 
-	FixRedirectorsTask.EnterProgressFrame(1.0f);
+	const auto AssetPackageData = AssetRegistry->Get().GetAssetPackageData(PackageName);
+	return AssetPackageData ? AssetPackageData->DiskSize : 0;
 }
 
-void FProjectCleanerDataManager::FindAllAssets()
+int32 FProjectCleanerDataManager::FindInvalidFilesAndAssets()
 {
-	AllAssets.Empty();
-	AllAssets.Reserve(AssetRegistry->Get().GetAllocatedSize());
-	AssetRegistry->Get().GetAssetsByPath(RelativeRoot, AllAssets, true);
-}
+	PROJECTCLEANER_SCOPE(FindInvalidFilesAndAssets);
 
-void FProjectCleanerDataManager::FindInvalidFilesAndAssets()
-{
 	CorruptedAssets.Empty();
 	NonEngineFiles.Empty();
+	OrphanedFiles.Empty();
+	OrphanedFilesSize = 0;
+	LooseFileSizes.Empty();
+	PackageDiskSizes.Empty();
+	BiggestNonEngineFiles.Reset(BiggestWinsNum);
 
 	struct ProjectCleanerDirVisitor : IPlatformFile::FDirectoryVisitor
 	{
 		ProjectCleanerDirVisitor(
-			const TArray<FAssetData>& Assets,
+			const TSet<FName>& Assets,
 			TSet<FName>& NewCorruptedAssets,
-			TSet<FName>& NewNonEngineFiles
+			TSet<FName>& NewNonEngineFiles,
+			TArray<FString>* NewValidatedFiles,
+			const bool bNewRegistryFromFile
 		) :
-		AllAssets(Assets),
+		AssetObjectPaths(Assets),
 		CorruptedAssets(NewCorruptedAssets),
-		NonEngineFiles(NewNonEngineFiles) {}
+		NonEngineFiles(NewNonEngineFiles),
+		ValidatedFiles(NewValidatedFiles),
+		bRegistryFromFile(bNewRegistryFromFile) {}
 		
 		virtual bool Visit(const TCHAR* FilenameOrDirectory, bool bIsDirectory) override
 		{
 			const FString FullPath = FPaths::ConvertRelativePathToFull(FilenameOrDirectory);
 			if (!bIsDirectory)
 			{
+				++VisitedFilesNum;
+				PROJECTCLEANER_COUNTER_ADD(FilesVisited, 1);
+
 				if (ProjectCleanerUtility::IsEngineExtension(FPaths::GetExtension(FullPath, false)))
 				{
 					// here we got absolute path "C:/MyProject/Content/material.uasset"
@@ -480,14 +1183,30 @@ void FProjectCleanerDataManager::FindInvalidFilesAndAssets()
 					ObjectPath.Append(TEXT(".") + FPaths::GetBaseFilename(InternalFilePath));
 
 					const FName ObjectPathName = FName{*ObjectPath};
-					const bool IsInAssetRegistry = AllAssets.ContainsByPredicate([&] (const FAssetData& Elem)
+					if (!AssetObjectPaths.Contains(ObjectPathName))
 					{
-						return Elem.ObjectPath.IsEqual(ObjectPathName);
-					});
-					if (!IsInAssetRegistry)
+						// loaded registry may miss packages on purpose, file missing from it is not broken
+						if (bRegistryFromFile)
+						{
+							++UnregisteredFilesNum;
+						}
+						else
+						{
+							CorruptedAssets.Add(ObjectPathName);
+						}
+					}
+					else if (ValidatedFiles)
 					{
-						CorruptedAssets.Add(ObjectPathName);
+						ValidatedFiles->Add(FullPath);
 					}
+
+					PackageStems.Add(ProjectCleanerUtility::GetPackageFileStem(FullPath), FName{*FPackageName::ObjectPathToPackageName(ObjectPath)});
+					PackageFiles.Add(FullPath);
+				}
+				else if (ProjectCleanerUtility::IsEngineCompanionExtension(FPaths::GetExtension(FullPath, false)))
+				{
+					// owning package may be visited later, so companions are matched after walk
+					PackageFiles.Add(FullPath);
 				}
 				else
 				{
@@ -497,18 +1216,200 @@ void FProjectCleanerDataManager::FindInvalidFilesAndAssets()
 
 			return true;
 		}
-		const TArray<FAssetData>& AllAssets;
+		const TSet<FName>& AssetObjectPaths;
 		TSet<FName>& CorruptedAssets;
 		TSet<FName>& NonEngineFiles;
+		TArray<FString>* ValidatedFiles;
+		const bool bRegistryFromFile;
+		int32 UnregisteredFilesNum = 0;
+		/* Package file stem => package name */
+		TMap<FString, FName> PackageStems;
+		/* Package and companion files, their sizes make package footprint */
+		TArray<FString> PackageFiles;
+		int32 VisitedFilesNum = 0;
 	};
 
-	ProjectCleanerDirVisitor Visitor{AllAssets, CorruptedAssets, NonEngineFiles};
+	// every visited package file is looked up in registry assets, so they are hashed once before walk
+	TSet<FName> AssetObjectPaths;
+	AssetObjectPaths.Reserve(AllAssets.Num());
+	for (const auto& Asset : AllAssets)
+	{
+		AssetObjectPaths.Add(Asset.ObjectPath);
+	}
+
+	// only packages registry knows about need deep check, rest are already corrupted
+	TArray<FString> ValidatedFiles;
+	ProjectCleanerDirVisitor Visitor{AssetObjectPaths, CorruptedAssets, NonEngineFiles, bValidatePackages ? &ValidatedFiles : nullptr, bRegistryFromFile};
 	FPlatformFileManager::Get().GetPlatformFile().IterateDirectoryRecursively(*FPaths::ProjectContentDir(), Visitor);
+
+	if (Visitor.UnregisteredFilesNum > 0)
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("%d package files are not listed in loaded registry file, they are neither analysed nor reported as corrupted"), Visitor.UnregisteredFilesNum);
+	}
+
+	// directory walk gives no sizes, stat calls are independent so they run in parallel
+	TArray<FString>& StatFiles = Visitor.PackageFiles;
+	const int32 PackageFilesNum = StatFiles.Num();
+	StatFiles.Reserve(PackageFilesNum + NonEngineFiles.Num());
+	for (const auto& NonEngineFile : NonEngineFiles)
+	{
+		StatFiles.Add(NonEngineFile.ToString());
+	}
+
+	TArray<int64> FileSizes;
+	FileSizes.SetNumZeroed(StatFiles.Num());
+	ParallelFor(StatFiles.Num(), [&] (const int32 Index)
+	{
+		FileSizes[Index] = FMath::Max<int64>(0, IFileManager::Get().FileSize(*StatFiles[Index]));
+	});
+
+	// set was not changed since it was copied above, so iteration order is same
+	int32 NonEngineFileIndex = PackageFilesNum;
+	LooseFileSizes.Reserve(NonEngineFiles.Num());
+	for (const auto& NonEngineFile : NonEngineFiles)
+	{
+		LooseFileSizes.Add(NonEngineFile, FileSizes[NonEngineFileIndex]);
+		BiggestNonEngineFiles.Add(NonEngineFile, FileSizes[NonEngineFileIndex++]);
+	}
+
+	PackageDiskSizes.Reserve(Visitor.PackageStems.Num());
+	for (int32 i = 0; i < PackageFilesNum; ++i)
+	{
+		if (const FName* PackageName = Visitor.PackageStems.Find(ProjectCleanerUtility::GetPackageFileStem(StatFiles[i])))
+		{
+			PackageDiskSizes.FindOrAdd(*PackageName) += FileSizes[i];
+			continue;
+		}
+
+		const FName OrphanedFile{StatFiles[i]};
+		OrphanedFiles.Add(OrphanedFile);
+		LooseFileSizes.Add(OrphanedFile, FileSizes[i]);
+		OrphanedFilesSize += FileSizes[i];
+	}
+
+	if (bValidatePackages)
+	{
+		ValidatePackageFiles(ValidatedFiles);
+	}
+
+	return Visitor.VisitedFilesNum;
+}
+
+void FProjectCleanerDataManager::ValidatePackageFiles(const TArray<FString>& PackageFiles)
+{
+	FProjectCleanerPackageValidator Validator;
+
+	TArray<FString> Errors;
+	Validator.Validate(PackageFiles, Errors);
+
+	TSet<FName> CorruptedPackages;
+	for (int32 i = 0; i < PackageFiles.Num(); ++i)
+	{
+		if (Errors[i].IsEmpty()) continue;
+
+		const FString InternalFilePath = ProjectCleanerUtility::ConvertAbsolutePathToInternal(PackageFiles[i]);
+		FString ObjectPath = InternalFilePath;
+		ObjectPath.RemoveFromEnd(FPaths::GetExtension(InternalFilePath, true));
+		ObjectPath.Append(TEXT(".") + FPaths::GetBaseFilename(InternalFilePath));
+
+		CorruptedAssets.Add(FName{*ObjectPath});
+		CorruptedPackages.Add(FName{*FPackageName::ObjectPathToPackageName(ObjectPath)});
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Corrupted package %s: %s"), *PackageFiles[i], *Errors[i]);
+	}
+
+	// broken package can not be loaded, so it is never offered for deletion as unused asset
+	if (CorruptedPackages.Num() > 0)
+	{
+		AllAssets.RemoveAll([&] (const FAssetData& Asset)
+		{
+			return CorruptedPackages.Contains(Asset.PackageName);
+		});
+	}
+
+	// cache is not project content, read only runs save it too, writes are atomic so concurrent runs do not corrupt it
+	if (!Validator.SaveCache())
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Failed to save %s"), *FProjectCleanerPackageValidator::GetDefaultCachePath());
+	}
+}
+
+int32 FProjectCleanerDataManager::ResolveRedirectors()
+{
+	PROJECTCLEANER_SCOPE(ResolveRedirectors);
+
+	Redirectors.Reset();
+	RedirectorDestinations.Reset();
+
+	const FName RedirectorClassName = UObjectRedirector::StaticClass()->GetFName();
+	for (const auto& Asset : AllAssets)
+	{
+		if (Asset.AssetClass != RedirectorClassName) continue;
+
+		Redirectors.Add(Asset);
+		RedirectorDestinations.Add(Asset.PackageName, FindRedirectorDestination(Asset));
+	}
+
+	if (Redirectors.Num() == 0) return 0;
+
+	AllAssets.RemoveAll([&] (const FAssetData& Asset)
+	{
+		return Asset.AssetClass == RedirectorClassName;
+	});
+
+	// collapsing chains, so every redirector points straight to its final package
+	for (auto& Redirector : RedirectorDestinations)
+	{
+		FName Destination = Redirector.Value;
+		int32 Hops = 0;
+		while (const FName* NextDestination = RedirectorDestinations.Find(Destination))
+		{
+			// redirectors pointing at each other, nothing real at the end
+			if (++Hops > RedirectorDestinations.Num())
+			{
+				Destination = NAME_None;
+				break;
+			}
+
+			Destination = *NextDestination;
+		}
+
+		Redirector.Value = Destination;
+	}
+
+	return Redirectors.Num();
+}
+
+FName FProjectCleanerDataManager::FindRedirectorDestination(const FAssetData& Redirector) const
+{
+	// tag holds full name of destination object "Class /Game/Path/Asset.Asset"
+	FString DestinationObject;
+	if (Redirector.GetTagValue(TEXT("DestinationObject"), DestinationObject))
+	{
+		int32 SeparatorIndex;
+		if (DestinationObject.FindChar(TEXT(' '), SeparatorIndex))
+		{
+			DestinationObject = DestinationObject.RightChop(SeparatorIndex + 1);
+		}
+
+		if (FPackageName::IsValidObjectPath(DestinationObject))
+		{
+			return FName{*FPackageName::ObjectPathToPackageName(DestinationObject)};
+		}
+	}
+
+	// without tag falling back to dependencies, redirector package depends on destination package only
+	TArray<FName> Deps;
+	GetPackageDependencies(Redirector.PackageName, Deps);
+
+	return Deps.Num() > 0 ? Deps[0] : NAME_None;
 }
 
-void FProjectCleanerDataManager::FindIndirectAssets()
+int32 FProjectCleanerDataManager::FindIndirectAssets()
 {
+	PROJECTCLEANER_SCOPE(FindIndirectAssets);
+
 	IndirectAssets.Empty();
+	IndirectAssetsList.Empty();
 	
 	const FString SourceDir = FPaths::ProjectDir() + TEXT("Source/");
 	const FString ConfigDir = FPaths::ProjectDir() + TEXT("Config/");
@@ -561,60 +1462,67 @@ void FProjectCleanerDataManager::FindIndirectAssets()
 	Files.Append(ProjectPluginsFiles);
 	Files.Shrink();
 
+	// assets can be referenced both by object path and package name
+	TMap<FName, int32> AssetIndices;
+	AssetIndices.Reserve(AllAssets.Num() * 2);
+	for (int32 i = 0; i < AllAssets.Num(); ++i)
+	{
+		AssetIndices.Add(AllAssets[i].ObjectPath, i);
+		AssetIndices.Add(AllAssets[i].PackageName, i);
+	}
+
+	// code may still use old path of moved asset
+	for (const auto& Redirector : Redirectors)
+	{
+		if (const int32* DestinationIndex = AssetIndices.Find(RedirectorDestinations.FindRef(Redirector.PackageName)))
+		{
+			const int32 AssetIndex = *DestinationIndex;
+			AssetIndices.Add(Redirector.ObjectPath, AssetIndex);
+			AssetIndices.Add(Redirector.PackageName, AssetIndex);
+		}
+	}
+
+	TArray<FCleanerIndirectReference> References;
 	for (const auto& File : Files)
 	{
 		if (!PlatformFile->FileExists(*File)) continue;
 	
 		FString FileContent;
 		FFileHelper::LoadFileToString(FileContent, *File);
-		
-		if (!ProjectCleanerUtility::HasIndirectlyUsedAssets(FileContent)) continue;
+		PROJECTCLEANER_COUNTER_ADD(FilesVisited, 1);
+		PROJECTCLEANER_BYTES_COUNTER_ADD(BytesScanned, FileContent.Len());
 
-		static FRegexPattern Pattern(TEXT(R"(\/Game([A-Za-z0-9_.\/]+)\b)"));
-		FRegexMatcher Matcher(Pattern, FileContent);
-		while (Matcher.FindNext())
-		{
-			FString FoundedAssetObjectPath =  Matcher.GetCaptureGroup(0);
-		
+		References.Reset();
+		FCleanerIndirectReferenceMatcher::FindReferences(FileContent, References);
 
-			// if ObjectPath ends with "_C" , then its probably blueprint, so we trim that
-			if (FoundedAssetObjectPath.EndsWith("_C"))
-			{
-				FString TrimmedObjectPath = FoundedAssetObjectPath;
-				TrimmedObjectPath.RemoveFromEnd("_C");
-				
-				FoundedAssetObjectPath = TrimmedObjectPath;
-			}
-			const FAssetData* AssetData = AllAssets.FindByPredicate([&] (const FAssetData& Elem)
-			{
-				return
-					Elem.ObjectPath.ToString()==(FoundedAssetObjectPath) ||
-					Elem.PackageName.ToString()==(FoundedAssetObjectPath);
-			});
-
-			if (!AssetData) continue;
-			
-			// if founded asset is ok, we loading file by lines to determine on what line its used
-			TArray<FString> Lines;
-			FFileHelper::LoadFileToStringArray(Lines, *File);
-			for (int32 i = 0; i < Lines.Num(); ++i)
-			{
-				if (!Lines.IsValidIndex(i)) continue;
-				if (!Lines[i].Contains(FoundedAssetObjectPath)) continue;
-			
-				FIndirectAsset IndirectAsset;
-				IndirectAsset.File = FPaths::ConvertRelativePathToFull(File);
-				IndirectAsset.RelativePath = AssetData->PackagePath;
-				IndirectAsset.Line = i + 1;
-				IndirectAssets.Add(*AssetData, IndirectAsset);
-			}
+		for (const auto& Reference : References)
+		{
+			// FNAME_Find never adds unknown strings to name table, and unknown name can not be an asset
+			const FName ObjectPath{*Reference.ObjectPath, FNAME_Find};
+			if (ObjectPath.IsNone()) continue;
+
+			const int32* AssetIndex = AssetIndices.Find(ObjectPath);
+			if (!AssetIndex) continue;
+
+			const FAssetData& AssetData = AllAssets[*AssetIndex];
+			FIndirectAsset IndirectAsset;
+			IndirectAsset.File = FPaths::ConvertRelativePathToFull(File);
+			IndirectAsset.RelativePath = AssetData.PackagePath;
+			IndirectAsset.Line = Reference.Line;
+			IndirectAssets.Add(AssetData, IndirectAsset);
 		}
 	}
+
+	IndirectAssets.GenerateKeyArray(IndirectAssetsList);
+
+	return Files.Num();
 }
 
 
 void FProjectCleanerDataManager::FindEmptyFolders(const bool bScanDevelopersContent)
 {
+	PROJECTCLEANER_SCOPE(FindEmptyFolders);
+
 	EmptyFolders.Empty();
 	
 	ProjectCleanerUtility::FindEmptyFoldersInPath(FPaths::ProjectContentDir() / TEXT("*"), EmptyFolders);
@@ -655,6 +1563,8 @@ void FProjectCleanerDataManager::FindEmptyFolders(const bool bScanDevelopersCont
 
 void FProjectCleanerDataManager::FindPrimaryAssetClasses()
 {
+	PROJECTCLEANER_SCOPE(FindPrimaryAssetClasses);
+
 	PrimaryAssetClasses.Empty();
 	
 	const auto& AssetManager = UAssetManager::Get();
@@ -674,11 +1584,14 @@ void FProjectCleanerDataManager::FindPrimaryAssetClasses()
 
 void FProjectCleanerDataManager::FindAssetsWithExternalReferencers()
 {
+	PROJECTCLEANER_SCOPE(FindAssetsWithExternalReferencers);
+
 	AssetsWithExternalRefs.Empty();
 	TArray<FName> Refs;
 	for (const auto& Asset : AllAssets)
 	{
 		AssetRegistry->Get().GetReferencers(Asset.PackageName, Refs);
+		PROJECTCLEANER_COUNTER_ADD(RegistryQueries, 1);
 
 		const bool HasExternalRefs = Refs.ContainsByPredicate([](const FName& Ref)
 		{
@@ -692,40 +1605,158 @@ void FProjectCleanerDataManager::FindAssetsWithExternalReferencers()
 
 		Refs.Reset();
 	}
+
+	// external referencer of redirector keeps its destination alive
+	TArray<FAssetData> DestinationAssets;
+	for (const auto& Redirector : Redirectors)
+	{
+		AssetRegistry->Get().GetReferencers(Redirector.PackageName, Refs);
+		PROJECTCLEANER_COUNTER_ADD(RegistryQueries, 1);
+
+		const bool HasExternalRefs = Refs.ContainsByPredicate([](const FName& Ref)
+		{
+			return !Ref.ToString().StartsWith(TEXT("/Game"));
+		});
+		Refs.Reset();
+
+		const FName Destination = RedirectorDestinations.FindRef(Redirector.PackageName);
+		if (!HasExternalRefs || Destination.IsNone()) continue;
+
+		DestinationAssets.Reset();
+		AssetRegistry->Get().GetAssetsByPackageName(Destination, DestinationAssets);
+		PROJECTCLEANER_COUNTER_ADD(RegistryQueries, 1);
+		for (const auto& DestinationAsset : DestinationAssets)
+		{
+			AssetsWithExternalRefs.AddUnique(DestinationAsset);
+		}
+	}
 }
 
-void FProjectCleanerDataManager::FindUnusedAssets()
+void FProjectCleanerDataManager::ClassifyAssets(const TSet<FName>& UsedAssetsDependencies)
 {
+	PROJECTCLEANER_SCOPE(ClassifyAssets);
+
 	UnusedAssets.Empty();
 	UnusedAssets.Reserve(AllAssets.Num());
-	ExcludedAssets.Empty();
-	ExcludedAssets.Reserve(AllAssets.Num());
+	UnusedPackages.Empty();
+	UnusedPackages.Reserve(AllAssets.Num());
+	TotalProjectSize = 0;
+	TotalUnusedSize = 0;
 
-	TSet<FName> UsedAssets;
-	UsedAssets.Reserve(AllAssets.Num());
-	FindUsedAssets(UsedAssets);
-	UsedAssets.Shrink();
+	FolderStats.Reset();
+	ClassStats.Reset();
+	BiggestUnusedAssets.Reset(BiggestWinsNum);
+	BiggestUnusedFolders.Reset(BiggestWinsNum);
 
-	FindExcludedAssets(UsedAssets);
-
-	TSet<FName> UsedAssetsDependencies;
-	UsedAssetsDependencies.Reserve(AllAssets.Num());
-	FindUsedAssetsDependencies(UsedAssets, UsedAssetsDependencies);
+	// package with several assets is one set of files, so its size is counted once and assets are counted one by one
+	TSet<FName> CountedPackages;
+	CountedPackages.Reserve(AllAssets.Num());
 
+	// classification and folder/class aggregation are done in same pass
 	const bool IsMegascansLoaded = FModuleManager::Get().IsModuleLoaded("MegascansPlugin");
 	for (const auto& Asset : AllAssets)
 	{
-		if (UsedAssetsDependencies.Contains(Asset.PackageName)) continue;
-		if (PrimaryAssets.Contains(Asset)) continue;
-		if (IsMegascansLoaded && ProjectCleanerUtility::IsUnderMegascansFolder(Asset)) continue;
-		
-		UnusedAssets.Add(Asset);
+		const bool bUsed =
+			UsedAssetsDependencies.Contains(Asset.PackageName) ||
+			PrimaryAssetPackages.Contains(Asset.PackageName) ||
+			(IsMegascansLoaded && ProjectCleanerUtility::IsUnderMegascansFolder(Asset));
+
+		bool bPackageAlreadyCounted = false;
+		CountedPackages.Add(Asset.PackageName, &bPackageAlreadyCounted);
+		const int64 PackageSize = bPackageAlreadyCounted ? 0 : GetPackageSize(Asset.PackageName);
+
+		int64 UnusedPackageSize = 0;
+		if (!bUsed)
+		{
+			UnusedAssets.Add(Asset);
+
+			bool bPackageAlreadyUnused = false;
+			UnusedPackages.Add(Asset.PackageName, &bPackageAlreadyUnused);
+			if (!bPackageAlreadyUnused)
+			{
+				UnusedPackageSize = GetPackageSize(Asset.PackageName);
+				BiggestUnusedAssets.Add(Asset.PackageName, UnusedPackageSize);
+			}
+		}
+
+		TotalProjectSize += PackageSize;
+		TotalUnusedSize += UnusedPackageSize;
+		AddToAggregateStats(Asset, !bUsed, PackageSize, UnusedPackageSize);
 	}
 	UnusedAssets.Shrink();
+	UnusedPackages.Shrink();
+
+	// every folder includes its subfolders, root would always be on top
+	for (const auto& FolderStat : FolderStats)
+	{
+		if (FolderStat.Key == RelativeRoot || FolderStat.Value.UnusedSize == 0) continue;
+
+		BiggestUnusedFolders.Add(FolderStat.Key, FolderStat.Value.UnusedSize);
+	}
+}
+
+int32 FProjectCleanerDataManager::FindDuplicateAssets()
+{
+	PROJECTCLEANER_SCOPE(FindDuplicateAssets);
+
+	FProjectCleanerDuplicateFinder DuplicateFinder;
+	DuplicateFinder.Find(AllAssets, DuplicateGroups);
+
+	// cache is not project content, read only runs save it too, writes are atomic so concurrent runs do not corrupt it
+	if (!DuplicateFinder.SaveCache())
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Failed to save %s"), *FProjectCleanerDuplicateFinder::GetDefaultCachePath());
+	}
+
+	return DuplicateGroups.Num();
+}
+
+void FProjectCleanerDataManager::AddToAggregateStats(const FAssetData& AssetData, const bool bUnused, const int64 PackageSize, const int64 UnusedPackageSize)
+{
+	const FName ClassName = ProjectCleanerUtility::GetClassName(AssetData);
+	FCleanerAggregateStats& ClassStat = ClassStats.FindOrAdd(ClassName);
+	ClassStat.Name = ClassName;
+	ClassStat.AssetsNum += 1;
+	ClassStat.TotalSize += PackageSize;
+	if (bUnused)
+	{
+		ClassStat.UnusedAssetsNum += 1;
+		ClassStat.UnusedSize += UnusedPackageSize;
+	}
+
+	// rolling up asset to its folder and all parent folders up to "/Game"
+	FName FolderPath = AssetData.PackagePath;
+	while (!FolderPath.IsNone())
+	{
+		FCleanerAggregateStats* FolderStat = FolderStats.Find(FolderPath);
+		if (!FolderStat)
+		{
+			FolderStat = &FolderStats.Add(FolderPath);
+			FolderStat->Name = FolderPath;
+
+			// parent path computed only once per folder
+			if (!FolderPath.IsEqual(RelativeRoot))
+			{
+				FolderStat->ParentPath = FName{*FPaths::GetPath(FolderPath.ToString())};
+			}
+		}
+
+		FolderStat->AssetsNum += 1;
+		FolderStat->TotalSize += PackageSize;
+		if (bUnused)
+		{
+			FolderStat->UnusedAssetsNum += 1;
+			FolderStat->UnusedSize += UnusedPackageSize;
+		}
+
+		FolderPath = FolderStat->ParentPath;
+	}
 }
 
 void FProjectCleanerDataManager::FindUsedAssets(TSet<FName>& UsedAssets)
 {
+	PROJECTCLEANER_SCOPE(FindUsedAssets);
+
 	TSet<FName> DerivedFromPrimaryAssets;
 	{
 		const TSet<FName> ExcludedClassNames;
@@ -739,12 +1770,17 @@ void FProjectCleanerDataManager::FindUsedAssets(TSet<FName>& UsedAssets)
 	Filter_BP.bRecursivePaths = true;
 
 	TArray<FAssetData> BlueprintAssets;
-	AssetRegistry->Get().GetAssets(Filter_BP, BlueprintAssets);
+	GetAssets(Filter_BP, BlueprintAssets);
 
 	for (const auto& BP_Asset : BlueprintAssets)
 	{
 		const FName BP_ClassName = ProjectCleanerUtility::GetClassName(BP_Asset);
-		if (DerivedFromPrimaryAssets.Contains(BP_ClassName))
+
+		// registry class hierarchy has no blueprint classes it did not gather, parent class is checked too
+		const FString ParentClassPath = BP_Asset.GetTagValueRef<FString>(TEXT("ParentClass"));
+		const FName BP_ParentClassName = ParentClassPath.IsEmpty() ? NAME_None : FName{*FPackageName::ObjectPathToObjectName(FPackageName::ExportTextPathToObjectPath(ParentClassPath))};
+
+		if (DerivedFromPrimaryAssets.Contains(BP_ClassName) || DerivedFromPrimaryAssets.Contains(BP_ParentClassName))
 		{
 			UsedAssets.Add(BP_Asset.PackageName);
 		}
@@ -757,10 +1793,14 @@ void FProjectCleanerDataManager::FindUsedAssets(TSet<FName>& UsedAssets)
 	Filter.ClassNames.Append(PrimaryAssetClasses.Array());
 	Filter.ClassNames.Add(UMapBuildDataRegistry::StaticClass()->GetFName());
 
-	AssetRegistry->Get().GetAssets(Filter, PrimaryAssets);
+	TArray<FAssetData> PrimaryAssets;
+	GetAssets(Filter, PrimaryAssets);
 
+	PrimaryAssetPackages.Reset();
+	PrimaryAssetPackages.Reserve(PrimaryAssets.Num());
 	for (const auto& Asset : PrimaryAssets)
 	{
+		PrimaryAssetPackages.Add(Asset.PackageName);
 		UsedAssets.Add(Asset.PackageName);
 	}
 
@@ -776,8 +1816,12 @@ void FProjectCleanerDataManager::FindUsedAssets(TSet<FName>& UsedAssets)
 
 	if (!bScanDeveloperContents)
 	{
+		FARFilter Filter_Developers;
+		Filter_Developers.PackagePaths.Add(TEXT("/Game/Developers"));
+		Filter_Developers.bRecursivePaths = true;
+
 		TArray<FAssetData> AssetsInDeveloperFolder;
-		AssetRegistry->Get().GetAssetsByPath(TEXT("/Game/Developers"), AssetsInDeveloperFolder, true);
+		GetAssets(Filter_Developers, AssetsInDeveloperFolder);
 
 		for (const auto& Asset : AssetsInDeveloperFolder)
 		{
@@ -788,165 +1832,129 @@ void FProjectCleanerDataManager::FindUsedAssets(TSet<FName>& UsedAssets)
 
 void FProjectCleanerDataManager::FindUsedAssetsDependencies(const TSet<FName>& UsedAssets, TSet<FName>& UsedAssetsDeps) const
 {
-	TArray<FName> Stack;
+	PROJECTCLEANER_SCOPE(FindUsedAssetsDependencies);
+
+	TArray<int32> Roots;
+	Roots.Reserve(UsedAssets.Num());
 	for (const auto& Asset : UsedAssets)
 	{
 		UsedAssetsDeps.Add(Asset);
-		Stack.Add(Asset);
 
-		TArray<FName> Deps;
-		while (Stack.Num() > 0)
+		const FName* Destination = RedirectorDestinations.Find(Asset);
+		if (const int32* Node = GraphPackageIndices.Find(Destination ? *Destination : Asset))
 		{
-			const auto CurrentPackageName = Stack.Pop(false);
-			Deps.Reset();
-
-			AssetRegistry->Get().GetDependencies(CurrentPackageName, Deps);
+			Roots.Add(*Node);
+		}
+	}
 
-			Deps.RemoveAllSwap([&] (const FName& Dep)
-			{
-				return !Dep.ToString().StartsWith(*RelativeRoot.ToString());
-			}, false);
+	TBitArray<> Reachable;
+	DependencyGraph.FindReachable(Roots, Reachable);
 
-			for (const auto& Dep : Deps)
-			{
-				bool bIsAlreadyInSet = false;
-				UsedAssetsDeps.Add(Dep, &bIsAlreadyInSet);
-				if (!bIsAlreadyInSet)
-				{
-					Stack.Add(Dep);
-				}
-			}
-		}
+	for (TConstSetBitIterator<> It(Reachable); It; ++It)
+	{
+		UsedAssetsDeps.Add(GraphPackages[It.GetIndex()]);
 	}
 }
 
-void FProjectCleanerDataManager::FindExcludedAssets(TSet<FName>& UsedAssets)
+int32 FProjectCleanerDataManager::BuildDependencyGraph()
 {
-	// excluded by user
-	for (const auto& Asset : UserExcludedAssets)
+	PROJECTCLEANER_SCOPE(BuildDependencyGraph);
+
+	GraphPackages.Reset(AllAssets.Num());
+	GraphPackageIndices.Reset();
+	GraphPackageIndices.Reserve(AllAssets.Num());
+	FolderGraphNodes.Reset();
+	for (const auto& Asset : AllAssets)
 	{
-		UsedAssets.Add(Asset.PackageName);
+		if (GraphPackageIndices.Contains(Asset.PackageName)) continue;
 
-		if (!PrimaryAssets.Contains(Asset))
-		{
-			ExcludedAssets.Add(Asset.PackageName);
-		}
+		FolderGraphNodes.FindOrAdd(Asset.PackagePath).Add(GraphPackages.Num());
+		GraphPackageIndices.Add(Asset.PackageName, GraphPackages.Num());
+		GraphPackages.Add(Asset.PackageName);
 	}
 
-	// excluded by path
+	// registry is queried once per package, dependencies outside of project content are dropped
+	// and dependencies on redirectors become direct edges to redirector destinations
+	TArray<TPair<int32, int32>> Edges;
+	TArray<FName> Deps;
+	for (int32 Node = 0; Node < GraphPackages.Num(); ++Node)
 	{
-		TArray<FAssetData> AllExcludedAssets;
-	
-		FARFilter Filter;		
-		Filter.bRecursivePaths = true;
-	
-		for (const auto& ExcludedPath : ExcludedPaths)
-		{
-			Filter.PackagePaths.Add(ExcludedPath);
-		}
-
-		AssetRegistry->Get().GetAssets(Filter, AllExcludedAssets);
+		Deps.Reset();
+		GetPackageDependencies(GraphPackages[Node], Deps);
+		PROJECTCLEANER_COUNTER_ADD(DependencyEdges, Deps.Num());
 
-		for (const auto& Asset : AllExcludedAssets)
+		for (const auto& Dep : Deps)
 		{
-			UsedAssets.Add(Asset.PackageName);
-			if (!PrimaryAssets.Contains(Asset))
+			const FName* Destination = RedirectorDestinations.Find(Dep);
+			const int32* DepNode = GraphPackageIndices.Find(Destination ? *Destination : Dep);
+			if (DepNode && *DepNode != Node)
 			{
-				ExcludedAssets.Add(Asset.PackageName);
+				Edges.Emplace(Node, *DepNode);
 			}
 		}
 	}
 
-	// excluded by class
-	for (const auto& Asset : AllAssets)
+	DependencyGraph.Build(GraphPackages.Num(), Edges);
+
+	// condensed once here, so footprint queries from context menus only walk components
+	TArray<int64> PackageSizes;
+	PackageSizes.Reserve(GraphPackages.Num());
+	for (const auto& Package : GraphPackages)
 	{
-		if (IsExcludedByClass(Asset))
-		{
-			UsedAssets.Add(Asset.PackageName);
-			if (!PrimaryAssets.Contains(Asset))
-			{
-				ExcludedAssets.Add(Asset.PackageName);
-			}
-		}
+		PackageSizes.Add(GetPackageSize(Package));
 	}
+	FootprintCalculator.Build(DependencyGraph, PackageSizes);
+
+	return DependencyGraph.GetEdgesNum();
 }
 
-void FProjectCleanerDataManager::FillBucketWithAssets(TArray<FAssetData>& Bucket, const int32 BucketSize)
+void FProjectCleanerDataManager::FindExcludedAssets(TSet<FName>& UsedAssets)
 {
-	// Searching Root assets
-	int32 Index = 0;
-	TArray<FName> Refs;
-	while (Bucket.Num() < BucketSize && UnusedAssets.IsValidIndex(Index))
+	PROJECTCLEANER_SCOPE(FindExcludedAssets);
+
+	// excluded by user
+	for (const auto& Asset : UserExcludedAssets)
 	{
-		const FAssetData CurrentAsset = UnusedAssets[Index];
-		AssetRegistry->Get().GetReferencers(CurrentAsset.PackageName, Refs);
-		Refs.RemoveAllSwap([&] (const FName& Ref)
-		{
-			return !Ref.ToString().StartsWith(RelativeRoot.ToString()) || Ref.IsEqual(CurrentAsset.PackageName);
-		}, false);
-		Refs.Shrink();
+		UsedAssets.Add(Asset.PackageName);
 
-		if (Refs.Num() == 0)
+		if (!PrimaryAssetPackages.Contains(Asset.PackageName))
 		{
-			Bucket.AddUnique(CurrentAsset);
-			UnusedAssets.RemoveAt(Index);
+			ExcludedAssets.Add(Asset.PackageName);
 		}
-
-		Refs.Reset();
-		
-		++Index;
-	}
-		
-	if (Bucket.Num() > 0)
-	{
-		return;
 	}
 
-	// if root assets not found, we deleting assets single by finding its referencers
-	if (UnusedAssets.Num() == 0)
-	{
-		return;
-	}
-	
-	TArray<FAssetData> Stack;
-	Stack.Add(UnusedAssets[0]);
-	
-	while (Stack.Num() > 0)
+	// excluded by path or class, path check result is shared by all assets in same folder
+	TMap<FName, bool> ExcludedByPathCache;
+	for (const auto& Asset : AllAssets)
 	{
-		const FAssetData Current = Stack.Pop(false);
-		Bucket.AddUnique(Current);
-		UnusedAssets.Remove(Current);
-		
-		AssetRegistry->Get().GetReferencers(Current.PackageName, Refs);
-		
-		Refs.RemoveAllSwap([&] (const FName& Ref)
-		{
-			return !Ref.ToString().StartsWith(RelativeRoot.ToString()) || Ref.IsEqual(Current.PackageName);
-		}, false);
-		Refs.Shrink();
-	
-		for (const auto& Ref : Refs)
+		bool bExcludedByPath = false;
+		if (!ExcludedPathsTrie.IsEmpty())
 		{
-			const FString ObjectPath = Ref.ToString() + TEXT(".") + FPaths::GetBaseFilename(*Ref.ToString());
-			const FAssetData AssetData = AssetRegistry->Get().GetAssetByObjectPath(FName{*ObjectPath});
-			if (AssetData.IsValid())
+			if (const bool* bCached = ExcludedByPathCache.Find(Asset.PackagePath))
 			{
-				if (!Bucket.Contains(AssetData))
-				{
-					Stack.Add(AssetData);
-				}
+				bExcludedByPath = *bCached;
+			}
+			else
+			{
+				bExcludedByPath = ExcludedByPathCache.Add(Asset.PackagePath, ExcludedPathsTrie.ContainsPrefixOf(Asset.PackagePath.ToString()));
+			}
+		}
 
-				Bucket.AddUnique(AssetData);
-				UnusedAssets.Remove(AssetData);
+		if (bExcludedByPath || IsExcludedByClass(Asset))
+		{
+			UsedAssets.Add(Asset.PackageName);
+			if (!PrimaryAssetPackages.Contains(Asset.PackageName))
+			{
+				ExcludedAssets.Add(Asset.PackageName);
 			}
 		}
-		
-		Refs.Reset();
 	}
 }
 
 bool FProjectCleanerDataManager::PrepareBucketForDeletion(const TArray<FAssetData>& Bucket, TArray<UObject*>& LoadedAssets)
 {
+	PROJECTCLEANER_SCOPE(PrepareBucketForDeletion);
+
 	TArray<FString> ObjectPaths;
 	ObjectPaths.Reserve(Bucket.Num());
 	
@@ -960,6 +1968,8 @@ bool FProjectCleanerDataManager::PrepareBucketForDeletion(const TArray<FAssetDat
 
 int32 FProjectCleanerDataManager::DeleteBucket(const TArray<UObject*>& LoadedAssets)
 {
+	PROJECTCLEANER_SCOPE(DeleteBucket);
+
 	int32 DeletedAssetsNum = ObjectTools::DeleteObjects(LoadedAssets, false);
 	
 	if (DeletedAssetsNum == 0)
@@ -990,21 +2000,25 @@ bool FProjectCleanerDataManager::IsExcludedByClass(const FAssetData& AssetData)
 bool FProjectCleanerDataManager::IsExcludedByPath(const FAssetData& AssetData) const
 {
 	if (!AssetData.IsValid()) return false;
-	
+
+	return ExcludedPathsTrie.ContainsPrefixOf(AssetData.PackagePath.ToString());
+}
+
+void FProjectCleanerDataManager::RebuildExcludedPathsTrie()
+{
+	ExcludedPathsTrie.Reset();
 	for (const auto& ExcludedPath : ExcludedPaths)
 	{
-		if (AssetData.PackagePath.ToString().StartsWith(ExcludedPath.ToString()))
-		{
-			return true;
-		}
+		ExcludedPathsTrie.Add(ExcludedPath.ToString());
 	}
-	
-	return false;
 }
 
 bool FProjectCleanerDataManager::IsLoadingAssets() const
 {
 	if (!AssetRegistry) return true;
 
+	// package headers are read during analysis, nothing to wait for
+	if (bReadPackageHeaders) return false;
+
 	return AssetRegistry->Get().IsLoadingAssets();
 }
\ No newline at end of file
@@ -0,0 +1,607 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "Core/ProjectCleanerDuplicateFinder.h"
+#include "ProjectCleaner.h"
+#include "Core/ProjectCleanerPackageHeaderReader.h"
+#include "Core/ProjectCleanerStats.h"
+#include "Core/ProjectCleanerUtility.h"
+// Engine Headers
+#include "Async/ParallelFor.h"
+#include "Hash/CityHash.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/PackageFileSummary.h"
+
+namespace ProjectCleanerDuplicates
+{
+	/** Increased whenever hashed range, hash function or sketch change */
+	constexpr int32 CacheVersion = 2;
+	constexpr int64 ChunkSize = 1024 * 1024;
+
+	/** Near duplicates, smaller packages are cheap to keep and too few chunks to compare */
+	constexpr int64 NearMinContentSize = 64 * 1024;
+	constexpr float NearSizeTolerance = 0.1f;
+	constexpr float NearSimilarityThreshold = 0.8f;
+	constexpr int32 SketchSize = 64;
+	/** Chunk hash shared by more candidates is common filler (e.g. zeroed data), it does not make them similar */
+	constexpr int32 MaxSketchPostingNum = 64;
+	/** Content defined chunks of 8 KB on average */
+	constexpr int32 ContentChunkMinSize = 2 * 1024;
+	constexpr int32 ContentChunkMaxSize = 64 * 1024;
+	constexpr uint64 ContentChunkBoundaryMask = (1 << 13) - 1;
+
+	/** Random value per byte for gear rolling hash, fixed seed keeps chunk boundaries and cached sketches stable */
+	struct FGearTable
+	{
+		uint64 Values[256];
+
+		FGearTable()
+		{
+			// splitmix64
+			uint64 State = 0;
+			for (uint64& Value : Values)
+			{
+				State += 0x9E3779B97F4A7C15ull;
+				uint64 Mixed = State;
+				Mixed = (Mixed ^ (Mixed >> 30)) * 0xBF58476D1CE4E5B9ull;
+				Mixed = (Mixed ^ (Mixed >> 27)) * 0x94D049BB133111EBull;
+				Value = Mixed ^ (Mixed >> 31);
+			}
+		}
+	};
+	const FGearTable GearTable;
+
+	/** Class, content size and hash of package, packages with same key are duplicate candidates */
+	struct FContentKey
+	{
+		FName AssetClass;
+		int64 ContentSize = 0;
+		uint64 Hash = 0;
+
+		bool operator==(const FContentKey& Other) const
+		{
+			return AssetClass == Other.AssetClass && ContentSize == Other.ContentSize && Hash == Other.Hash;
+		}
+
+		friend uint32 GetTypeHash(const FContentKey& Key)
+		{
+			return HashCombine(HashCombine(GetTypeHash(Key.AssetClass), GetTypeHash(Key.ContentSize)), GetTypeHash(Key.Hash));
+		}
+	};
+
+	/** Drops groups with single candidate, those have nothing to be duplicate of */
+	void RemoveSingleCandidates(TMap<FContentKey, TArray<int32>>& Groups)
+	{
+		for (auto It = Groups.CreateIterator(); It; ++It)
+		{
+			if (It.Value().Num() < 2)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+}
+
+FProjectCleanerDuplicateFinder::FProjectCleanerDuplicateFinder(const int32 InBatchSize) :
+	BatchSize(FMath::Max(1, InBatchSize)),
+	bCacheLoaded(false)
+{
+}
+
+void FProjectCleanerDuplicateFinder::Find(const TArray<FAssetData>& Assets, TArray<FCleanerDuplicateGroup>& OutGroups)
+{
+	PROJECTCLEANER_SCOPE(FindDuplicates);
+
+	using namespace ProjectCleanerDuplicates;
+
+	OutGroups.Reset();
+	LoadCache();
+
+	// one candidate per package, class is only known from its assets
+	TArray<FCandidate> Candidates;
+	TMap<FName, int32> ClassAssetsNum;
+	{
+		TSet<FName> Packages;
+		Packages.Reserve(Assets.Num());
+		for (int32 i = 0; i < Assets.Num(); ++i)
+		{
+			const FAssetData& Asset = Assets[i];
+
+			bool bAlreadyAdded = false;
+			Packages.Add(Asset.PackageName, &bAlreadyAdded);
+			if (bAlreadyAdded) continue;
+
+			const FString& Extension = Asset.AssetClass == TEXT("World") ? FPackageName::GetMapPackageExtension() : FPackageName::GetAssetPackageExtension();
+
+			FCandidate& Candidate = Candidates.AddDefaulted_GetRef();
+			Candidate.AssetIndex = i;
+			Candidate.File = FPaths::ConvertRelativePathToFull(FPackageName::LongPackageNameToFilename(Asset.PackageName.ToString(), Extension));
+			ClassAssetsNum.FindOrAdd(Asset.AssetClass) += 1;
+		}
+	}
+
+	Candidates.RemoveAll([&] (const FCandidate& Candidate)
+	{
+		return ClassAssetsNum.FindRef(Assets[Candidate.AssetIndex].AssetClass) < 2;
+	});
+
+	// written from workers, one element per candidate, so bit array can not be used here
+	TArray<bool> Valid;
+	TArray<bool> Changed;
+	Valid.SetNumZeroed(Candidates.Num());
+	Changed.SetNumZeroed(Candidates.Num());
+
+	// header sizes first, content size is what separates candidates
+	ParallelFor(FMath::DivideAndRoundUp(Candidates.Num(), BatchSize), [&] (const int32 BatchIndex)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		TArray<uint8> Buffer;
+
+		const int32 End = FMath::Min((BatchIndex + 1) * BatchSize, Candidates.Num());
+		for (int32 i = BatchIndex * BatchSize; i < End; ++i)
+		{
+			FCandidate& Candidate = Candidates[i];
+			const FFileStatData StatData = PlatformFile.GetStatData(*Candidate.File);
+			if (!StatData.bIsValid) continue;
+
+			if (!FindCachedContent(Candidate.File, StatData, Candidate.Content))
+			{
+				Changed[i] = true;
+				if (!ReadHeaderSize(Candidate.File, Buffer, Candidate.Content.HeaderSize)) continue;
+			}
+
+			Valid[i] = Candidate.Content.HeaderSize >= 0 && Candidate.Content.HeaderSize < Candidate.Content.FileSize;
+		}
+	});
+
+	TMap<FContentKey, TArray<int32>> SizeGroups;
+	for (int32 i = 0; i < Candidates.Num(); ++i)
+	{
+		if (!Valid[i]) continue;
+
+		const FCachedContent& Content = Candidates[i].Content;
+		SizeGroups.FindOrAdd(FContentKey{Assets[Candidates[i].AssetIndex].AssetClass, Content.FileSize - Content.HeaderSize, 0}).Add(i);
+	}
+	RemoveSingleCandidates(SizeGroups);
+
+	TArray<int32> HashCandidates;
+	for (const auto& SizeGroup : SizeGroups)
+	{
+		HashCandidates.Append(SizeGroup.Value);
+	}
+
+	// content is hashed only for candidates that share class and size with other package
+	ParallelFor(FMath::DivideAndRoundUp(HashCandidates.Num(), BatchSize), [&] (const int32 BatchIndex)
+	{
+		TArray<uint8> Buffer;
+
+		const int32 End = FMath::Min((BatchIndex + 1) * BatchSize, HashCandidates.Num());
+		for (int32 i = BatchIndex * BatchSize; i < End; ++i)
+		{
+			FCandidate& Candidate = Candidates[HashCandidates[i]];
+			if (Candidate.Content.bHashed) continue;
+
+			Changed[HashCandidates[i]] = true;
+			Candidate.Content.bHashed = HashContent(Candidate.File, Candidate.Content.HeaderSize, Buffer, Candidate.Content.Hash);
+		}
+	});
+
+	TMap<FContentKey, TArray<int32>> HashGroups;
+	for (const int32 Index : HashCandidates)
+	{
+		const FCandidate& Candidate = Candidates[Index];
+		if (!Candidate.Content.bHashed) continue;
+
+		HashGroups.FindOrAdd(FContentKey{Assets[Candidate.AssetIndex].AssetClass, Candidate.Content.FileSize - Candidate.Content.HeaderSize, Candidate.Content.Hash}).Add(Index);
+	}
+	RemoveSingleCandidates(HashGroups);
+
+	// equal hash is confirmed by full comparison, packages not matching first one start their own group
+	TSet<int32> ExactDuplicates;
+	TArray<uint8> BufferA;
+	TArray<uint8> BufferB;
+	for (auto& HashGroup : HashGroups)
+	{
+		TArray<int32> Remaining = MoveTemp(HashGroup.Value);
+		while (Remaining.Num() > 1)
+		{
+			const FCandidate& First = Candidates[Remaining[0]];
+			TArray<int32> Same{Remaining[0]};
+			TArray<int32> Different;
+			for (int32 i = 1; i < Remaining.Num(); ++i)
+			{
+				if (IsSameContent(First, Candidates[Remaining[i]], BufferA, BufferB))
+				{
+					Same.Add(Remaining[i]);
+				}
+				else
+				{
+					Different.Add(Remaining[i]);
+				}
+			}
+
+			if (Same.Num() > 1)
+			{
+				ExactDuplicates.Append(Same);
+
+				FCleanerDuplicateGroup& Group = OutGroups.AddDefaulted_GetRef();
+				Group.AssetClass = HashGroup.Key.AssetClass;
+				Group.ContentSize = HashGroup.Key.ContentSize;
+				for (int32 i = 0; i < Same.Num(); ++i)
+				{
+					const FCandidate& Candidate = Candidates[Same[i]];
+					Group.Assets.Add(Assets[Candidate.AssetIndex]);
+					if (i > 0)
+					{
+						Group.WastedSize += Candidate.Content.FileSize;
+					}
+				}
+			}
+
+			Remaining = MoveTemp(Different);
+		}
+	}
+
+	// exact duplicates are already reported, rest is sketched to find near duplicates among them
+	TArray<int32> NearCandidates;
+	for (int32 i = 0; i < Candidates.Num(); ++i)
+	{
+		const FCachedContent& Content = Candidates[i].Content;
+		if (Valid[i] && !ExactDuplicates.Contains(i) && Content.FileSize - Content.HeaderSize >= NearMinContentSize)
+		{
+			NearCandidates.Add(i);
+		}
+	}
+
+	ParallelFor(FMath::DivideAndRoundUp(NearCandidates.Num(), BatchSize), [&] (const int32 BatchIndex)
+	{
+		TArray<uint8> Buffer;
+
+		const int32 End = FMath::Min((BatchIndex + 1) * BatchSize, NearCandidates.Num());
+		for (int32 i = BatchIndex * BatchSize; i < End; ++i)
+		{
+			FCandidate& Candidate = Candidates[NearCandidates[i]];
+			if (Candidate.Content.bSketched) continue;
+
+			Changed[NearCandidates[i]] = true;
+			Candidate.Content.bSketched = SketchContent(Candidate.File, Candidate.Content.HeaderSize, Buffer, Candidate.Content.Sketch);
+		}
+	});
+
+	FindNearDuplicates(Assets, Candidates, NearCandidates, OutGroups);
+
+	OutGroups.Sort([] (const FCleanerDuplicateGroup& A, const FCleanerDuplicateGroup& B)
+	{
+		return A.WastedSize > B.WastedSize;
+	});
+
+	int32 ReadFilesNum = 0;
+	for (int32 i = 0; i < Candidates.Num(); ++i)
+	{
+		const FCandidate& Candidate = Candidates[i];
+		if (!Changed[i] || Candidate.Content.FileSize == 0) continue;
+
+		Cache.Add(Candidate.File, Candidate.Content);
+		++ReadFilesNum;
+	}
+
+	UE_LOG(LogProjectCleaner, Display, TEXT("Duplicates: %d candidates, %d hashed, %d sketched, %d read from disk, %d groups"), Candidates.Num(), HashCandidates.Num(), NearCandidates.Num(), ReadFilesNum, OutGroups.Num());
+}
+
+bool FProjectCleanerDuplicateFinder::SaveCache()
+{
+	// several read only runs may share project, each replaces whole file
+	return ProjectCleanerUtility::SaveFileAtomically(GetDefaultCachePath(), [&] (FArchive& Writer)
+	{
+		int32 Version = ProjectCleanerDuplicates::CacheVersion;
+		Writer << Version;
+		Writer << Cache;
+	});
+}
+
+FString FProjectCleanerDuplicateFinder::GetDefaultCachePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("ProjectCleaner") / TEXT("DuplicateHashCache.bin");
+}
+
+bool FProjectCleanerDuplicateFinder::ReadHeaderSize(const FString& File, TArray<uint8>& Buffer, int64& OutHeaderSize)
+{
+	const TUniquePtr<IFileHandle> FileHandle{FPlatformFileManager::Get().GetPlatformFile().OpenRead(*File)};
+	if (!FileHandle.IsValid()) return false;
+
+	FPackageFileSummary Summary;
+	if (!FProjectCleanerPackageHeaderReader::ReadSummary(*FileHandle, Buffer, Summary)) return false;
+
+	OutHeaderSize = Summary.TotalHeaderSize;
+	return true;
+}
+
+bool FProjectCleanerDuplicateFinder::HashContent(const FString& File, const int64 Offset, TArray<uint8>& Buffer, uint64& OutHash)
+{
+	const TUniquePtr<IFileHandle> FileHandle{FPlatformFileManager::Get().GetPlatformFile().OpenRead(*File)};
+	if (!FileHandle.IsValid() || !FileHandle->Seek(Offset)) return false;
+
+	Buffer.SetNumUninitialized(ProjectCleanerDuplicates::ChunkSize, false);
+
+	// chunks are chained through seed, so whole content never has to be in memory
+	uint64 Hash = 0;
+	int64 Remaining = FileHandle->Size() - Offset;
+	while (Remaining > 0)
+	{
+		const int64 ReadSize = FMath::Min(Remaining, ProjectCleanerDuplicates::ChunkSize);
+		if (!FileHandle->Read(Buffer.GetData(), ReadSize)) return false;
+
+		Hash = CityHash64WithSeed(reinterpret_cast<const char*>(Buffer.GetData()), static_cast<uint32>(ReadSize), Hash);
+		Remaining -= ReadSize;
+	}
+
+	OutHash = Hash;
+	return true;
+}
+
+bool FProjectCleanerDuplicateFinder::IsSameContent(const FCandidate& A, const FCandidate& B, TArray<uint8>& BufferA, TArray<uint8>& BufferB)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const TUniquePtr<IFileHandle> FileA{PlatformFile.OpenRead(*A.File)};
+	const TUniquePtr<IFileHandle> FileB{PlatformFile.OpenRead(*B.File)};
+	if (!FileA.IsValid() || !FileB.IsValid()) return false;
+	if (!FileA->Seek(A.Content.HeaderSize) || !FileB->Seek(B.Content.HeaderSize)) return false;
+
+	BufferA.SetNumUninitialized(ProjectCleanerDuplicates::ChunkSize, false);
+	BufferB.SetNumUninitialized(ProjectCleanerDuplicates::ChunkSize, false);
+
+	int64 Remaining = A.Content.FileSize - A.Content.HeaderSize;
+	while (Remaining > 0)
+	{
+		const int64 ReadSize = FMath::Min(Remaining, ProjectCleanerDuplicates::ChunkSize);
+		if (!FileA->Read(BufferA.GetData(), ReadSize) || !FileB->Read(BufferB.GetData(), ReadSize)) return false;
+		if (FMemory::Memcmp(BufferA.GetData(), BufferB.GetData(), ReadSize) != 0) return false;
+
+		Remaining -= ReadSize;
+	}
+
+	return true;
+}
+
+bool FProjectCleanerDuplicateFinder::SketchContent(const FString& File, const int64 Offset, TArray<uint8>& Buffer, TArray<uint64>& OutSketch)
+{
+	using namespace ProjectCleanerDuplicates;
+
+	const TUniquePtr<IFileHandle> FileHandle{FPlatformFileManager::Get().GetPlatformFile().OpenRead(*File)};
+	if (!FileHandle.IsValid() || !FileHandle->Seek(Offset)) return false;
+
+	Buffer.SetNumUninitialized(ChunkSize, false);
+
+	// max heap of smallest distinct chunk hashes, biggest kept one is replaced first
+	TArray<uint64> Sketch;
+	Sketch.Reserve(SketchSize);
+	const auto AddChunkHash = [&] (const uint64 Hash)
+	{
+		if (Sketch.Contains(Hash)) return;
+
+		if (Sketch.Num() < SketchSize)
+		{
+			Sketch.HeapPush(Hash, TGreater<uint64>());
+		}
+		else if (Hash < Sketch.HeapTop())
+		{
+			Sketch.HeapPopDiscard(TGreater<uint64>(), false);
+			Sketch.HeapPush(Hash, TGreater<uint64>());
+		}
+	};
+
+	// chunk ends where gear hash of last bytes hits mask, so boundaries move together with content
+	constexpr uint64 FnvOffset = 0xCBF29CE484222325ull;
+	constexpr uint64 FnvPrime = 0x100000001B3ull;
+	uint64 Gear = 0;
+	uint64 ChunkHash = FnvOffset;
+	int32 ChunkLength = 0;
+
+	int64 Remaining = FileHandle->Size() - Offset;
+	while (Remaining > 0)
+	{
+		const int64 ReadSize = FMath::Min(Remaining, ChunkSize);
+		if (!FileHandle->Read(Buffer.GetData(), ReadSize)) return false;
+
+		for (int64 i = 0; i < ReadSize; ++i)
+		{
+			const uint8 Byte = Buffer[i];
+			Gear = (Gear << 1) + GearTable.Values[Byte];
+			ChunkHash = (ChunkHash ^ Byte) * FnvPrime;
+			++ChunkLength;
+
+			if (ChunkLength >= ContentChunkMinSize && ((Gear & ContentChunkBoundaryMask) == 0 || ChunkLength >= ContentChunkMaxSize))
+			{
+				AddChunkHash(ChunkHash);
+				ChunkHash = FnvOffset;
+				ChunkLength = 0;
+			}
+		}
+
+		Remaining -= ReadSize;
+	}
+
+	if (ChunkLength > 0)
+	{
+		AddChunkHash(ChunkHash);
+	}
+
+	Sketch.Sort();
+	OutSketch = MoveTemp(Sketch);
+	return true;
+}
+
+float FProjectCleanerDuplicateFinder::GetSimilarity(const TArray<uint64>& SketchA, const TArray<uint64>& SketchB)
+{
+	// bottom-k estimate, smallest hashes of union are checked for being in both sketches
+	int32 A = 0;
+	int32 B = 0;
+	int32 UnionNum = 0;
+	int32 SharedNum = 0;
+	while (UnionNum < ProjectCleanerDuplicates::SketchSize && (A < SketchA.Num() || B < SketchB.Num()))
+	{
+		if (B == SketchB.Num() || (A < SketchA.Num() && SketchA[A] < SketchB[B]))
+		{
+			++A;
+		}
+		else if (A == SketchA.Num() || SketchB[B] < SketchA[A])
+		{
+			++B;
+		}
+		else
+		{
+			++SharedNum;
+			++A;
+			++B;
+		}
+
+		++UnionNum;
+	}
+
+	return UnionNum > 0 ? static_cast<float>(SharedNum) / UnionNum : 0.0f;
+}
+
+void FProjectCleanerDuplicateFinder::FindNearDuplicates(const TArray<FAssetData>& Assets, const TArray<FCandidate>& Candidates, const TArray<int32>& NearCandidates, TArray<FCleanerDuplicateGroup>& OutGroups)
+{
+	using namespace ProjectCleanerDuplicates;
+
+	// only candidates sharing some chunk hash are compared, instead of every pair of same class
+	TMap<uint64, TArray<int32>> Postings;
+	for (const int32 Index : NearCandidates)
+	{
+		const FCachedContent& Content = Candidates[Index].Content;
+		if (!Content.bSketched) continue;
+
+		for (const uint64 Hash : Content.Sketch)
+		{
+			Postings.FindOrAdd(Hash).Add(Index);
+		}
+	}
+
+	// union find over candidate indices, similar pairs end up in one group
+	TArray<int32> Parents;
+	Parents.SetNumUninitialized(Candidates.Num());
+	for (int32 i = 0; i < Parents.Num(); ++i)
+	{
+		Parents[i] = i;
+	}
+
+	const auto FindRoot = [&] (int32 Index)
+	{
+		while (Parents[Index] != Index)
+		{
+			Parents[Index] = Parents[Parents[Index]];
+			Index = Parents[Index];
+		}
+
+		return Index;
+	};
+
+	TSet<uint64> ComparedPairs;
+	TArray<TTuple<int32, int32, float>> SimilarPairs;
+	for (const auto& Posting : Postings)
+	{
+		const TArray<int32>& Indices = Posting.Value;
+		if (Indices.Num() < 2 || Indices.Num() > MaxSketchPostingNum) continue;
+
+		for (int32 i = 0; i < Indices.Num(); ++i)
+		{
+			for (int32 j = i + 1; j < Indices.Num(); ++j)
+			{
+				const FCandidate& A = Candidates[Indices[i]];
+				const FCandidate& B = Candidates[Indices[j]];
+				if (Assets[A.AssetIndex].AssetClass != Assets[B.AssetIndex].AssetClass) continue;
+
+				const int64 SizeA = A.Content.FileSize - A.Content.HeaderSize;
+				const int64 SizeB = B.Content.FileSize - B.Content.HeaderSize;
+				if (FMath::Max(SizeA, SizeB) > FMath::Min(SizeA, SizeB) * (1.0f + NearSizeTolerance)) continue;
+
+				bool bAlreadyCompared = false;
+				ComparedPairs.Add(static_cast<uint64>(FMath::Min(Indices[i], Indices[j])) << 32 | static_cast<uint64>(FMath::Max(Indices[i], Indices[j])), &bAlreadyCompared);
+				if (bAlreadyCompared) continue;
+
+				const float Similarity = GetSimilarity(A.Content.Sketch, B.Content.Sketch);
+				if (Similarity < NearSimilarityThreshold) continue;
+
+				SimilarPairs.Emplace(Indices[i], Indices[j], Similarity);
+				Parents[FindRoot(Indices[i])] = FindRoot(Indices[j]);
+			}
+		}
+	}
+
+	TMap<int32, TArray<int32>> Groups;
+	TMap<int32, float> GroupSimilarities;
+	for (const auto& SimilarPair : SimilarPairs)
+	{
+		const int32 Root = FindRoot(SimilarPair.Get<0>());
+		float& GroupSimilarity = GroupSimilarities.FindOrAdd(Root, 1.0f);
+		GroupSimilarity = FMath::Min(GroupSimilarity, SimilarPair.Get<2>());
+
+		for (const int32 Index : {SimilarPair.Get<0>(), SimilarPair.Get<1>()})
+		{
+			Groups.FindOrAdd(Root).AddUnique(Index);
+		}
+	}
+
+	for (auto& Group : Groups)
+	{
+		// biggest package is the one kept, rest is reported as wasted
+		TArray<int32>& Indices = Group.Value;
+		Indices.Sort([&] (const int32 A, const int32 B)
+		{
+			return Candidates[A].Content.FileSize > Candidates[B].Content.FileSize;
+		});
+
+		const FCandidate& First = Candidates[Indices[0]];
+		FCleanerDuplicateGroup& NearGroup = OutGroups.AddDefaulted_GetRef();
+		NearGroup.AssetClass = Assets[First.AssetIndex].AssetClass;
+		NearGroup.ContentSize = First.Content.FileSize - First.Content.HeaderSize;
+		NearGroup.Similarity = GroupSimilarities.FindRef(Group.Key);
+		for (int32 i = 0; i < Indices.Num(); ++i)
+		{
+			const FCandidate& Candidate = Candidates[Indices[i]];
+			NearGroup.Assets.Add(Assets[Candidate.AssetIndex]);
+			if (i > 0)
+			{
+				NearGroup.WastedSize += Candidate.Content.FileSize;
+			}
+		}
+	}
+}
+
+bool FProjectCleanerDuplicateFinder::FindCachedContent(const FString& File, const FFileStatData& StatData, FCachedContent& OutContent) const
+{
+	const FCachedContent* CachedContent = Cache.Find(File);
+	if (CachedContent && CachedContent->FileSize == StatData.FileSize && CachedContent->ModificationTime == StatData.ModificationTime)
+	{
+		OutContent = *CachedContent;
+		return true;
+	}
+
+	OutContent = FCachedContent{};
+	OutContent.FileSize = StatData.FileSize;
+	OutContent.ModificationTime = StatData.ModificationTime;
+	return false;
+}
+
+void FProjectCleanerDuplicateFinder::LoadCache()
+{
+	if (bCacheLoaded) return;
+	bCacheLoaded = true;
+
+	const TUniquePtr<FArchive> Reader{IFileManager::Get().CreateFileReader(*GetDefaultCachePath())};
+	if (!Reader.IsValid()) return;
+
+	int32 Version = 0;
+	*Reader << Version;
+	if (Version != ProjectCleanerDuplicates::CacheVersion) return;
+
+	*Reader << Cache;
+
+	if (Reader->IsError())
+	{
+		Cache.Reset();
+	}
+}
@@ -240,6 +240,21 @@ const TArray<FAssetData>& FProjectCleanerManager::GetUnusedAssets() const
 	return DataManager.GetUnusedAssets();
 }
 
+const TSet<FName>& FProjectCleanerManager::GetUnusedPackages() const
+{
+	return DataManager.GetUnusedPackages();
+}
+
+int64 FProjectCleanerManager::GetTotalProjectSize() const
+{
+	return DataManager.GetTotalProjectSize();
+}
+
+int64 FProjectCleanerManager::GetTotalUnusedSize() const
+{
+	return DataManager.GetTotalUnusedSize();
+}
+
 const TSet<FName>& FProjectCleanerManager::GetExcludedAssets() const
 {
 	return DataManager.GetExcludedAssets();
@@ -250,11 +265,41 @@ const TSet<FName>& FProjectCleanerManager::GetCorruptedAssets() const
 	return DataManager.GetCorruptedAssets();
 }
 
+const TArray<FCleanerDuplicateGroup>& FProjectCleanerManager::GetDuplicateGroups() const
+{
+	return DataManager.GetDuplicateGroups();
+}
+
+const FCleanerTopK& FProjectCleanerManager::GetBiggestUnusedAssets() const
+{
+	return DataManager.GetBiggestUnusedAssets();
+}
+
+const FCleanerTopK& FProjectCleanerManager::GetBiggestNonEngineFiles() const
+{
+	return DataManager.GetBiggestNonEngineFiles();
+}
+
+const FCleanerTopK& FProjectCleanerManager::GetBiggestUnusedFolders() const
+{
+	return DataManager.GetBiggestUnusedFolders();
+}
+
 const TSet<FName>& FProjectCleanerManager::GetNonEngineFiles() const
 {
 	return DataManager.GetNonEngineFiles();
 }
 
+const TSet<FName>& FProjectCleanerManager::GetOrphanedFiles() const
+{
+	return DataManager.GetOrphanedFiles();
+}
+
+int64 FProjectCleanerManager::GetOrphanedFilesSize() const
+{
+	return DataManager.GetOrphanedFilesSize();
+}
+
 const TMap<FAssetData, FIndirectAsset>& FProjectCleanerManager::GetIndirectAssets() const
 {
 	return DataManager.GetIndirectAssets();
@@ -270,6 +315,21 @@ const TSet<FName>& FProjectCleanerManager::GetPrimaryAssetClasses() const
 	return DataManager.GetPrimaryAssetClasses();
 }
 
+const TMap<FName, FCleanerAggregateStats>& FProjectCleanerManager::GetFolderStats() const
+{
+	return DataManager.GetFolderStats();
+}
+
+const TMap<FName, FCleanerAggregateStats>& FProjectCleanerManager::GetClassStats() const
+{
+	return DataManager.GetClassStats();
+}
+
+const FCleanerAnalysisReport& FProjectCleanerManager::GetAnalysisReport() const
+{
+	return DataManager.GetAnalysisReport();
+}
+
 UCleanerConfigs* FProjectCleanerManager::GetCleanerConfigs() const
 {
 	return CleanerConfigs;
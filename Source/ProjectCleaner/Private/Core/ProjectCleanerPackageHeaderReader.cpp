@@ -0,0 +1,268 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "Core/ProjectCleanerPackageHeaderReader.h"
+#include "Core/ProjectCleanerStats.h"
+// Engine Headers
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/PackageName.h"
+#include "Serialization/MemoryReader.h"
+#include "UObject/ObjectResource.h"
+#include "UObject/PackageFileSummary.h"
+
+namespace ProjectCleanerPackageHeader
+{
+	/** Summary of editor package fits in it, rest of header is read with second call only when needed */
+	constexpr int64 SummaryReadSize = 4096;
+
+	/** Resolves serialized names through package name table, same way linker does */
+	class FHeaderArchive final : public FMemoryReader
+	{
+	public:
+		explicit FHeaderArchive(const TArray<uint8>& InBytes) : FMemoryReader(InBytes, true) {}
+
+		using FMemoryReader::operator<<;
+
+		virtual FArchive& operator<<(FName& Name) override
+		{
+			int32 NameIndex = 0;
+			int32 Number = 0;
+			*this << NameIndex << Number;
+
+			if (!Names.IsValidIndex(NameIndex))
+			{
+				SetError();
+				Name = NAME_None;
+				return *this;
+			}
+
+			Name = FName::CreateFromDisplayId(Names[NameIndex].GetDisplayIndex(), Number);
+			return *this;
+		}
+
+		virtual FString GetArchiveName() const override
+		{
+			return TEXT("ProjectCleanerPackageHeaderArchive");
+		}
+
+		TArray<FName> Names;
+	};
+
+	bool IsValidTable(const int32 Offset, const int32 Count, const int32 HeaderSize)
+	{
+		return Count == 0 || (Offset > 0 && Offset < HeaderSize && Count > 0);
+	}
+
+	/** "/Script/Engine" package import with "Actor" class import inside => "/Script/Engine.Actor" */
+	FName GetImportObjectPath(const TArray<FObjectImport>& Imports, const FPackageIndex Index)
+	{
+		if (!Index.IsImport() || !Imports.IsValidIndex(Index.ToImport())) return NAME_None;
+
+		const FObjectImport& Import = Imports[Index.ToImport()];
+		if (Import.OuterIndex.IsNull()) return Import.ObjectName;
+
+		const FName OuterPath = GetImportObjectPath(Imports, Import.OuterIndex);
+		if (OuterPath.IsNone()) return NAME_None;
+
+		return FName{*FString::Printf(TEXT("%s.%s"), *OuterPath.ToString(), *Import.ObjectName.ToString())};
+	}
+}
+
+FProjectCleanerPackageHeaderReader::FProjectCleanerPackageHeaderReader(const int32 InBatchSize) :
+	BatchSize(FMath::Max(1, InBatchSize))
+{
+}
+
+void FProjectCleanerPackageHeaderReader::Read(const TArray<FString>& PackageFiles, TArray<FCleanerPackageHeader>& OutHeaders) const
+{
+	PROJECTCLEANER_SCOPE(ReadPackageHeaders);
+
+	OutHeaders.Reset();
+	OutHeaders.SetNum(PackageFiles.Num());
+
+	// mount points are resolved here once, workers only do file reads and parsing
+	for (int32 i = 0; i < PackageFiles.Num(); ++i)
+	{
+		FString PackageName;
+		if (FPackageName::TryConvertFilenameToLongPackageName(PackageFiles[i], PackageName))
+		{
+			OutHeaders[i].PackageName = FName{*PackageName};
+		}
+	}
+
+	const int32 BatchesNum = FMath::DivideAndRoundUp(PackageFiles.Num(), BatchSize);
+	ParallelFor(BatchesNum, [&] (const int32 BatchIndex)
+	{
+		// header of next package overwrites previous one, so batch allocates about once
+		TArray<uint8> Buffer;
+
+		const int32 Start = BatchIndex * BatchSize;
+		const int32 End = FMath::Min(Start + BatchSize, PackageFiles.Num());
+		for (int32 i = Start; i < End; ++i)
+		{
+			FCleanerPackageHeader& Header = OutHeaders[i];
+			if (Header.PackageName.IsNone()) continue;
+
+			Header.bValid = ReadHeader(PackageFiles[i], Header, Buffer);
+		}
+	});
+}
+
+bool FProjectCleanerPackageHeaderReader::ReadHeader(const FString& PackageFile, FCleanerPackageHeader& OutHeader, TArray<uint8>& Buffer)
+{
+	using namespace ProjectCleanerPackageHeader;
+
+	const TUniquePtr<IFileHandle> FileHandle{FPlatformFileManager::Get().GetPlatformFile().OpenRead(*PackageFile)};
+	if (!FileHandle.IsValid()) return false;
+
+	OutHeader.FileSize = FileHandle->Size();
+
+	FPackageFileSummary Summary;
+	if (!ReadSummary(*FileHandle, Buffer, Summary)) return false;
+
+	// cooked packages are unversioned, their tables can not be read without loader
+	if (Summary.GetFileVersionUE4() == 0) return false;
+	if (Summary.TotalHeaderSize <= 0 || Summary.TotalHeaderSize > OutHeader.FileSize) return false;
+
+	if (Summary.TotalHeaderSize > Buffer.Num() && !ReadBytes(*FileHandle, Buffer, Summary.TotalHeaderSize - Buffer.Num())) return false;
+
+	const int32 HeaderSize = Summary.TotalHeaderSize;
+	if (!IsValidTable(Summary.NameOffset, Summary.NameCount, HeaderSize) ||
+		!IsValidTable(Summary.ImportOffset, Summary.ImportCount, HeaderSize) ||
+		!IsValidTable(Summary.ExportOffset, Summary.ExportCount, HeaderSize) ||
+		!IsValidTable(Summary.SoftPackageReferencesOffset, Summary.SoftPackageReferencesCount, HeaderSize))
+	{
+		return false;
+	}
+
+	FHeaderArchive Ar{Buffer};
+	Ar.SetUE4Ver(Summary.GetFileVersionUE4());
+	Ar.SetLicenseeUE4Ver(Summary.GetFileVersionLicenseeUE4());
+	Ar.SetEngineVer(Summary.SavedByEngineVersion);
+	Ar.SetCustomVersions(Summary.GetCustomVersionContainer());
+	Ar.SetFilterEditorOnly((Summary.PackageFlags & PKG_FilterEditorOnly) != 0);
+
+	Ar.Seek(Summary.NameOffset);
+	Ar.Names.Reserve(Summary.NameCount);
+	for (int32 i = 0; i < Summary.NameCount && !Ar.IsError(); ++i)
+	{
+		FNameEntrySerialized NameEntry{ENAME_LinkerConstructor};
+		Ar << NameEntry;
+		Ar.Names.Add(FName{NameEntry});
+	}
+
+	TArray<FObjectImport> Imports;
+	Imports.SetNum(Summary.ImportCount);
+	Ar.Seek(Summary.ImportOffset);
+	for (int32 i = 0; i < Imports.Num() && !Ar.IsError(); ++i)
+	{
+		Ar << Imports[i];
+	}
+
+	TArray<FObjectExport> Exports;
+	Exports.SetNum(Summary.ExportCount);
+	Ar.Seek(Summary.ExportOffset);
+	for (int32 i = 0; i < Exports.Num() && !Ar.IsError(); ++i)
+	{
+		Ar << Exports[i];
+	}
+
+	if (Ar.IsError()) return false;
+
+	OutHeader.Dependencies.Reset();
+	const auto AddDependency = [&] (const FName Dependency)
+	{
+		if (Dependency.IsNone() || Dependency == OutHeader.PackageName) return;
+		if (Dependency.ToString().StartsWith(TEXT("/Script/"))) return;
+
+		OutHeader.Dependencies.AddUnique(Dependency);
+	};
+
+	// top level imports are packages
+	for (const auto& Import : Imports)
+	{
+		if (Import.OuterIndex.IsNull())
+		{
+			AddDependency(Import.ObjectName);
+		}
+	}
+
+	Ar.Seek(Summary.SoftPackageReferencesOffset);
+	for (int32 i = 0; i < Summary.SoftPackageReferencesCount && !Ar.IsError(); ++i)
+	{
+		FName SoftReference;
+		if (Ar.UE4Ver() < VER_UE4_ADDED_SOFT_OBJECT_PATH)
+		{
+			FString SoftReferenceString;
+			Ar << SoftReferenceString;
+			SoftReference = FName{*SoftReferenceString};
+		}
+		else
+		{
+			Ar << SoftReference;
+		}
+
+		AddDependency(SoftReference);
+	}
+
+	if (Ar.IsError()) return false;
+
+	const auto GetClassName = [&] (const FPackageIndex ClassIndex)
+	{
+		if (ClassIndex.IsImport() && Imports.IsValidIndex(ClassIndex.ToImport())) return Imports[ClassIndex.ToImport()].ObjectName;
+		if (ClassIndex.IsExport() && Exports.IsValidIndex(ClassIndex.ToExport())) return Exports[ClassIndex.ToExport()].ObjectName;
+		return NAME_Class;
+	};
+
+	// assets are public top level exports, except classes and their default objects
+	OutHeader.Assets.Reset();
+	for (const auto& Export : Exports)
+	{
+		if (!Export.OuterIndex.IsNull()) continue;
+		if ((Export.ObjectFlags & RF_Public) == 0 || (Export.ObjectFlags & RF_ClassDefaultObject) != 0) continue;
+
+		const FName ClassName = GetClassName(Export.ClassIndex);
+		if (ClassName == NAME_Class || ClassName.ToString().EndsWith(TEXT("GeneratedClass"))) continue;
+
+		FCleanerPackageHeaderAsset& Asset = OutHeader.Assets.AddDefaulted_GetRef();
+		Asset.AssetName = Export.ObjectName;
+		Asset.AssetClass = ClassName;
+
+		// blueprint generated class is exported next to blueprint, with "_C" suffix
+		const FString GeneratedClassName = Export.ObjectName.ToString() + TEXT("_C");
+		const FObjectExport* GeneratedClass = Exports.FindByPredicate([&] (const FObjectExport& Other)
+		{
+			return Other.OuterIndex.IsNull() && Other.ObjectName.ToString().Equals(GeneratedClassName);
+		});
+
+		if (GeneratedClass)
+		{
+			Asset.GeneratedClass = FName{*FString::Printf(TEXT("%s.%s"), *OutHeader.PackageName.ToString(), *GeneratedClassName)};
+			Asset.ParentClass = GetImportObjectPath(Imports, GeneratedClass->SuperIndex);
+		}
+	}
+
+	return true;
+}
+
+bool FProjectCleanerPackageHeaderReader::ReadSummary(IFileHandle& FileHandle, TArray<uint8>& Buffer, FPackageFileSummary& OutSummary)
+{
+	Buffer.Reset();
+	FileHandle.Seek(0);
+	if (!ReadBytes(FileHandle, Buffer, FMath::Min(ProjectCleanerPackageHeader::SummaryReadSize, FileHandle.Size()))) return false;
+
+	FMemoryReader SummaryReader{Buffer};
+	SummaryReader << OutSummary;
+
+	return !SummaryReader.IsError() && OutSummary.Tag == PACKAGE_FILE_TAG;
+}
+
+bool FProjectCleanerPackageHeaderReader::ReadBytes(IFileHandle& FileHandle, TArray<uint8>& Buffer, const int64 Num)
+{
+	if (Num <= 0 || Num > MAX_int32 - Buffer.Num()) return false;
+
+	const int32 Start = Buffer.Num();
+	Buffer.AddUninitialized(static_cast<int32>(Num));
+
+	return FileHandle.Read(Buffer.GetData() + Start, Num);
+}
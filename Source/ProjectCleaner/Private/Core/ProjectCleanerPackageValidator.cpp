@@ -0,0 +1,167 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "Core/ProjectCleanerPackageValidator.h"
+#include "ProjectCleaner.h"
+#include "Core/ProjectCleanerPackageHeaderReader.h"
+#include "Core/ProjectCleanerStats.h"
+#include "Core/ProjectCleanerUtility.h"
+// Engine Headers
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/Paths.h"
+#include "UObject/PackageFileSummary.h"
+
+namespace ProjectCleanerPackageValidation
+{
+	/** Increased whenever checks change, so results of old checks are not reused */
+	constexpr int32 CacheVersion = 1;
+}
+
+FProjectCleanerPackageValidator::FProjectCleanerPackageValidator(const int32 InBatchSize) :
+	BatchSize(FMath::Max(1, InBatchSize)),
+	bCacheLoaded(false)
+{
+}
+
+void FProjectCleanerPackageValidator::Validate(const TArray<FString>& PackageFiles, TArray<FString>& OutErrors)
+{
+	PROJECTCLEANER_SCOPE(ValidatePackages);
+
+	LoadCache();
+
+	OutErrors.Reset();
+	OutErrors.SetNum(PackageFiles.Num());
+
+	TArray<FFileStatData> StatData;
+	StatData.SetNum(PackageFiles.Num());
+
+	// cache is only read here, new results are added after all batches are done
+	TBitArray<> Validated{false, PackageFiles.Num()};
+	const int32 BatchesNum = FMath::DivideAndRoundUp(PackageFiles.Num(), BatchSize);
+	ParallelFor(BatchesNum, [&] (const int32 BatchIndex)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		TArray<uint8> Buffer;
+
+		const int32 Start = BatchIndex * BatchSize;
+		const int32 End = FMath::Min(Start + BatchSize, PackageFiles.Num());
+		for (int32 i = Start; i < End; ++i)
+		{
+			StatData[i] = PlatformFile.GetStatData(*PackageFiles[i]);
+
+			const FCachedResult* CachedResult = Cache.Find(PackageFiles[i]);
+			if (CachedResult && CachedResult->FileSize == StatData[i].FileSize && CachedResult->ModificationTime == StatData[i].ModificationTime)
+			{
+				OutErrors[i] = CachedResult->Error;
+				continue;
+			}
+
+			OutErrors[i] = ValidatePackage(PackageFiles[i], Buffer);
+		}
+	});
+
+	int32 ReadFilesNum = 0;
+	for (int32 i = 0; i < PackageFiles.Num(); ++i)
+	{
+		if (!StatData[i].bIsValid) continue;
+
+		FCachedResult& CachedResult = Cache.FindOrAdd(PackageFiles[i]);
+		if (CachedResult.FileSize == StatData[i].FileSize && CachedResult.ModificationTime == StatData[i].ModificationTime) continue;
+
+		CachedResult.FileSize = StatData[i].FileSize;
+		CachedResult.ModificationTime = StatData[i].ModificationTime;
+		CachedResult.Error = OutErrors[i];
+		++ReadFilesNum;
+	}
+
+	UE_LOG(LogProjectCleaner, Display, TEXT("Package validation: %d packages, %d read, %d cached"), PackageFiles.Num(), ReadFilesNum, PackageFiles.Num() - ReadFilesNum);
+}
+
+bool FProjectCleanerPackageValidator::SaveCache()
+{
+	// several read only runs may share project, each replaces whole file
+	return ProjectCleanerUtility::SaveFileAtomically(GetDefaultCachePath(), [&] (FArchive& Writer)
+	{
+		int32 Version = ProjectCleanerPackageValidation::CacheVersion;
+		Writer << Version;
+		Writer << Cache;
+	});
+}
+
+FString FProjectCleanerPackageValidator::GetDefaultCachePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("ProjectCleaner") / TEXT("PackageValidationCache.bin");
+}
+
+FString FProjectCleanerPackageValidator::ValidatePackage(const FString& PackageFile, TArray<uint8>& Buffer)
+{
+	const TUniquePtr<IFileHandle> FileHandle{FPlatformFileManager::Get().GetPlatformFile().OpenRead(*PackageFile)};
+	if (!FileHandle.IsValid()) return TEXT("Can not open file");
+
+	const int64 FileSize = FileHandle->Size();
+	if (FileSize == 0) return TEXT("Empty file");
+
+	FPackageFileSummary Summary;
+	if (!FProjectCleanerPackageHeaderReader::ReadSummary(*FileHandle, Buffer, Summary))
+	{
+		return TEXT("Invalid package tag or truncated summary");
+	}
+
+	if (Summary.GetFileVersionUE4() != 0)
+	{
+		if (Summary.GetFileVersionUE4() < VER_UE4_OLDEST_LOADABLE_PACKAGE)
+		{
+			return FString::Printf(TEXT("Package version %d is too old"), Summary.GetFileVersionUE4());
+		}
+
+		if (Summary.GetFileVersionUE4() > GPackageFileUE4Version || Summary.GetFileVersionLicenseeUE4() > GPackageFileLicenseeUE4Version)
+		{
+			return FString::Printf(TEXT("Package version %d is newer than engine version %d"), Summary.GetFileVersionUE4(), GPackageFileUE4Version);
+		}
+	}
+
+	if (Summary.TotalHeaderSize <= 0 || Summary.TotalHeaderSize > FileSize)
+	{
+		return FString::Printf(TEXT("Header size %d does not fit in file size %lld"), Summary.TotalHeaderSize, FileSize);
+	}
+
+	if (Summary.BulkDataStartOffset > FileSize)
+	{
+		return FString::Printf(TEXT("Bulk data offset %lld is past file size %lld"), Summary.BulkDataStartOffset, FileSize);
+	}
+
+	// package is saved with tag as last 4 bytes, missing tag means file was cut
+	uint32 EndTag = 0;
+	if (FileSize < static_cast<int64>(sizeof(EndTag)) || !FileHandle->Seek(FileSize - sizeof(EndTag)) || !FileHandle->Read(reinterpret_cast<uint8*>(&EndTag), sizeof(EndTag)))
+	{
+		return TEXT("Failed to read end of file");
+	}
+
+	if (EndTag != PACKAGE_FILE_TAG)
+	{
+		return TEXT("Package tag missing at end of file, file is truncated");
+	}
+
+	return FString{};
+}
+
+void FProjectCleanerPackageValidator::LoadCache()
+{
+	if (bCacheLoaded) return;
+	bCacheLoaded = true;
+
+	const TUniquePtr<FArchive> Reader{IFileManager::Get().CreateFileReader(*GetDefaultCachePath())};
+	if (!Reader.IsValid()) return;
+
+	int32 Version = 0;
+	*Reader << Version;
+	if (Version != ProjectCleanerPackageValidation::CacheVersion) return;
+
+	*Reader << Cache;
+
+	if (Reader->IsError())
+	{
+		Cache.Reset();
+	}
+}
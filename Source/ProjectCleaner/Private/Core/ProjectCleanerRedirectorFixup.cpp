@@ -0,0 +1,292 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "Core/ProjectCleanerRedirectorFixup.h"
+#include "ProjectCleaner.h"
+#include "ProjectCleanerAnalysisCore.h"
+#include "Core/ProjectCleanerStats.h"
+// Engine Headers
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "FileHelpers.h"
+#include "ObjectTools.h"
+#include "Misc/ScopedSlowTask.h"
+#include "UObject/ObjectRedirector.h"
+#include "UObject/UObjectGlobals.h"
+
+FProjectCleanerRedirectorFixup::FProjectCleanerRedirectorFixup(const FName InRootPath, const int32 InBatchSize) :
+	RootPath(InRootPath),
+	RootPathPrefix(InRootPath.ToString() + TEXT("/")),
+	BatchSize(FMath::Max(1, InBatchSize))
+{
+}
+
+FCleanerRedirectorFixupResult FProjectCleanerRedirectorFixup::Run() const
+{
+	PROJECTCLEANER_SCOPE(RedirectorFixup);
+
+	FCleanerRedirectorFixupResult Result;
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	Filter.PackagePaths.Emplace(RootPath);
+	Filter.ClassNames.Emplace(UObjectRedirector::StaticClass()->GetFName());
+
+	TArray<FAssetData> Redirectors;
+	AssetRegistry.GetAssets(Filter, Redirectors);
+	PROJECTCLEANER_COUNTER_ADD(RegistryQueries, 1);
+
+	Result.RedirectorsNum = Redirectors.Num();
+	if (Redirectors.Num() == 0) return Result;
+
+	TMap<FName, int32> RedirectorIndices;
+	RedirectorIndices.Reserve(Redirectors.Num());
+	for (int32 i = 0; i < Redirectors.Num(); ++i)
+	{
+		RedirectorIndices.Add(Redirectors[i].PackageName, i);
+	}
+
+	// every referencing package is listed once, no matter how many redirectors it uses
+	TArray<FName> Referencers;
+	TMap<FName, int32> ReferencerIndices;
+	TArray<TArray<int32>> RedirectorReferencers;
+	TArray<TArray<int32>> ReferencingRedirectors;
+	RedirectorReferencers.SetNum(Redirectors.Num());
+	ReferencingRedirectors.SetNum(Redirectors.Num());
+
+	// redirectors used by packages we can not resave must stay
+	TBitArray<> KeptRedirectors{false, Redirectors.Num()};
+
+	TArray<FName> Refs;
+	for (int32 i = 0; i < Redirectors.Num(); ++i)
+	{
+		Refs.Reset();
+		AssetRegistry.GetReferencers(Redirectors[i].PackageName, Refs);
+		PROJECTCLEANER_COUNTER_ADD(RegistryQueries, 1);
+
+		for (const auto& Ref : Refs)
+		{
+			if (const int32* RedirectorIndex = RedirectorIndices.Find(Ref))
+			{
+				ReferencingRedirectors[i].Add(*RedirectorIndex);
+				continue;
+			}
+
+			if (!IsUnderRootPath(Ref))
+			{
+				KeptRedirectors[i] = true;
+				continue;
+			}
+
+			const int32* ReferencerIndex = ReferencerIndices.Find(Ref);
+			if (!ReferencerIndex)
+			{
+				ReferencerIndex = &ReferencerIndices.Add(Ref, Referencers.Num());
+				Referencers.Add(Ref);
+			}
+
+			RedirectorReferencers[i].Add(*ReferencerIndex);
+		}
+	}
+
+	Result.ReferencersNum = Referencers.Num();
+
+	TArray<TPair<int32, int32>> Edges;
+	TArray<FName> Deps;
+	for (int32 Node = 0; Node < Referencers.Num(); ++Node)
+	{
+		Deps.Reset();
+		AssetRegistry.GetDependencies(Referencers[Node], Deps);
+		PROJECTCLEANER_COUNTER_ADD(RegistryQueries, 1);
+
+		for (const auto& Dep : Deps)
+		{
+			const int32* DepNode = ReferencerIndices.Find(Dep);
+			if (DepNode && *DepNode != Node)
+			{
+				Edges.Emplace(Node, *DepNode);
+			}
+		}
+	}
+
+	FCleanerDependencyGraph Graph;
+	Graph.Build(Referencers.Num(), Edges);
+
+	// planner keeps node after its referencers, on reversed graph that means after its dependencies
+	TArray<TArray<int32>> Batches;
+	FCleanerDeletionPlanner::Plan(Graph.Reverse(), TBitArray<>{true, Referencers.Num()}, BatchSize, Batches);
+
+	FScopedSlowTask SlowTask{
+		static_cast<float>(Batches.Num() + 1),
+		FText::FromString(FStandardCleanerText::FixingUpRedirectors)
+	};
+	SlowTask.MakeDialog();
+
+	TArray<FName> PackageNames;
+	TArray<UPackage*> Packages;
+
+	// soft references are fixed up on save only when redirector they point to is in memory,
+	// so every redirector is loaded before first referencer is resaved and rooted until the end, surviving GC between batches
+	TArray<UObject*> LoadedRedirectors;
+	LoadedRedirectors.Init(nullptr, Redirectors.Num());
+	for (int32 BatchStart = 0; BatchStart < Redirectors.Num(); BatchStart += BatchSize)
+	{
+		const int32 BatchEnd = FMath::Min(BatchStart + BatchSize, Redirectors.Num());
+
+		PackageNames.Reset();
+		for (int32 i = BatchStart; i < BatchEnd; ++i)
+		{
+			PackageNames.Add(Redirectors[i].PackageName);
+		}
+
+		LoadPackages(PackageNames, Packages);
+
+		for (int32 i = BatchStart; i < BatchEnd; ++i)
+		{
+			if (UObject* Redirector = Redirectors[i].FastGetAsset(false))
+			{
+				Redirector->AddToRoot();
+				LoadedRedirectors[i] = Redirector;
+			}
+		}
+	}
+
+	TBitArray<> SavedReferencers{false, Referencers.Num()};
+	TArray<UPackage*> LoadedPackages;
+	TArray<UPackage*> FailedPackages;
+	TSet<UPackage*> FailedPackagesSet;
+	for (const auto& Batch : Batches)
+	{
+		SlowTask.EnterProgressFrame();
+
+		PackageNames.Reset();
+		for (const int32 Node : Batch)
+		{
+			PackageNames.Add(Referencers[Node]);
+		}
+
+		LoadPackages(PackageNames, Packages);
+
+		LoadedPackages.Reset();
+		for (UPackage* Package : Packages)
+		{
+			if (Package)
+			{
+				LoadedPackages.Add(Package);
+			}
+		}
+
+		FailedPackages.Reset();
+		if (LoadedPackages.Num() > 0)
+		{
+			FEditorFileUtils::PromptForCheckoutAndSave(LoadedPackages, false, false, &FailedPackages);
+		}
+
+		FailedPackagesSet.Reset();
+		FailedPackagesSet.Append(FailedPackages);
+
+		for (int32 i = 0; i < Batch.Num(); ++i)
+		{
+			if (Packages[i] && !FailedPackagesSet.Contains(Packages[i]))
+			{
+				SavedReferencers[Batch[i]] = true;
+				++Result.SavedPackagesNum;
+			}
+			else
+			{
+				UE_LOG(LogProjectCleaner, Warning, TEXT("Failed to resave %s, redirectors it uses are kept"), *Referencers[Batch[i]].ToString());
+				++Result.FailedPackagesNum;
+			}
+		}
+
+		// batch is saved, so none of its packages are needed anymore
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	for (int32 i = 0; i < Redirectors.Num(); ++i)
+	{
+		for (const int32 Referencer : RedirectorReferencers[i])
+		{
+			if (!SavedReferencers[Referencer])
+			{
+				KeptRedirectors[i] = true;
+				break;
+			}
+		}
+	}
+
+	// redirector in middle of chain is still used by kept redirector before it
+	bool bChanged = true;
+	while (bChanged)
+	{
+		bChanged = false;
+		for (int32 i = 0; i < Redirectors.Num(); ++i)
+		{
+			if (KeptRedirectors[i]) continue;
+
+			for (const int32 ReferencingRedirector : ReferencingRedirectors[i])
+			{
+				if (KeptRedirectors[ReferencingRedirector])
+				{
+					KeptRedirectors[i] = true;
+					bChanged = true;
+					break;
+				}
+			}
+		}
+	}
+
+	SlowTask.EnterProgressFrame();
+
+	// redirectors are already in memory, all deletable ones go away with single call
+	TArray<UObject*> RedirectorObjects;
+	RedirectorObjects.Reserve(Redirectors.Num());
+	for (int32 i = 0; i < Redirectors.Num(); ++i)
+	{
+		if (!LoadedRedirectors[i]) continue;
+
+		LoadedRedirectors[i]->RemoveFromRoot();
+		if (!KeptRedirectors[i])
+		{
+			RedirectorObjects.Add(LoadedRedirectors[i]);
+		}
+	}
+
+	// referencers were checked above, so reference search of regular delete is not needed
+	if (RedirectorObjects.Num() > 0)
+	{
+		Result.DeletedRedirectorsNum = ObjectTools::DeleteObjectsUnchecked(RedirectorObjects);
+	}
+
+	UE_LOG(LogProjectCleaner, Display, TEXT("Redirectors fixup: %d redirectors, %d referencers, %d saved, %d failed, %d redirectors deleted"),
+		Result.RedirectorsNum,
+		Result.ReferencersNum,
+		Result.SavedPackagesNum,
+		Result.FailedPackagesNum,
+		Result.DeletedRedirectorsNum
+	);
+
+	return Result;
+}
+
+void FProjectCleanerRedirectorFixup::LoadPackages(const TArray<FName>& PackageNames, TArray<UPackage*>& OutPackages)
+{
+	PROJECTCLEANER_SCOPE(LoadPackages);
+
+	for (const auto& PackageName : PackageNames)
+	{
+		LoadPackageAsync(PackageName.ToString());
+	}
+
+	FlushAsyncLoading();
+
+	OutPackages.Reset(PackageNames.Num());
+	for (const auto& PackageName : PackageNames)
+	{
+		OutPackages.Add(FindPackage(nullptr, *PackageName.ToString()));
+	}
+}
+
+bool FProjectCleanerRedirectorFixup::IsUnderRootPath(const FName PackageName) const
+{
+	return PackageName.ToString().StartsWith(RootPathPrefix);
+}
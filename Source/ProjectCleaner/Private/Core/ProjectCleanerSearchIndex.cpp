@@ -0,0 +1,118 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "Core/ProjectCleanerSearchIndex.h"
+
+void FProjectCleanerSearchIndex::Build(const TArray<FString>& InEntries)
+{
+	Reset();
+
+	Entries.Reserve(InEntries.Num());
+	for (const auto& Entry : InEntries)
+	{
+		Entries.Add(Entry.ToLower());
+	}
+
+	for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+	{
+		const FString& Entry = Entries[EntryIndex];
+		for (int32 i = 0; i + 3 <= Entry.Len(); ++i)
+		{
+			// entries visited in order, so posting lists stay sorted and checking last element is enough to skip duplicates
+			TArray<int32>& Posting = Postings.FindOrAdd(MakeTrigram(*Entry + i));
+			if (Posting.Num() == 0 || Posting.Last() != EntryIndex)
+			{
+				Posting.Add(EntryIndex);
+			}
+		}
+	}
+
+	for (auto& Posting : Postings)
+	{
+		Posting.Value.Shrink();
+	}
+}
+
+void FProjectCleanerSearchIndex::Reset()
+{
+	Entries.Reset();
+	Postings.Reset();
+}
+
+void FProjectCleanerSearchIndex::Query(const FString& SearchText, TArray<int32>& OutIndices) const
+{
+	OutIndices.Reset();
+
+	const FString Text = SearchText.ToLower();
+	if (Text.IsEmpty()) return;
+
+	// too short for trigrams, falling back to linear scan
+	if (Text.Len() < 3)
+	{
+		for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+		{
+			if (Entries[EntryIndex].Contains(Text, ESearchCase::CaseSensitive))
+			{
+				OutIndices.Add(EntryIndex);
+			}
+		}
+		return;
+	}
+
+	TArray<const TArray<int32>*> Lists;
+	for (int32 i = 0; i + 3 <= Text.Len(); ++i)
+	{
+		const TArray<int32>* Posting = Postings.Find(MakeTrigram(*Text + i));
+		if (!Posting) return;
+
+		Lists.AddUnique(Posting);
+	}
+
+	// intersecting from smallest list keeps candidates set small
+	Lists.Sort([] (const TArray<int32>& A, const TArray<int32>& B)
+	{
+		return A.Num() < B.Num();
+	});
+
+	TArray<int32> Candidates = *Lists[0];
+	for (int32 ListIndex = 1; ListIndex < Lists.Num() && Candidates.Num() > 0; ++ListIndex)
+	{
+		const TArray<int32>& Posting = *Lists[ListIndex];
+		int32 Write = 0;
+		int32 j = 0;
+		for (const int32 Candidate : Candidates)
+		{
+			while (j < Posting.Num() && Posting[j] < Candidate)
+			{
+				++j;
+			}
+			if (j == Posting.Num()) break;
+			if (Posting[j] == Candidate)
+			{
+				Candidates[Write++] = Candidate;
+			}
+		}
+		Candidates.SetNum(Write, false);
+	}
+
+	// trigrams can match in different positions, so candidates must be verified
+	OutIndices.Reserve(Candidates.Num());
+	for (const int32 Candidate : Candidates)
+	{
+		if (Entries[Candidate].Contains(Text, ESearchCase::CaseSensitive))
+		{
+			OutIndices.Add(Candidate);
+		}
+	}
+}
+
+int32 FProjectCleanerSearchIndex::Num() const
+{
+	return Entries.Num();
+}
+
+uint64 FProjectCleanerSearchIndex::MakeTrigram(const TCHAR* Chars)
+{
+	// 21 bits is enough for any unicode code point
+	constexpr uint64 Mask = 0x1FFFFF;
+	return ((static_cast<uint64>(Chars[0]) & Mask) << 42) | ((static_cast<uint64>(Chars[1]) & Mask) << 21) | (static_cast<uint64>(Chars[2]) & Mask);
+}
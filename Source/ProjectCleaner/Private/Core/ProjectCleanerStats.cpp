@@ -0,0 +1,21 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "Core/ProjectCleanerStats.h"
+
+UE_TRACE_CHANNEL_DEFINE(ProjectCleanerChannel);
+
+DEFINE_STAT(STAT_ProjectCleaner_FilesVisited);
+DEFINE_STAT(STAT_ProjectCleaner_RegistryQueries);
+DEFINE_STAT(STAT_ProjectCleaner_DependencyEdges);
+DEFINE_STAT(STAT_ProjectCleaner_BytesScanned);
+DEFINE_STAT(STAT_ProjectCleaner_AssetsDeleted);
+DEFINE_STAT(STAT_ProjectCleaner_AssetsDeletedPerSecond);
+
+TRACE_DECLARE_INT_COUNTER(ProjectCleaner_FilesVisited, TEXT("ProjectCleaner/FilesVisited"));
+TRACE_DECLARE_INT_COUNTER(ProjectCleaner_RegistryQueries, TEXT("ProjectCleaner/RegistryQueries"));
+TRACE_DECLARE_INT_COUNTER(ProjectCleaner_DependencyEdges, TEXT("ProjectCleaner/DependencyEdges"));
+TRACE_DECLARE_INT_COUNTER(ProjectCleaner_BytesScanned, TEXT("ProjectCleaner/BytesScanned"));
+TRACE_DECLARE_INT_COUNTER(ProjectCleaner_AssetsDeleted, TEXT("ProjectCleaner/AssetsDeleted"));
+TRACE_DECLARE_FLOAT_COUNTER(ProjectCleaner_AssetsDeletedPerSecond, TEXT("ProjectCleaner/AssetsDeletedPerSecond"));
+
+LLM_DEFINE_TAG(ProjectCleaner);
@@ -1,6 +1,9 @@
 ﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
 
 #include "Core/ProjectCleanerUtility.h"
+#include "ProjectCleaner.h"
+#include "Core/ProjectCleanerStats.h"
+#include "ProjectCleanerAnalysisCore.h"
 // Engine Headers
 #include "ObjectTools.h"
 #include "FileHelpers.h"
@@ -11,22 +14,11 @@
 #include "Misc/Paths.h"
 #include "Misc/FileHelper.h"
 #include "Misc/ScopedSlowTask.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Serialization/LargeMemoryReader.h"
+#include "Serialization/MemoryReader.h"
 #include "Editor/ContentBrowser/Public/ContentBrowserModule.h"
-#include "Internationalization/Regex.h"
-
-int64 ProjectCleanerUtility::GetTotalSize(const TArray<FAssetData>& Assets)
-{
-	const FAssetRegistryModule& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName);
-	int64 Size = 0;
-	for (const auto& Asset : Assets)
-	{
-		const auto AssetPackageData = AssetRegistry.Get().GetAssetPackageData(Asset.PackageName);
-		if (!AssetPackageData) continue;
-		Size += AssetPackageData->DiskSize;
-	}
-
-	return Size;
-}
 
 FName ProjectCleanerUtility::GetClassName(const FAssetData& AssetData)
 {
@@ -71,6 +63,17 @@ FText ProjectCleanerUtility::GetDeletionProgressText(const int32 DeletedAssetNum
 	);
 }
 
+FText ProjectCleanerUtility::GetFootprintText(const FCleanerFootprint& Footprint)
+{
+	return FText::Format(
+		FText::FromString(TEXT("Pulls in {0} in {1} packages\nExclusively own {2} in {3} packages")),
+		FText::AsMemory(Footprint.TransitiveSize),
+		FText::AsNumber(Footprint.TransitiveNum),
+		FText::AsMemory(Footprint.ExclusiveSize),
+		FText::AsNumber(Footprint.ExclusiveNum)
+	);
+}
+
 FString ProjectCleanerUtility::ConvertAbsolutePathToInternal(const FString& InPath)
 {
 	FString Path = InPath;
@@ -89,6 +92,7 @@ FString ProjectCleanerUtility::ConvertInternalToAbsolutePath(const FString& InPa
 
 bool ProjectCleanerUtility::FindEmptyFoldersInPath(const FString& FolderPath, TSet<FName>& EmptyFolders)
 {
+	// recursive, timed as whole by FindEmptyFolders scope of caller
 	bool IsSubFoldersEmpty = true;
 	TArray<FString> SubFolders;
 	IFileManager::Get().FindFiles(SubFolders, *FolderPath, false, true);
@@ -112,6 +116,7 @@ bool ProjectCleanerUtility::FindEmptyFoldersInPath(const FString& FolderPath, TS
 
 	TArray<FString> FilesInFolder;
 	IFileManager::Get().FindFiles(FilesInFolder, *FolderPath, true, false);
+	PROJECTCLEANER_COUNTER_ADD(FilesVisited, SubFolders.Num() + FilesInFolder.Num());
 
 	if (IsSubFoldersEmpty && FilesInFolder.Num() == 0)
 	{
@@ -123,22 +128,23 @@ bool ProjectCleanerUtility::FindEmptyFoldersInPath(const FString& FolderPath, TS
 
 bool ProjectCleanerUtility::IsEngineExtension(const FString& Extension)
 {
-	return Extension.Equals("uasset") || Extension.Equals("umap");
+	// rules are shared with standalone analyzer, so both sort content files same way
+	return FCleanerContentFiles::IsPackageExtension(Extension);
 }
 
-bool ProjectCleanerUtility::IsUnderMegascansFolder(const FAssetData& AssetData)
+bool ProjectCleanerUtility::IsEngineCompanionExtension(const FString& Extension)
 {
-	return AssetData.PackagePath.ToString().StartsWith(TEXT("/Game/MSPresets"));
+	return FCleanerContentFiles::IsCompanionExtension(Extension);
 }
 
-bool ProjectCleanerUtility::HasIndirectlyUsedAssets(const FString& FileContent)
+FString ProjectCleanerUtility::GetPackageFileStem(const FString& FilePath)
 {
-	if (FileContent.IsEmpty()) return false;
-	
-	// search any sub string that has asset package path in it
-	static FRegexPattern Pattern(TEXT(R"(\/Game([A-Za-z0-9_.\/]+)\b)"));
-	FRegexMatcher Matcher(Pattern, FileContent);
-	return Matcher.FindNext();
+	return FCleanerContentFiles::GetPackageFileStem(FilePath);
+}
+
+bool ProjectCleanerUtility::IsUnderMegascansFolder(const FAssetData& AssetData)
+{
+	return AssetData.PackagePath.ToString().StartsWith(TEXT("/Game/MSPresets"));
 }
 
 FString ProjectCleanerUtility::ConvertPathInternal(const FString& From, const FString To, const FString& Path)
@@ -148,6 +154,8 @@ FString ProjectCleanerUtility::ConvertPathInternal(const FString& From, const FS
 
 int32 ProjectCleanerUtility::DeleteAssets(TArray<FAssetData>& Assets, const bool ForceDelete)
 {
+	PROJECTCLEANER_SCOPE(DeleteAssets);
+
 	const int32 GivenAssetsNum = Assets.Num();
 	// first try to delete normally
 	int32 DeletedAssets = ObjectTools::DeleteAssets(Assets, false);
@@ -173,6 +181,8 @@ int32 ProjectCleanerUtility::DeleteAssets(TArray<FAssetData>& Assets, const bool
 
 void ProjectCleanerUtility::SaveAllAssets(const bool PromptUser = true)
 {
+	PROJECTCLEANER_SCOPE(SaveAllAssets);
+
 	FEditorFileUtils::SaveDirtyPackages(
 		PromptUser,
 		true,
@@ -185,6 +195,8 @@ void ProjectCleanerUtility::SaveAllAssets(const bool PromptUser = true)
 
 void ProjectCleanerUtility::UpdateAssetRegistry(bool bSyncScan = false)
 {
+	PROJECTCLEANER_SCOPE(UpdateAssetRegistry);
+
 	const FAssetRegistryModule& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName);
 	
 	TArray<FString> ScanFolders;
@@ -194,6 +206,80 @@ void ProjectCleanerUtility::UpdateAssetRegistry(bool bSyncScan = false)
 	AssetRegistry.Get().SearchAllAssets(bSyncScan);
 }
 
+bool ProjectCleanerUtility::SaveFileAtomically(const FString& FilePath, TFunctionRef<void(FArchive&)> Serialize)
+{
+	// same folder as target, so rename never crosses volumes
+	const FString TempFilePath = FString::Printf(TEXT("%s.%s.tmp"), *FilePath, *FGuid::NewGuid().ToString());
+
+	{
+		const TUniquePtr<FArchive> Writer{IFileManager::Get().CreateFileWriter(*TempFilePath)};
+		if (!Writer.IsValid()) return false;
+
+		Serialize(*Writer);
+
+		if (!Writer->Close())
+		{
+			IFileManager::Get().Delete(*TempFilePath, false, true, true);
+			return false;
+		}
+	}
+
+	if (!IFileManager::Get().Move(*FilePath, *TempFilePath, true, true))
+	{
+		IFileManager::Get().Delete(*TempFilePath, false, true, true);
+		return false;
+	}
+
+	return true;
+}
+
+bool ProjectCleanerUtility::LoadAssetRegistryFromFile(const FString& FilePath)
+{
+	PROJECTCLEANER_SCOPE(LoadAssetRegistryFromFile);
+
+	// file is mapped instead of read, registry state is deserialized straight from page cache
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const TUniquePtr<IMappedFileHandle> MappedFile{PlatformFile.OpenMapped(*FilePath)};
+	const TUniquePtr<IMappedFileRegion> MappedRegion{MappedFile.IsValid() ? MappedFile->MapRegion() : nullptr};
+
+	TArray<uint8> FileData;
+	TUniquePtr<FArchive> Reader;
+	if (MappedRegion.IsValid())
+	{
+		Reader = MakeUnique<FLargeMemoryReader>(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize());
+	}
+	else if (FFileHelper::LoadFileToArray(FileData, *FilePath))
+	{
+		Reader = MakeUnique<FMemoryReader>(FileData, true);
+	}
+	else
+	{
+		UE_LOG(LogProjectCleaner, Error, TEXT("Failed to open asset registry file %s"), *FilePath);
+		return false;
+	}
+
+	FAssetRegistryVersion::Type Version;
+	if (!FAssetRegistryVersion::SerializeVersion(*Reader, Version))
+	{
+		UE_LOG(LogProjectCleaner, Error, TEXT("%s is not asset registry file or was saved by newer engine version"), *FilePath);
+		return false;
+	}
+
+	Reader->Seek(0);
+
+	// replaces whole registry state, so nothing is gathered from disk afterwards
+	const FAssetRegistryModule& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName);
+	AssetRegistry.Get().Serialize(*Reader);
+
+	if (Reader->IsError())
+	{
+		UE_LOG(LogProjectCleaner, Error, TEXT("Failed to read asset registry file %s"), *FilePath);
+		return false;
+	}
+
+	return true;
+}
+
 void ProjectCleanerUtility::FocusOnGameFolder()
 {
 	TArray<FString> FocusFolders;
@@ -4,6 +4,7 @@
 #include "UI/ProjectCleanerStyle.h"
 #include "UI/ProjectCleanerMainUI.h"
 #include "UI/ProjectCleanerCommands.h"
+#include "Core/ProjectCleanerAnalysisSession.h"
 // Engine Headers
 #include "ToolMenus.h"
 #include "AssetToolsModule.h"
@@ -45,6 +46,7 @@ void FProjectCleanerModule::StartupModule()
 
 void FProjectCleanerModule::ShutdownModule()
 {
+	FProjectCleanerAnalysisSession::Shutdown();
 	UToolMenus::UnRegisterStartupCallback(this);
 	UToolMenus::UnregisterOwner(this);
 	FProjectCleanerStyle::Shutdown();
@@ -0,0 +1,119 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "ProjectCleanerAnalyzeAsyncAction.h"
+#include "Core/ProjectCleanerAnalysisSession.h"
+#include "Core/ProjectCleanerDataManager.h"
+
+UProjectCleanerAnalyzeAsyncAction* UProjectCleanerAnalyzeAsyncAction::AnalyzeProjectAsync(const FProjectCleanerConfigs& CleanerConfigs)
+{
+	UProjectCleanerAnalyzeAsyncAction* Action = NewObject<UProjectCleanerAnalyzeAsyncAction>();
+	Action->CleanerConfigs = CleanerConfigs;
+	return Action;
+}
+
+void UProjectCleanerAnalyzeAsyncAction::Activate()
+{
+	if (IsRunning()) return;
+
+	// there is no game instance in editor to keep action alive
+	AddToRoot();
+
+	Progress = 0.0f;
+	bCancelRequested = false;
+	TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UProjectCleanerAnalyzeAsyncAction::Tick));
+}
+
+void UProjectCleanerAnalyzeAsyncAction::Cancel()
+{
+	bCancelRequested = true;
+}
+
+float UProjectCleanerAnalyzeAsyncAction::GetProgress() const
+{
+	return Progress;
+}
+
+bool UProjectCleanerAnalyzeAsyncAction::IsRunning() const
+{
+	return TickerHandle.IsValid();
+}
+
+bool UProjectCleanerAnalyzeAsyncAction::Tick(float DeltaTime)
+{
+	if (bCancelRequested)
+	{
+		Finish(nullptr);
+		return false;
+	}
+
+	if (!Analysis.IsValid())
+	{
+		FCleanerSessionConfigs SessionConfigs;
+		UProjectCleanerLibrary::GetSessionConfigs(CleanerConfigs, SessionConfigs);
+
+		FProjectCleanerAnalysisSession& Session = FProjectCleanerAnalysisSession::Get();
+		if (const FProjectCleanerDataManager* CachedAnalysis = Session.FindAnalysis(SessionConfigs))
+		{
+			Finish(CachedAnalysis);
+			return false;
+		}
+
+		const TSharedRef<FProjectCleanerDataManager> NewAnalysis = Session.StartAnalysis(SessionConfigs);
+
+		// asset registry is still scanning, trying again next tick
+		if (!NewAnalysis->BeginAnalysis()) return true;
+
+		Analysis = NewAnalysis;
+		return true;
+	}
+
+	const bool bHasMoreStages = Analysis->RunNextAnalysisStage();
+	Progress = Analysis->GetAnalysisProgress();
+
+	if (bHasMoreStages)
+	{
+		OnProgress.Broadcast(Progress, FProjectCleanerAnalysisResult{});
+		return true;
+	}
+
+	Analysis->FinishAnalysis();
+	FProjectCleanerAnalysisSession::Get().FinishAnalysis(Analysis.ToSharedRef());
+
+	// kept alive by action even if session did not cache it, because project changed meanwhile or newer analysis started
+	const TSharedRef<FProjectCleanerDataManager> FinishedAnalysis = Analysis.ToSharedRef();
+	Finish(&FinishedAnalysis.Get());
+	return false;
+}
+
+void UProjectCleanerAnalyzeAsyncAction::Finish(const FProjectCleanerDataManager* FinishedAnalysis)
+{
+	FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+
+	if (FinishedAnalysis)
+	{
+		// built from this action's own analysis only, so it never falls back to synchronous analysis
+		FProjectCleanerAnalysisResult Result;
+		Result.UnusedAssets = FinishedAnalysis->GetUnusedAssets();
+		UProjectCleanerLibrary::GetResultFromAnalysis(*FinishedAnalysis, EProjectCleanerResultCategory::ERC_EmptyFolders, EProjectCleanerPathReturnType::EPT_Absolute, Result.EmptyFolders);
+		UProjectCleanerLibrary::GetResultFromAnalysis(*FinishedAnalysis, EProjectCleanerResultCategory::ERC_NonEngineFiles, EProjectCleanerPathReturnType::EPT_Absolute, Result.NonEngineFiles);
+		UProjectCleanerLibrary::GetResultFromAnalysis(*FinishedAnalysis, EProjectCleanerResultCategory::ERC_CorruptedFiles, EProjectCleanerPathReturnType::EPT_Absolute, Result.CorruptedFiles);
+		UProjectCleanerLibrary::GetResultFromAnalysis(*FinishedAnalysis, EProjectCleanerResultCategory::ERC_IndirectlyUsedAssets, EProjectCleanerPathReturnType::EPT_Game, Result.IndirectlyUsedAssets);
+
+		Progress = 1.0f;
+		OnCompleted.Broadcast(Progress, Result);
+	}
+	else
+	{
+		OnCancelled.Broadcast(Progress, FProjectCleanerAnalysisResult{});
+	}
+
+	if (Analysis.IsValid())
+	{
+		Analysis->CancelAnalysis();
+		Analysis.Reset();
+	}
+
+	RemoveFromRoot();
+	SetReadyToDestroy();
+}
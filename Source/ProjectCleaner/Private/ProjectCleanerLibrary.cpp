@@ -1,29 +1,115 @@
-// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
 
 #include "ProjectCleanerLibrary.h"
 #include "Core/ProjectCleanerDataManager.h"
 #include "Core/ProjectCleanerUtility.h"
+#include "Core/ProjectCleanerAnalysisSession.h"
 // Engine Headers
 #include "Misc/FileHelper.h"
+#include "HAL/FileManager.h"
 
-TArray<FAssetData> UProjectCleanerLibrary::GetUnusedAssets(const FProjectCleanerConfigs& CleanerConfigs)
+namespace ProjectCleanerLibrary
 {
-	FProjectCleanerDataManager DataManager;
+	constexpr int32 ExportPageSize = 4096;
+
+	/**
+	 * Formats asset paths, with project directories converted to full paths only once
+	 */
+	struct FAssetPathFormatter
+	{
+		FAssetPathFormatter() :
+			ContentDir(FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir())),
+			ProjectDir(FPaths::ConvertRelativePathToFull(FPaths::ProjectDir()))
+		{
+		}
+
+		FString Format(const FAssetData& AssetData, const EProjectCleanerPathReturnType PathType) const
+		{
+			if (!AssetData.IsValid()) return FString{};
+
+			if (PathType == EProjectCleanerPathReturnType::EPT_Game)
+			{
+				// Returns ObjectPath in format => /Game/MyFolder/NewMaterial.NewMaterial
+				return AssetData.ObjectPath.ToString();
+			}
+
+			// Converts /Game/MyFolder/NewMaterial.NewMaterial => C:/dev/MyProject/Content/MyFolder/NewMaterial.uasset
+			FString FinalPath;
+			const FString PackagePath = AssetData.PackagePath.ToString();
+			if (PackagePath.StartsWith(TEXT("/Game/")) || PackagePath.Equals(TEXT("/Game")))
+			{
+				FinalPath = ContentDir / PackagePath.RightChop(5);
+			}
+			else if (FPackageName::TryConvertGameRelativePackagePathToLocalPath(PackagePath, FinalPath))
+			{
+				FinalPath = FPaths::ConvertRelativePathToFull(FinalPath);
+			}
+			else
+			{
+				return FinalPath;
+			}
+
+			FinalPath.Append(TEXT("/"));
+			FinalPath.Append(AssetData.AssetName.ToString());
+			FinalPath.Append(TEXT(".uasset"));
+
+			if (PathType == EProjectCleanerPathReturnType::EPT_Relative)
+			{
+				// Converts C:/dev/MyProject/Content/MyFolder/NewMaterial.uasset => Content/MyFolder/NewMaterial.uasset
+				FinalPath.RemoveFromStart(ProjectDir);
+			}
+
+			FPaths::RemoveDuplicateSlashes(FinalPath);
+
+			return FinalPath;
+		}
+
+		FString ContentDir;
+		FString ProjectDir;
+	};
+
+	/** Set cursor is index in set's sparse array, so next page does not walk over previous ones */
+	template <typename ElementType>
+	int32 GetSetPage(const TSet<ElementType>& Set, const int32 Cursor, const int32 PageSize, TFunctionRef<void(const ElementType&)> Visit)
+	{
+		const int32 MaxIndex = Set.GetMaxIndex();
+		int32 Index = FMath::Max(0, Cursor);
+		int32 Visited = 0;
+		for (; Index < MaxIndex && Visited < PageSize; ++Index)
+		{
+			const FSetElementId Id = FSetElementId::FromInteger(Index);
+			if (!Set.IsValidId(Id)) continue;
+
+			Visit(Set[Id]);
+			++Visited;
+		}
+
+		while (Index < MaxIndex && !Set.IsValidId(FSetElementId::FromInteger(Index)))
+		{
+			++Index;
+		}
+
+		return Index < MaxIndex ? Index : INDEX_NONE;
+	}
+}
 
-	FillCleanerConfigs(DataManager, CleanerConfigs);
+TArray<FAssetData> UProjectCleanerLibrary::GetUnusedAssets(const FProjectCleanerConfigs& CleanerConfigs)
+{
+	const FProjectCleanerDataManager& DataManager = GetAnalysis(CleanerConfigs);
 
 	return DataManager.GetUnusedAssets();
 }
 
 TArray<FString> UProjectCleanerLibrary::GetUnusedAssetsPaths(const FProjectCleanerConfigs& CleanerConfigs, EProjectCleanerPathReturnType PathType)
 {
-	const TArray<FAssetData> UnusedAssets = GetUnusedAssets(CleanerConfigs);
+	const TArray<FAssetData>& UnusedAssets = GetAnalysis(CleanerConfigs).GetUnusedAssets();
+	const ProjectCleanerLibrary::FAssetPathFormatter Formatter;
 	TArray<FString> Paths;
 	Paths.Reserve(UnusedAssets.Num());
 
 	for (const auto& Asset : UnusedAssets)
 	{
-		Paths.Add(GetAssetPathByPathType(Asset, PathType));
+		Paths.Add(Formatter.Format(Asset, PathType));
 	}
 
 	return Paths;
@@ -31,43 +117,12 @@ TArray<FString> UProjectCleanerLibrary::GetUnusedAssetsPaths(const FProjectClean
 
 FString UProjectCleanerLibrary::GetAssetPathByPathType(const FAssetData& AssetData, EProjectCleanerPathReturnType PathType)
 {
-	if (!AssetData.IsValid()) return FString{};
-
-	if (PathType == EProjectCleanerPathReturnType::EPT_Game)
-	{
-		// Returns ObjectPath in format => /Game/MyFolder/NewMaterial.NewMaterial
-		return AssetData.ObjectPath.ToString();
-	}
-
-	FString FinalPath{};
-	// Converts /Game/MyFolder/NewMaterial.NewMaterial => C:/dev/MyProject/Content/MyFolder/NewMaterial.NewMaterial
-	if (!FPackageName::TryConvertGameRelativePackagePathToLocalPath(AssetData.PackagePath.ToString(), FinalPath))
-	{
-		return FinalPath;
-	}
-
-	FinalPath = FPaths::ConvertRelativePathToFull(FinalPath);
-	// Converts C:/dev/MyProject/Content/MyFolder/NewMaterial.NewMaterial => C:/dev/MyProject/Content/MyFolder/NewMaterial.uasset
-	FinalPath.Append(TEXT("/"));
-	FinalPath.Append(AssetData.AssetName.ToString());
-	FinalPath.Append(TEXT(".uasset"));
-
-	if (PathType == EProjectCleanerPathReturnType::EPT_Relative)
-	{
-		// Converts C:/dev/MyProject/Content/MyFolder/NewMaterial.uasset => Content/MyFolder/NewMaterial.uasset
-		FinalPath.RemoveFromStart(FPaths::ConvertRelativePathToFull(FPaths::ProjectDir()));
-	}
-
-	FPaths::RemoveDuplicateSlashes(FinalPath);
-
-	return FinalPath;
+	return ProjectCleanerLibrary::FAssetPathFormatter{}.Format(AssetData, PathType);
 }
 
 TArray<FString> UProjectCleanerLibrary::GetEmptyFolders(const FProjectCleanerConfigs& CleanerConfigs)
 {
-	FProjectCleanerDataManager DataManager;
-
-	FillCleanerConfigs(DataManager, CleanerConfigs);
+	const FProjectCleanerDataManager& DataManager = GetAnalysis(CleanerConfigs);
 
 	const TSet<FName>& EmptyFoldersSet = DataManager.GetEmptyFolders();
 
@@ -84,14 +139,12 @@ TArray<FString> UProjectCleanerLibrary::GetEmptyFolders(const FProjectCleanerCon
 
 TArray<FString> UProjectCleanerLibrary::GetNonEngineFiles(const FProjectCleanerConfigs& CleanerConfigs)
 {
-	FProjectCleanerDataManager DataManager;
-
-	FillCleanerConfigs(DataManager, CleanerConfigs);
+	const FProjectCleanerDataManager& DataManager = GetAnalysis(CleanerConfigs);
 
 	const TSet<FName>& NonEngineFilesSet = DataManager.GetNonEngineFiles();
 
 	TArray<FString> NonEngineFiles;
-	NonEngineFiles.Reserve(NonEngineFiles.Num());
+	NonEngineFiles.Reserve(NonEngineFilesSet.Num());
 
 	for (const auto& File : NonEngineFilesSet)
 	{
@@ -103,9 +156,7 @@ TArray<FString> UProjectCleanerLibrary::GetNonEngineFiles(const FProjectCleanerC
 
 TArray<FString> UProjectCleanerLibrary::GetCorruptedFiles(const FProjectCleanerConfigs& CleanerConfigs)
 {
-	FProjectCleanerDataManager DataManager;
-
-	FillCleanerConfigs(DataManager, CleanerConfigs);
+	const FProjectCleanerDataManager& DataManager = GetAnalysis(CleanerConfigs);
 
 	const TSet<FName>& CorruptedAssetsSet = DataManager.GetCorruptedAssets();
 
@@ -122,9 +173,7 @@ TArray<FString> UProjectCleanerLibrary::GetCorruptedFiles(const FProjectCleanerC
 
 TArray<FString> UProjectCleanerLibrary::GetIndirectlyUsedAssets(const FProjectCleanerConfigs& CleanerConfigs)
 {
-	FProjectCleanerDataManager DataManager;
-
-	FillCleanerConfigs(DataManager, CleanerConfigs);
+	const FProjectCleanerDataManager& DataManager = GetAnalysis(CleanerConfigs);
 
 	const auto& IndirectlyUsedAssetsMap = DataManager.GetIndirectAssets();
 
@@ -140,6 +189,163 @@ TArray<FString> UProjectCleanerLibrary::GetIndirectlyUsedAssets(const FProjectCl
 }
 
 bool UProjectCleanerLibrary::ExportToFile(const TArray<FString>& List, const FString& FileName)
+{
+	FString SavePath;
+	if (!PrepareExportFile(FileName, SavePath)) return false;
+
+	// Saving file
+	if (!FFileHelper::SaveStringArrayToFile(List, *SavePath))
+	{
+		UE_LOG(LogProjectCleaner, Error, TEXT("Failed to create %s file"), *SavePath);
+		return false;
+	}
+
+	return true;
+}
+
+int32 UProjectCleanerLibrary::GetResultNum(const FProjectCleanerConfigs& CleanerConfigs, EProjectCleanerResultCategory ResultCategory)
+{
+	const FProjectCleanerDataManager& DataManager = GetAnalysis(CleanerConfigs);
+
+	switch (ResultCategory)
+	{
+		case EProjectCleanerResultCategory::ERC_UnusedAssets: return DataManager.GetUnusedAssets().Num();
+		case EProjectCleanerResultCategory::ERC_EmptyFolders: return DataManager.GetEmptyFolders().Num();
+		case EProjectCleanerResultCategory::ERC_NonEngineFiles: return DataManager.GetNonEngineFiles().Num();
+		case EProjectCleanerResultCategory::ERC_CorruptedFiles: return DataManager.GetCorruptedAssets().Num();
+		case EProjectCleanerResultCategory::ERC_IndirectlyUsedAssets: return DataManager.GetIndirectAssets().Num();
+		case EProjectCleanerResultCategory::ERC_OrphanedFiles: return DataManager.GetOrphanedFiles().Num();
+		default: return 0;
+	}
+}
+
+bool UProjectCleanerLibrary::GetResultPage(const FProjectCleanerConfigs& CleanerConfigs, EProjectCleanerResultCategory ResultCategory, EProjectCleanerPathReturnType PathType, int32 Cursor, int32 PageSize, int32 AnalysisToken, TArray<FString>& OutRows, int32& NextCursor, int32& OutAnalysisToken)
+{
+	OutRows.Reset();
+	NextCursor = INDEX_NONE;
+	OutAnalysisToken = 0;
+
+	if (Cursor < 0 || PageSize <= 0)
+	{
+		UE_LOG(LogProjectCleaner, Error, TEXT("Invalid page, Cursor: %d PageSize: %d"), Cursor, PageSize);
+		return false;
+	}
+
+	const FProjectCleanerDataManager& DataManager = GetAnalysis(CleanerConfigs);
+	OutAnalysisToken = FProjectCleanerAnalysisSession::Get().GetAnalysisToken();
+
+	// cursors are indices into containers of one analysis, in newer one they would skip or repeat rows
+	if (Cursor > 0 && AnalysisToken != OutAnalysisToken)
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Project was analyzed again since first page, paging must restart from Cursor 0"));
+		return false;
+	}
+
+	NextCursor = GetResultPageInternal(DataManager, ResultCategory, PathType, Cursor, PageSize, OutRows);
+	return true;
+}
+
+bool UProjectCleanerLibrary::ExportResultToFile(const FProjectCleanerConfigs& CleanerConfigs, EProjectCleanerResultCategory ResultCategory, EProjectCleanerPathReturnType PathType, const FString& FileName)
+{
+	FString SavePath;
+	if (!PrepareExportFile(FileName, SavePath)) return false;
+
+	const FProjectCleanerDataManager& DataManager = GetAnalysis(CleanerConfigs);
+
+	const TUniquePtr<FArchive> Writer{IFileManager::Get().CreateFileWriter(*SavePath)};
+	if (!Writer.IsValid())
+	{
+		UE_LOG(LogProjectCleaner, Error, TEXT("Failed to create %s file"), *SavePath);
+		return false;
+	}
+
+	// only one page of formatted paths is kept in memory
+	TArray<FString> Rows;
+	Rows.Reserve(ProjectCleanerLibrary::ExportPageSize);
+
+	int32 Cursor = 0;
+	while (Cursor != INDEX_NONE)
+	{
+		Rows.Reset();
+		Cursor = GetResultPageInternal(DataManager, ResultCategory, PathType, Cursor, ProjectCleanerLibrary::ExportPageSize, Rows);
+
+		for (const auto& Row : Rows)
+		{
+			const FTCHARToUTF8 Utf8Row{*Row};
+			Writer->Serialize(const_cast<ANSICHAR*>(Utf8Row.Get()), Utf8Row.Length());
+			Writer->Serialize(const_cast<ANSICHAR*>(LINE_TERMINATOR_ANSI), FCStringAnsi::Strlen(LINE_TERMINATOR_ANSI));
+		}
+	}
+
+	if (!Writer->Close())
+	{
+		UE_LOG(LogProjectCleaner, Error, TEXT("Failed to write %s file"), *SavePath);
+		return false;
+	}
+
+	return true;
+}
+
+void UProjectCleanerLibrary::GetResultFromAnalysis(const FProjectCleanerDataManager& DataManager, EProjectCleanerResultCategory ResultCategory, EProjectCleanerPathReturnType PathType, TArray<FString>& OutRows)
+{
+	OutRows.Reset();
+	GetResultPageInternal(DataManager, ResultCategory, PathType, 0, MAX_int32, OutRows);
+}
+
+int32 UProjectCleanerLibrary::GetResultPageInternal(const FProjectCleanerDataManager& DataManager, EProjectCleanerResultCategory ResultCategory, EProjectCleanerPathReturnType PathType, int32 Cursor, int32 PageSize, TArray<FString>& OutRows)
+{
+	switch (ResultCategory)
+	{
+		case EProjectCleanerResultCategory::ERC_UnusedAssets:
+		{
+			const TArray<FAssetData>& UnusedAssets = DataManager.GetUnusedAssets();
+			const ProjectCleanerLibrary::FAssetPathFormatter Formatter;
+			const int32 End = FMath::Min(Cursor + PageSize, UnusedAssets.Num());
+			for (int32 i = Cursor; i < End; ++i)
+			{
+				OutRows.Add(Formatter.Format(UnusedAssets[i], PathType));
+			}
+
+			return End < UnusedAssets.Num() ? End : INDEX_NONE;
+		}
+		case EProjectCleanerResultCategory::ERC_EmptyFolders:
+			return ProjectCleanerLibrary::GetSetPage<FName>(DataManager.GetEmptyFolders(), Cursor, PageSize, [&] (const FName& Folder)
+			{
+				OutRows.Add(FPaths::ConvertRelativePathToFull(Folder.ToString()));
+			});
+		case EProjectCleanerResultCategory::ERC_NonEngineFiles:
+			return ProjectCleanerLibrary::GetSetPage<FName>(DataManager.GetNonEngineFiles(), Cursor, PageSize, [&] (const FName& File)
+			{
+				OutRows.Add(File.ToString());
+			});
+		case EProjectCleanerResultCategory::ERC_CorruptedFiles:
+			return ProjectCleanerLibrary::GetSetPage<FName>(DataManager.GetCorruptedAssets(), Cursor, PageSize, [&] (const FName& Asset)
+			{
+				OutRows.Add(ProjectCleanerUtility::ConvertInternalToAbsolutePath(Asset.ToString()));
+			});
+		case EProjectCleanerResultCategory::ERC_OrphanedFiles:
+			return ProjectCleanerLibrary::GetSetPage<FName>(DataManager.GetOrphanedFiles(), Cursor, PageSize, [&] (const FName& File)
+			{
+				OutRows.Add(File.ToString());
+			});
+		case EProjectCleanerResultCategory::ERC_IndirectlyUsedAssets:
+		{
+			const TArray<FAssetData>& IndirectAssets = DataManager.GetIndirectAssetsList();
+			const ProjectCleanerLibrary::FAssetPathFormatter Formatter;
+			const int32 End = FMath::Min(Cursor + PageSize, IndirectAssets.Num());
+			for (int32 i = Cursor; i < End; ++i)
+			{
+				OutRows.Add(Formatter.Format(IndirectAssets[i], PathType));
+			}
+
+			return End < IndirectAssets.Num() ? End : INDEX_NONE;
+		}
+		default:
+			return INDEX_NONE;
+	}
+}
+
+bool UProjectCleanerLibrary::PrepareExportFile(const FString& FileName, FString& OutSavePath)
 {
 	if (FileName.IsEmpty())
 	{
@@ -149,6 +355,7 @@ bool UProjectCleanerLibrary::ExportToFile(const TArray<FString>& List, const FSt
 
 	const FString SaveDir = FPaths::ProjectSavedDir() + TEXT("/ProjectCleaner/");
 	const FString SavePath = SaveDir + FileName;
+	OutSavePath = SavePath;
 	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
 
 	// check if Saved/ProjectCleaner directory exists and create one if not
@@ -171,21 +378,28 @@ bool UProjectCleanerLibrary::ExportToFile(const TArray<FString>& List, const FSt
 		}
 	}
 
-	// Saving file
-	if (!FFileHelper::SaveStringArrayToFile(List, *SavePath))
-	{
-		UE_LOG(LogProjectCleaner, Error, TEXT("Failed to create %s file"), *SavePath);
-		return false;
-	}
-
 	return true;
 }
 
-void UProjectCleanerLibrary::FillCleanerConfigs(FProjectCleanerDataManager& DataManager, const FProjectCleanerConfigs& CleanerConfigs)
+void UProjectCleanerLibrary::InvalidateAnalysis()
+{
+	FProjectCleanerAnalysisSession::Get().Invalidate();
+}
+
+const FProjectCleanerDataManager& UProjectCleanerLibrary::GetAnalysis(const FProjectCleanerConfigs& CleanerConfigs)
 {
-	TArray<FString> ExcludedAssets;
-	TArray<FString> ExcludedPaths;
-	TArray<FString> ExcludedClasses;
+	FCleanerSessionConfigs SessionConfigs;
+	GetSessionConfigs(CleanerConfigs, SessionConfigs);
+
+	// every API call with same configs is answered from one analysis, until project changes
+	return FProjectCleanerAnalysisSession::Get().GetAnalysis(SessionConfigs);
+}
+
+void UProjectCleanerLibrary::GetSessionConfigs(const FProjectCleanerConfigs& CleanerConfigs, FCleanerSessionConfigs& OutSessionConfigs)
+{
+	TArray<FString>& ExcludedAssets = OutSessionConfigs.ExcludedAssets;
+	TArray<FString>& ExcludedPaths = OutSessionConfigs.ExcludedPaths;
+	TArray<FString>& ExcludedClasses = OutSessionConfigs.ExcludedClasses;
 
 	ExcludedAssets.Reserve(CleanerConfigs.ExcludedAssets.Num());
 	ExcludedPaths.Reserve(CleanerConfigs.ExcludedPaths.Num());
@@ -210,12 +424,5 @@ void UProjectCleanerLibrary::FillCleanerConfigs(FProjectCleanerDataManager& Data
 		ExcludedClasses.AddUnique(ExcludedClass->GetFName().ToString());
 	}
 
-	// todo:ashe23 add scandevfolder option
-	DataManager.SetSilentMode(true);
-	DataManager.SetUserExcludedAssets(ExcludedAssets);
-	DataManager.SetExcludePaths(ExcludedPaths);
-	DataManager.SetExcludeClasses(ExcludedClasses);
-	DataManager.SetScanDeveloperContents(CleanerConfigs.bScanDeveloperContents);
-
-	DataManager.AnalyzeProject();
+	OutSessionConfigs.bScanDeveloperContents = CleanerConfigs.bScanDeveloperContents;
 }
@@ -0,0 +1,314 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "ProjectCleanerBenchmarkFixture.h"
+#include "ProjectCleanerBenchmarkBaseline.h"
+#include "Core/ProjectCleanerDataManager.h"
+#include "Core/ProjectCleanerAnalysisPipeline.h"
+// Engine Headers
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ProjectCleanerAnalysisSpec
+{
+	constexpr EAutomationTestFlags::Type TestFlags = static_cast<EAutomationTestFlags::Type>(EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+	// smaller than DeleteAllUnusedAssets uses, so few dozen fixture packages are spread over several buckets
+	constexpr int32 OrderingBucketSize = 4;
+
+	/**
+	 * Benchmark results measured on same fixture, recorded with
+	 * -run=ProjectCleanerBenchmark -Generate -Benchmark -Clean -Root=/Game/ProjectCleanerSpec -Assets=48 -Topology=Mixed -ClusterSize=6 -FanOut=3
+	 * -AssetsPerFolder=16 -Blueprints=2 -BlueprintDepth=3 -IndirectRatio=0.5 -NonEngineFiles=8 -EmptyFolders=8 -Seed=7 -Output=<file>
+	 */
+	FString GetBaselineFile()
+	{
+		FString BaselineFile;
+		if (!FParse::Value(FCommandLine::Get(), TEXT("ProjectCleanerSpecBaseline="), BaselineFile))
+		{
+			BaselineFile = FPaths::ProjectSavedDir() / TEXT("ProjectCleaner") / TEXT("AnalysisSpecBaseline.json");
+		}
+
+		return BaselineFile;
+	}
+
+	FCleanerBenchmarkFixtureSettings MakeFixtureSettings()
+	{
+		FCleanerBenchmarkFixtureSettings Settings;
+		Settings.RootPath = TEXT("/Game/ProjectCleanerSpec");
+		Settings.AssetsNum = 48;
+		Settings.Topology = ECleanerFixtureTopology::Mixed;
+		Settings.ClusterSize = 6;
+		Settings.FanOut = 3;
+		Settings.AssetsPerFolder = 16;
+		Settings.BlueprintHierarchies = 2;
+		Settings.BlueprintDepth = 3;
+		Settings.IndirectRatio = 0.5f;
+		Settings.NonEngineFilesNum = 8;
+		Settings.EmptyFoldersNum = 8;
+		Settings.Seed = 7;
+		return Settings;
+	}
+
+	bool IsUnderPath(const FName PackagePath, const FString& RootPath)
+	{
+		const FString Path = PackagePath.ToString();
+		return Path.Equals(RootPath) || Path.StartsWith(RootPath + TEXT("/"));
+	}
+
+	int32 CountUnderDirectory(const TSet<FName>& Paths, const FString& Directory)
+	{
+		int32 Num = 0;
+		for (const auto& Path : Paths)
+		{
+			if (Path.ToString().StartsWith(Directory))
+			{
+				++Num;
+			}
+		}
+
+		return Num;
+	}
+}
+
+BEGIN_DEFINE_SPEC(FProjectCleanerAnalysisSpec, "ProjectCleaner.Analysis", ProjectCleanerAnalysisSpec::TestFlags)
+	FCleanerBenchmarkFixtureSettings FixtureSettings;
+	TUniquePtr<FProjectCleanerBenchmarkFixture> Fixture;
+	TUniquePtr<FProjectCleanerDataManager> DataManager;
+	FCleanerAnalysisReport DeletionReport;
+
+	/** Fixture is generated and analyzed once, every It only reads results */
+	bool SetupFixture();
+	void CleanFixture();
+	int32 CountAssetsUnderRoot(const TArray<FAssetData>& Assets) const;
+END_DEFINE_SPEC(FProjectCleanerAnalysisSpec)
+
+bool FProjectCleanerAnalysisSpec::SetupFixture()
+{
+	if (Fixture)
+	{
+		return DataManager.IsValid();
+	}
+
+	FixtureSettings = ProjectCleanerAnalysisSpec::MakeFixtureSettings();
+	Fixture = MakeUnique<FProjectCleanerBenchmarkFixture>(FixtureSettings);
+	FAutomationTestFramework::Get().OnAfterAllTestsEvent.AddRaw(this, &FProjectCleanerAnalysisSpec::CleanFixture);
+	if (!Fixture->Generate())
+	{
+		return false;
+	}
+
+	// read only, so stages that resave project are skipped and host project stays untouched
+	DataManager = MakeUnique<FProjectCleanerDataManager>();
+	DataManager->SetSilentMode(true);
+	DataManager->SetReadOnly(true);
+	DataManager->AnalyzeProject();
+
+	// measured same way benchmark measures it, so it can be checked against same baseline
+	FProjectCleanerAnalysisPipeline DeletionPipeline;
+	DeletionPipeline.AddStage(TEXT("PlanDeletion"), [this] ()
+	{
+		TArray<TArray<FAssetData>> Buckets;
+		return DataManager->PlanDeletion(FProjectCleanerDataManager::DeletionBucketSize, Buckets);
+	});
+	DeletionPipeline.Run(DeletionReport);
+
+	return true;
+}
+
+void FProjectCleanerAnalysisSpec::CleanFixture()
+{
+	FAutomationTestFramework::Get().OnAfterAllTestsEvent.RemoveAll(this);
+
+	DataManager.Reset();
+	DeletionReport = FCleanerAnalysisReport{};
+	if (Fixture)
+	{
+		Fixture->Clean();
+		Fixture.Reset();
+	}
+}
+
+int32 FProjectCleanerAnalysisSpec::CountAssetsUnderRoot(const TArray<FAssetData>& Assets) const
+{
+	return Assets.FilterByPredicate([&] (const FAssetData& AssetData)
+	{
+		return ProjectCleanerAnalysisSpec::IsUnderPath(AssetData.PackagePath, FixtureSettings.RootPath);
+	}).Num();
+}
+
+void FProjectCleanerAnalysisSpec::Define()
+{
+	using namespace ProjectCleanerAnalysisSpec;
+
+	BeforeEach([this]()
+	{
+		TestTrue(TEXT("Fixture generated"), SetupFixture());
+	});
+
+	Describe("Reconciliation", [this]()
+	{
+		It("should find every generated asset", [this]()
+		{
+			TestEqual(TEXT("Assets"), CountAssetsUnderRoot(DataManager->GetAllAssets()), Fixture->GetGeneratedAssetsNum());
+		});
+
+		It("should report generated non engine files and no corrupted assets", [this]()
+		{
+			const FString ContentDir = Fixture->GetContentDir();
+
+			TestEqual(TEXT("Non engine files"), CountUnderDirectory(DataManager->GetNonEngineFiles(), ContentDir), FixtureSettings.NonEngineFilesNum);
+			TestEqual(TEXT("Corrupted assets"), CountUnderDirectory(DataManager->GetCorruptedAssets(), FixtureSettings.RootPath + TEXT("/")), 0);
+		});
+
+		It("should find generated empty folders", [this]()
+		{
+			// nested folders and their parents are reported too
+			TestTrue(TEXT("Empty folders"), CountUnderDirectory(DataManager->GetEmptyFolders(), Fixture->GetContentDir()) >= FixtureSettings.EmptyFoldersNum);
+		});
+	});
+
+	Describe("IndirectScan", [this]()
+	{
+		It("should find every asset referenced from generated source and config files", [this]()
+		{
+			int32 IndirectNum = 0;
+			for (const auto& IndirectAsset : DataManager->GetIndirectAssets())
+			{
+				if (!IsUnderPath(IndirectAsset.Key.PackagePath, FixtureSettings.RootPath)) continue;
+
+				++IndirectNum;
+				TestTrue(FString::Printf(TEXT("%s has file"), *IndirectAsset.Key.ObjectPath.ToString()), !IndirectAsset.Value.File.IsEmpty());
+				TestTrue(FString::Printf(TEXT("%s has line"), *IndirectAsset.Key.ObjectPath.ToString()), IndirectAsset.Value.Line > 0);
+			}
+
+			TestEqual(TEXT("Indirect assets"), IndirectNum, Fixture->GetIndirectReferencesNum());
+		});
+	});
+
+	Describe("Reachability", [this]()
+	{
+		It("should keep every asset reachable from indirect references used", [this]()
+		{
+			const int32 AssetsNum = CountAssetsUnderRoot(DataManager->GetAllAssets());
+			const int32 UnusedNum = CountAssetsUnderRoot(DataManager->GetUnusedAssets());
+
+			TestEqual(TEXT("Used assets"), AssetsNum - UnusedNum, Fixture->GetUsedAssetsNum());
+		});
+
+		It("should mark unused every package of unused asset", [this]()
+		{
+			for (const auto& AssetData : DataManager->GetUnusedAssets())
+			{
+				if (!IsUnderPath(AssetData.PackagePath, FixtureSettings.RootPath)) continue;
+
+				TestTrue(AssetData.PackageName.ToString(), DataManager->GetUnusedPackages().Contains(AssetData.PackageName));
+			}
+		});
+	});
+
+	Describe("Classification", [this]()
+	{
+		It("should roll up unused assets to fixture root folder", [this]()
+		{
+			const FCleanerAggregateStats* RootStats = DataManager->GetFolderStats().Find(FName{*FixtureSettings.RootPath});
+			if (!TestNotNull(TEXT("Root folder stats"), RootStats)) return;
+
+			TestEqual(TEXT("Assets"), RootStats->AssetsNum, Fixture->GetGeneratedAssetsNum());
+			TestEqual(TEXT("Unused assets"), RootStats->UnusedAssetsNum, Fixture->GetGeneratedAssetsNum() - Fixture->GetUsedAssetsNum());
+			TestTrue(TEXT("Unused size"), RootStats->UnusedSize > 0 && RootStats->UnusedSize <= RootStats->TotalSize);
+		});
+	});
+
+	Describe("DeletionPlan", [this]()
+	{
+		It("should plan every unused asset and delete referencers no later than their dependencies", [this]()
+		{
+			TArray<TArray<FAssetData>> Buckets;
+			DataManager->PlanDeletion(OrderingBucketSize, Buckets);
+
+			TMap<FName, int32> PackageBuckets;
+			int32 PlannedNum = 0;
+			for (int32 Bucket = 0; Bucket < Buckets.Num(); ++Bucket)
+			{
+				for (const auto& AssetData : Buckets[Bucket])
+				{
+					if (!IsUnderPath(AssetData.PackagePath, FixtureSettings.RootPath)) continue;
+
+					++PlannedNum;
+					PackageBuckets.Add(AssetData.PackageName, Bucket);
+				}
+			}
+
+			TestEqual(TEXT("Planned assets"), PlannedNum, CountAssetsUnderRoot(DataManager->GetUnusedAssets()));
+			if (!TestTrue(TEXT("Several buckets"), Buckets.Num() > 1)) return;
+
+			const IAssetRegistry& AssetRegistry = DataManager->GetAssetRegistry()->Get();
+			TArray<FName> Dependencies;
+			for (const auto& PackageBucket : PackageBuckets)
+			{
+				Dependencies.Reset();
+				AssetRegistry.GetDependencies(PackageBucket.Key, Dependencies);
+				for (const auto& Dependency : Dependencies)
+				{
+					const int32* DependencyBucket = PackageBuckets.Find(Dependency);
+					if (!DependencyBucket) continue;
+
+					TestTrue(
+						FString::Printf(TEXT("%s before %s"), *PackageBucket.Key.ToString(), *Dependency.ToString()),
+						PackageBucket.Value <= *DependencyBucket
+					);
+				}
+			}
+		});
+	});
+
+	Describe("Budgets", [this]()
+	{
+		It("should skip stages that modify project in read only mode", [this]()
+		{
+			const FCleanerAnalysisReport& Report = DataManager->GetAnalysisReport();
+
+			TestTrue(TEXT("FixupRedirectors skipped"), Report.SkippedStages.Contains(TEXT("FixupRedirectors")));
+			TestTrue(TEXT("SaveAllAssets skipped"), Report.SkippedStages.Contains(TEXT("SaveAllAssets")));
+		});
+
+		It("should keep every stage within its baseline time and memory budget", [this]()
+		{
+			const FString BaselineFile = GetBaselineFile();
+			FProjectCleanerBenchmarkBaseline Baseline;
+			if (!Baseline.Load(BaselineFile))
+			{
+				AddWarning(FString::Printf(TEXT("No baseline at %s, record it with ProjectCleanerBenchmark commandlet on spec fixture to check budgets"), *BaselineFile));
+				return;
+			}
+
+			if (!TestTrue(FString::Printf(TEXT("Baseline %s measured on spec fixture"), *BaselineFile), Baseline.IsMeasuredOn(FixtureSettings))) return;
+
+			TArray<FCleanerStageStats> Stages = DataManager->GetAnalysisReport().Stages;
+			Stages.Append(DeletionReport.Stages);
+
+			for (const auto& Stage : Stages)
+			{
+				const FString StageName = Stage.Name.ToString();
+				double WallTimeBudget = 0.0;
+				double MemoryBudget = 0.0;
+				if (!TestTrue(FString::Printf(TEXT("%s in baseline"), *StageName), Baseline.GetStageBudget(Stage.Name, WallTimeBudget, MemoryBudget))) continue;
+
+				TestTrue(
+					FString::Printf(TEXT("%s wall time %.3f s, budget %.3f s"), *StageName, Stage.WallTime, WallTimeBudget),
+					Stage.WallTime <= WallTimeBudget
+				);
+				TestTrue(
+					FString::Printf(TEXT("%s peak memory growth %lld bytes, budget %.0f bytes"), *StageName, Stage.PeakMemoryGrowth, MemoryBudget),
+					Stage.PeakMemoryGrowth <= MemoryBudget
+				);
+			}
+		});
+	});
+}
+
+#endif
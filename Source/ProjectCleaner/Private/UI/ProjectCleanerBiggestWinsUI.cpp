@@ -0,0 +1,186 @@
+﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "UI/ProjectCleanerBiggestWinsUI.h"
+#include "UI/ProjectCleanerStyle.h"
+#include "Core/ProjectCleanerManager.h"
+#include "ProjectCleanerAnalysisCore.h"
+// Engine Headers
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "IContentBrowserSingleton.h"
+#include "Editor/ContentBrowser/Public/ContentBrowserModule.h"
+
+#define LOCTEXT_NAMESPACE "FProjectCleanerModule"
+
+void SProjectCleanerBiggestWinsUI::Construct(const FArguments& InArgs)
+{
+	if (InArgs._CleanerManager)
+	{
+		SetCleanerManager(InArgs._CleanerManager);
+	}
+
+	ChildSlot
+	[
+		SNew(SOverlay)
+		+ SOverlay::Slot()
+		.Padding(20.0f)
+		[
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SVerticalBox)
+				+SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SNew(STextBlock)
+					.AutoWrapText(true)
+					.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light20"))
+					.Text(LOCTEXT("biggest_wins", "Biggest Wins"))
+				]
+				+ SVerticalBox::Slot()
+				.Padding(FMargin{ 0.0f, 10.0f })
+				.AutoHeight()
+				[
+					SNew(STextBlock)
+					.AutoWrapText(true)
+					.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light10"))
+					.Text(LOCTEXT("biggest_wins_dbl_click_on_row", "Largest unused assets, non engine files and folders with most unused space. Double click on row to locate it"))
+				]
+			]
+			+ SVerticalBox::Slot()
+			.FillHeight(1.0f)
+			.Padding(FMargin{ 0.0f, 20.0f })
+			[
+				SAssignNew(ListView, SListView<TSharedPtr<FCleanerBiggestWinRow>>)
+				.ListItemsSource(&BiggestWins)
+				.SelectionMode(ESelectionMode::SingleToggle)
+				.OnGenerateRow(this, &SProjectCleanerBiggestWinsUI::OnGenerateRow)
+				.OnMouseButtonDoubleClick_Raw(this, &SProjectCleanerBiggestWinsUI::OnMouseDoubleClick)
+				.HeaderRow
+				(
+					SNew(SHeaderRow)
+					+ SHeaderRow::Column(FName("Category"))
+					.HAlignCell(HAlign_Center)
+					.VAlignCell(VAlign_Center)
+					.HAlignHeader(HAlign_Center)
+					.HeaderContentPadding(FMargin(10.0f))
+					.FillWidth(0.2f)
+					[
+						SNew(STextBlock)
+						.Text(LOCTEXT("BiggestWinCategoryColumn", "Category"))
+					]
+					+ SHeaderRow::Column(FName("Path"))
+					.HAlignCell(HAlign_Center)
+					.VAlignCell(VAlign_Center)
+					.HAlignHeader(HAlign_Center)
+					.HeaderContentPadding(FMargin(10.0f))
+					.FillWidth(0.65f)
+					[
+						SNew(STextBlock)
+						.Text(LOCTEXT("BiggestWinPathColumn", "Path"))
+					]
+					+ SHeaderRow::Column(FName("Size"))
+					.HAlignCell(HAlign_Center)
+					.VAlignCell(VAlign_Center)
+					.HAlignHeader(HAlign_Center)
+					.HeaderContentPadding(FMargin(10.0f))
+					.FillWidth(0.15f)
+					[
+						SNew(STextBlock)
+						.Text(LOCTEXT("BiggestWinSizeColumn", "Size"))
+					]
+				)
+			]
+		]
+	];
+}
+
+void SProjectCleanerBiggestWinsUI::SetCleanerManager(FProjectCleanerManager* CleanerManagerPtr)
+{
+	if (!CleanerManagerPtr) return;
+	CleanerManager = CleanerManagerPtr;
+	
+	UpdateUI();
+}
+
+void SProjectCleanerBiggestWinsUI::UpdateUI()
+{
+	if (!CleanerManager) return;
+
+	BiggestWins.Reset();
+	AddRows(ECleanerBiggestWinType::UnusedAsset, CleanerManager->GetBiggestUnusedAssets());
+	AddRows(ECleanerBiggestWinType::NonEngineFile, CleanerManager->GetBiggestNonEngineFiles());
+	AddRows(ECleanerBiggestWinType::UnusedFolder, CleanerManager->GetBiggestUnusedFolders());
+
+	if (ListView.IsValid())
+	{
+		ListView->RequestListRefresh();
+	}
+}
+
+void SProjectCleanerBiggestWinsUI::MarkDirty()
+{
+	bDirty = true;
+}
+
+void SProjectCleanerBiggestWinsUI::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	if (!bDirty) return;
+
+	bDirty = false;
+	UpdateUI();
+}
+
+void SProjectCleanerBiggestWinsUI::AddRows(const ECleanerBiggestWinType Type, const FCleanerTopK& TopK)
+{
+	TArray<FCleanerTopK::FEntry> Entries;
+	TopK.GetSorted(Entries);
+
+	for (const auto& Entry : Entries)
+	{
+		const TSharedPtr<FCleanerBiggestWinRow> Row = MakeShared<FCleanerBiggestWinRow>();
+		Row->Type = Type;
+		Row->Name = Entry.Name;
+		Row->Size = Entry.Size;
+		BiggestWins.Add(Row);
+	}
+}
+
+TSharedRef<ITableRow> SProjectCleanerBiggestWinsUI::OnGenerateRow(TSharedPtr<FCleanerBiggestWinRow> InItem,
+                                                                  const TSharedRef<STableViewBase>& OwnerTable) const
+{
+	return SNew(SBiggestWinUISelectionRow, OwnerTable).SelectedRowItem(InItem);
+}
+
+void SProjectCleanerBiggestWinsUI::OnMouseDoubleClick(TSharedPtr<FCleanerBiggestWinRow> Item) const
+{
+	if (!Item.IsValid()) return;
+
+	if (Item->Type == ECleanerBiggestWinType::NonEngineFile)
+	{
+		const auto DirectoryPath = FPaths::GetPath(Item->Name.ToString());
+		if (!FPaths::DirectoryExists(DirectoryPath)) return;
+
+		FPlatformProcess::ExploreFolder(*DirectoryPath);
+		return;
+	}
+
+	const FContentBrowserModule& CBModule = FModuleManager::Get().LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
+	if (Item->Type == ECleanerBiggestWinType::UnusedFolder)
+	{
+		CBModule.Get().SyncBrowserToFolders(TArray<FString>{Item->Name.ToString()});
+		return;
+	}
+
+	TArray<FAssetData> Assets;
+	const FAssetRegistryModule& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName);
+	AssetRegistry.Get().GetAssetsByPackageName(Item->Name, Assets);
+	if (Assets.Num() > 0)
+	{
+		CBModule.Get().SyncBrowserToAssets(Assets);
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -5,7 +5,7 @@
 #include "Core/ProjectCleanerUtility.h"
 #include "Core/ProjectCleanerManager.h"
 // Engine Headers
-#include "Widgets/Layout/SScrollBox.h"
+#include "Widgets/Input/SSearchBox.h"
 
 #define LOCTEXT_NAMESPACE "FProjectCleanerModule"
 
@@ -22,75 +22,82 @@ void SProjectCleanerCorruptedFilesUI::Construct(const FArguments& InArgs)
 		+ SOverlay::Slot()
 		.Padding(20.0f)
 		[
-			SNew(SScrollBox)
-			+ SScrollBox::Slot()
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot()
+			.AutoHeight()
 			[
 				SNew(SVerticalBox)
+				+SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SNew(STextBlock)
+					.AutoWrapText(true)
+					.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light20"))
+					.Text(LOCTEXT("corrupted_files", "Corrupted Files"))
+				]
+				+SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(FMargin{0.0f, 10.0f})
+				[
+					SNew(STextBlock)
+					.AutoWrapText(true)
+					.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light10"))
+					.Text(LOCTEXT("corrupted_files_fix_text", "How to fix?:\n\t1.Close Editor\n\t2.Delete files manually from Windows explorer"))
+				]
 				+ SVerticalBox::Slot()
+				.Padding(FMargin{ 0.0f, 10.0f })
 				.AutoHeight()
 				[
-					SNew(SVerticalBox)
-					+SVerticalBox::Slot()
-					.AutoHeight()
-					[
-						SNew(STextBlock)
-						.AutoWrapText(true)
-						.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light20"))
-						.Text(LOCTEXT("corrupted_files", "Corrupted Files"))
-					]
-					+SVerticalBox::Slot()
-					.AutoHeight()
-					.Padding(FMargin{0.0f, 10.0f})
+					SNew(STextBlock)
+					.AutoWrapText(true)
+					.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light10"))
+					.Text(LOCTEXT("corrupted_files_dbl_click_on_row", "Double click on row to open in Explorer"))
+				]
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SSearchBox)
+				.HintText(LOCTEXT("corrupted_files_search_hint", "Search files..."))
+				.OnTextChanged(this, &SProjectCleanerCorruptedFilesUI::OnFilterTextChanged)
+			]
+			+ SVerticalBox::Slot()
+			.FillHeight(1.0f)
+			.Padding(FMargin{ 0.0f, 20.0f })
+			[
+				SAssignNew(ListView, SListView<TSharedPtr<FCleanerCorruptedFileRow>>)
+				.ListItemsSource(&FilteredCorruptedFiles)
+				.SelectionMode(ESelectionMode::SingleToggle)
+				.OnGenerateRow(this, &SProjectCleanerCorruptedFilesUI::OnGenerateRow)
+				.OnMouseButtonDoubleClick_Raw(this, &SProjectCleanerCorruptedFilesUI::OnMouseDoubleClick)
+				.HeaderRow
+				(
+					SNew(SHeaderRow)
+					+ SHeaderRow::Column(FName("Name"))
+					.HAlignCell(HAlign_Center)
+					.VAlignCell(VAlign_Center)
+					.HAlignHeader(HAlign_Center)
+					.HeaderContentPadding(FMargin(10.0f))
+					.FillWidth(0.3f)
+					.SortMode(this, &SProjectCleanerCorruptedFilesUI::GetSortMode, FName("Name"))
+					.OnSort(this, &SProjectCleanerCorruptedFilesUI::OnSort)
 					[
 						SNew(STextBlock)
-						.AutoWrapText(true)
-						.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light10"))
-						.Text(LOCTEXT("corrupted_files_fix_text", "How to fix?:\n\t1.Close Editor\n\t2.Delete files manually from Windows explorer"))
+						.Text(LOCTEXT("NameColumn", "Name"))
 					]
-					+ SVerticalBox::Slot()
-					.Padding(FMargin{ 0.0f, 10.0f })
-					.AutoHeight()
+					+ SHeaderRow::Column(FName("AbsolutePath"))
+					.HAlignCell(HAlign_Center)
+					.VAlignCell(VAlign_Center)
+					.HAlignHeader(HAlign_Center)
+					.HeaderContentPadding(FMargin(10.0f))
+					.FillWidth(0.7f)
+					.SortMode(this, &SProjectCleanerCorruptedFilesUI::GetSortMode, FName("AbsolutePath"))
+					.OnSort(this, &SProjectCleanerCorruptedFilesUI::OnSort)
 					[
 						SNew(STextBlock)
-						.AutoWrapText(true)
-						.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light10"))
-						.Text(LOCTEXT("corrupted_files_dbl_click_on_row", "Double click on row to open in Explorer"))
+						.Text(LOCTEXT("PathColumn", "FilePath"))
 					]
-				]
-				+ SVerticalBox::Slot()
-				.AutoHeight()
-				.Padding(FMargin{ 0.0f, 20.0f })
-				[
-					SAssignNew(ListView, SListView<TWeakObjectPtr<UCorruptedFile>>)
-					.ListItemsSource(&CorruptedFiles)
-					.SelectionMode(ESelectionMode::SingleToggle)
-					.OnGenerateRow(this, &SProjectCleanerCorruptedFilesUI::OnGenerateRow)
-					.OnMouseButtonDoubleClick_Raw(this, &SProjectCleanerCorruptedFilesUI::OnMouseDoubleClick)
-					.HeaderRow
-					(
-						SNew(SHeaderRow)
-						+ SHeaderRow::Column(FName("Name"))
-						.HAlignCell(HAlign_Center)
-						.VAlignCell(VAlign_Center)
-						.HAlignHeader(HAlign_Center)
-						.HeaderContentPadding(FMargin(10.0f))
-						.FillWidth(0.3f)
-						[
-							SNew(STextBlock)
-							.Text(LOCTEXT("NameColumn", "Name"))
-						]
-						+ SHeaderRow::Column(FName("AbsolutePath"))
-						.HAlignCell(HAlign_Center)
-						.VAlignCell(VAlign_Center)
-						.HAlignHeader(HAlign_Center)
-						.HeaderContentPadding(FMargin(10.0f))
-						.FillWidth(0.7f)
-						[
-							SNew(STextBlock)
-							.Text(LOCTEXT("PathColumn", "FilePath"))
-						]
-					)
-				]
+				)
 			]
 		]
 	];
@@ -107,39 +114,141 @@ void SProjectCleanerCorruptedFilesUI::SetCleanerManager(FProjectCleanerManager*
 void SProjectCleanerCorruptedFilesUI::UpdateUI()
 {
 	if (!CleanerManager) return;
-	
-	CorruptedFiles.Reset();
-	CorruptedFiles.Reserve(CleanerManager->GetCorruptedAssets().Num());
 
-	for (const auto File : CleanerManager->GetCorruptedAssets())
+	const TSet<FName>& Files = CleanerManager->GetCorruptedAssets();
+
+	// diffing with previous result, rows that stayed keep their list widgets
+	TMap<FName, TSharedPtr<FCleanerCorruptedFileRow>> PreviousRows = MoveTemp(RowsByFile);
+	RowsByFile.Reset();
+	RowsByFile.Reserve(Files.Num());
+
+	bool bChanged = PreviousRows.Num() != Files.Num();
+	TArray<TSharedPtr<FCleanerCorruptedFileRow>> NewRows;
+	NewRows.Reserve(Files.Num());
+
+	// CorruptedAssets is set already, so no need to check duplicates here
+	for (const auto& File : Files)
 	{
-		const auto& CorruptedFile = NewObject<UCorruptedFile>();
-		CorruptedFile->Name = FPaths::GetBaseFilename(File.ToString());
-		CorruptedFile->AbsolutePath = ProjectCleanerUtility::ConvertInternalToAbsolutePath(File.ToString());
-		CorruptedFiles.AddUnique(CorruptedFile);
+		TSharedPtr<FCleanerCorruptedFileRow> CorruptedFile;
+		if (!PreviousRows.RemoveAndCopyValue(File, CorruptedFile))
+		{
+			CorruptedFile = MakeShared<FCleanerCorruptedFileRow>();
+			CorruptedFile->Name = FPaths::GetBaseFilename(File.ToString());
+			CorruptedFile->AbsolutePath = ProjectCleanerUtility::ConvertInternalToAbsolutePath(File.ToString());
+			bChanged = true;
+		}
+
+		RowsByFile.Add(File, CorruptedFile);
+		NewRows.Add(CorruptedFile);
 	}
 
-	if (ListView.IsValid())
+	if (!bChanged) return;
+
+	CorruptedFiles = MoveTemp(NewRows);
+
+	TArray<FString> SearchEntries;
+	SearchEntries.Reserve(CorruptedFiles.Num());
+	for (const auto& Row : CorruptedFiles)
 	{
-		ListView->SetListItemsSource(CorruptedFiles);
-		ListView->RebuildList();
+		SearchEntries.Add(Row->AbsolutePath);
 	}
+	SearchIndex.Build(SearchEntries);
+
+	ApplyFilter();
+}
+
+void SProjectCleanerCorruptedFilesUI::MarkDirty()
+{
+	bDirty = true;
 }
 
-TSharedRef<ITableRow> SProjectCleanerCorruptedFilesUI::OnGenerateRow(TWeakObjectPtr<UCorruptedFile> InItem,
+void SProjectCleanerCorruptedFilesUI::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	if (!bDirty) return;
+
+	bDirty = false;
+	UpdateUI();
+}
+
+TSharedRef<ITableRow> SProjectCleanerCorruptedFilesUI::OnGenerateRow(TSharedPtr<FCleanerCorruptedFileRow> InItem,
                                                                      const TSharedRef<STableViewBase>& OwnerTable) const
 {
 	return SNew(SCorruptedFileUISelectionRow, OwnerTable).SelectedRowItem(InItem);
 }
 
-void SProjectCleanerCorruptedFilesUI::OnMouseDoubleClick(TWeakObjectPtr<UCorruptedFile> Item) const
+void SProjectCleanerCorruptedFilesUI::OnMouseDoubleClick(TSharedPtr<FCleanerCorruptedFileRow> Item) const
 {
 	if (!Item.IsValid()) return;
 
-	const auto DirectoryPath = FPaths::GetPath(Item.Get()->AbsolutePath);
+	const auto DirectoryPath = FPaths::GetPath(Item->AbsolutePath);
 	if (!FPaths::DirectoryExists(DirectoryPath)) return;
 	
 	FPlatformProcess::ExploreFolder(*DirectoryPath);
 }
 
+void SProjectCleanerCorruptedFilesUI::OnFilterTextChanged(const FText& InFilterText)
+{
+	FilterText = InFilterText.ToString();
+	ApplyFilter();
+}
+
+void SProjectCleanerCorruptedFilesUI::ApplyFilter()
+{
+	if (FilterText.IsEmpty())
+	{
+		FilteredCorruptedFiles = CorruptedFiles;
+	}
+	else
+	{
+		TArray<int32> Indices;
+		SearchIndex.Query(FilterText, Indices);
+
+		FilteredCorruptedFiles.Reset(Indices.Num());
+		for (const int32 Index : Indices)
+		{
+			FilteredCorruptedFiles.Add(CorruptedFiles[Index]);
+		}
+	}
+
+	SortRows();
+
+	if (ListView.IsValid())
+	{
+		ListView->RequestListRefresh();
+	}
+}
+
+void SProjectCleanerCorruptedFilesUI::OnSort(EColumnSortPriority::Type SortPriority, const FName& ColumnName, EColumnSortMode::Type InSortMode)
+{
+	SortColumn = ColumnName;
+	SortMode = InSortMode;
+
+	SortRows();
+
+	if (ListView.IsValid())
+	{
+		ListView->RequestListRefresh();
+	}
+}
+
+EColumnSortMode::Type SProjectCleanerCorruptedFilesUI::GetSortMode(const FName ColumnName) const
+{
+	return SortColumn.IsEqual(ColumnName) ? SortMode : EColumnSortMode::None;
+}
+
+void SProjectCleanerCorruptedFilesUI::SortRows()
+{
+	const bool bAscending = SortMode != EColumnSortMode::Descending;
+	const bool bByName = SortColumn.IsEqual(TEXT("Name"));
+
+	FilteredCorruptedFiles.Sort([&] (const TSharedPtr<FCleanerCorruptedFileRow>& A, const TSharedPtr<FCleanerCorruptedFileRow>& B)
+	{
+		const FString& KeyA = bByName ? A->Name : A->AbsolutePath;
+		const FString& KeyB = bByName ? B->Name : B->AbsolutePath;
+		return bAscending ? KeyA < KeyB : KeyB < KeyA;
+	});
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
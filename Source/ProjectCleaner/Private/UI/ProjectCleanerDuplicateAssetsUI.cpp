@@ -0,0 +1,304 @@
+﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "UI/ProjectCleanerDuplicateAssetsUI.h"
+#include "UI/ProjectCleanerStyle.h"
+#include "Core/ProjectCleanerManager.h"
+// Engine Headers
+#include "IContentBrowserSingleton.h"
+#include "Editor/ContentBrowser/Public/ContentBrowserModule.h"
+#include "Widgets/Input/SSearchBox.h"
+
+#define LOCTEXT_NAMESPACE "FProjectCleanerModule"
+
+void SProjectCleanerDuplicateAssetsUI::Construct(const FArguments& InArgs)
+{
+	if (InArgs._CleanerManager)
+	{
+		SetCleanerManager(InArgs._CleanerManager);
+	}
+
+	ChildSlot
+	[
+		SNew(SOverlay)
+		+ SOverlay::Slot()
+		.Padding(20.0f)
+		[
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SVerticalBox)
+				+SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SNew(STextBlock)
+					.AutoWrapText(true)
+					.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light20"))
+					.Text(LOCTEXT("duplicate_assets", "Duplicate Assets"))
+				]
+				+SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(FMargin{0.0f, 10.0f})
+				[
+					SNew(STextBlock)
+					.AutoWrapText(true)
+					.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light10"))
+					.Text(this, &SProjectCleanerDuplicateAssetsUI::GetSummaryText)
+				]
+				+ SVerticalBox::Slot()
+				.Padding(FMargin{ 0.0f, 10.0f })
+				.AutoHeight()
+				[
+					SNew(STextBlock)
+					.AutoWrapText(true)
+					.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light10"))
+					.Text(LOCTEXT("duplicate_assets_dbl_click_on_row", "Assets in same group have same content. Double click on row to find asset in Content Browser"))
+				]
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SSearchBox)
+				.HintText(LOCTEXT("duplicate_assets_search_hint", "Search assets..."))
+				.OnTextChanged(this, &SProjectCleanerDuplicateAssetsUI::OnFilterTextChanged)
+			]
+			+ SVerticalBox::Slot()
+			.FillHeight(1.0f)
+			.Padding(FMargin{ 0.0f, 20.0f })
+			[
+				SAssignNew(ListView, SListView<TSharedPtr<FCleanerDuplicateAssetRow>>)
+				.ListItemsSource(&FilteredDuplicateAssets)
+				.SelectionMode(ESelectionMode::SingleToggle)
+				.OnGenerateRow(this, &SProjectCleanerDuplicateAssetsUI::OnGenerateRow)
+				.OnMouseButtonDoubleClick_Raw(this, &SProjectCleanerDuplicateAssetsUI::OnMouseDoubleClick)
+				.HeaderRow
+				(
+					SNew(SHeaderRow)
+					+ SHeaderRow::Column(FName("Group"))
+					.HAlignCell(HAlign_Center)
+					.VAlignCell(VAlign_Center)
+					.HAlignHeader(HAlign_Center)
+					.HeaderContentPadding(FMargin(10.0f))
+					.FillWidth(0.15f)
+					.SortMode(this, &SProjectCleanerDuplicateAssetsUI::GetSortMode, FName("Group"))
+					.OnSort(this, &SProjectCleanerDuplicateAssetsUI::OnSort)
+					[
+						SNew(STextBlock)
+						.Text(LOCTEXT("DuplicateGroupColumn", "Group"))
+					]
+					+ SHeaderRow::Column(FName("Name"))
+					.HAlignCell(HAlign_Center)
+					.VAlignCell(VAlign_Center)
+					.HAlignHeader(HAlign_Center)
+					.HeaderContentPadding(FMargin(10.0f))
+					.FillWidth(0.2f)
+					.SortMode(this, &SProjectCleanerDuplicateAssetsUI::GetSortMode, FName("Name"))
+					.OnSort(this, &SProjectCleanerDuplicateAssetsUI::OnSort)
+					[
+						SNew(STextBlock)
+						.Text(LOCTEXT("DuplicateNameColumn", "Name"))
+					]
+					+ SHeaderRow::Column(FName("Path"))
+					.HAlignCell(HAlign_Center)
+					.VAlignCell(VAlign_Center)
+					.HAlignHeader(HAlign_Center)
+					.HeaderContentPadding(FMargin(10.0f))
+					.FillWidth(0.4f)
+					.SortMode(this, &SProjectCleanerDuplicateAssetsUI::GetSortMode, FName("Path"))
+					.OnSort(this, &SProjectCleanerDuplicateAssetsUI::OnSort)
+					[
+						SNew(STextBlock)
+						.Text(LOCTEXT("DuplicatePathColumn", "Path"))
+					]
+					+ SHeaderRow::Column(FName("Class"))
+					.HAlignCell(HAlign_Center)
+					.VAlignCell(VAlign_Center)
+					.HAlignHeader(HAlign_Center)
+					.HeaderContentPadding(FMargin(10.0f))
+					.FillWidth(0.15f)
+					.SortMode(this, &SProjectCleanerDuplicateAssetsUI::GetSortMode, FName("Class"))
+					.OnSort(this, &SProjectCleanerDuplicateAssetsUI::OnSort)
+					[
+						SNew(STextBlock)
+						.Text(LOCTEXT("DuplicateClassColumn", "Class"))
+					]
+					+ SHeaderRow::Column(FName("Size"))
+					.HAlignCell(HAlign_Center)
+					.VAlignCell(VAlign_Center)
+					.HAlignHeader(HAlign_Center)
+					.HeaderContentPadding(FMargin(10.0f))
+					.FillWidth(0.1f)
+					.SortMode(this, &SProjectCleanerDuplicateAssetsUI::GetSortMode, FName("Size"))
+					.OnSort(this, &SProjectCleanerDuplicateAssetsUI::OnSort)
+					[
+						SNew(STextBlock)
+						.Text(LOCTEXT("DuplicateSizeColumn", "Size"))
+					]
+				)
+			]
+		]
+	];
+}
+
+void SProjectCleanerDuplicateAssetsUI::SetCleanerManager(FProjectCleanerManager* CleanerManagerPtr)
+{
+	if (!CleanerManagerPtr) return;
+	CleanerManager = CleanerManagerPtr;
+	
+	UpdateUI();
+}
+
+void SProjectCleanerDuplicateAssetsUI::UpdateUI()
+{
+	if (!CleanerManager) return;
+
+	const TArray<FCleanerDuplicateGroup>& Groups = CleanerManager->GetDuplicateGroups();
+	const FProjectCleanerDataManager& DataManager = CleanerManager->GetDataManager();
+
+	// groups are small and rebuilt only when duplicate stage runs, so no diffing with previous rows
+	DuplicateAssets.Reset();
+	GroupsNum = Groups.Num();
+	WastedSize = 0;
+
+	for (int32 GroupIndex = 0; GroupIndex < Groups.Num(); ++GroupIndex)
+	{
+		const FCleanerDuplicateGroup& Group = Groups[GroupIndex];
+		WastedSize += Group.WastedSize;
+
+		for (const auto& Asset : Group.Assets)
+		{
+			const TSharedPtr<FCleanerDuplicateAssetRow> Row = MakeShared<FCleanerDuplicateAssetRow>();
+			Row->GroupIndex = GroupIndex;
+			Row->GroupAssetsNum = Group.Assets.Num();
+			Row->GroupSimilarity = Group.Similarity;
+			Row->Size = DataManager.GetPackageSize(Asset.PackageName);
+			Row->AssetName = Asset.AssetName.ToString();
+			Row->AssetPath = Asset.PackagePath.ToString();
+			Row->AssetClass = Group.AssetClass.ToString();
+			Row->AssetData = Asset;
+			DuplicateAssets.Add(Row);
+		}
+	}
+
+	TArray<FString> SearchEntries;
+	SearchEntries.Reserve(DuplicateAssets.Num());
+	for (const auto& Row : DuplicateAssets)
+	{
+		SearchEntries.Add(Row->AssetPath / Row->AssetName);
+	}
+	SearchIndex.Build(SearchEntries);
+
+	ApplyFilter();
+}
+
+void SProjectCleanerDuplicateAssetsUI::MarkDirty()
+{
+	bDirty = true;
+}
+
+void SProjectCleanerDuplicateAssetsUI::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	if (!bDirty) return;
+
+	bDirty = false;
+	UpdateUI();
+}
+
+TSharedRef<ITableRow> SProjectCleanerDuplicateAssetsUI::OnGenerateRow(TSharedPtr<FCleanerDuplicateAssetRow> InItem,
+                                                                      const TSharedRef<STableViewBase>& OwnerTable) const
+{
+	return SNew(SDuplicateAssetUISelectionRow, OwnerTable).SelectedRowItem(InItem);
+}
+
+void SProjectCleanerDuplicateAssetsUI::OnMouseDoubleClick(TSharedPtr<FCleanerDuplicateAssetRow> Item) const
+{
+	if (!Item.IsValid()) return;
+
+	const FContentBrowserModule& CBModule = FModuleManager::Get().LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
+	CBModule.Get().SyncBrowserToAssets(TArray<FAssetData>{Item->AssetData});
+}
+
+void SProjectCleanerDuplicateAssetsUI::OnFilterTextChanged(const FText& InFilterText)
+{
+	FilterText = InFilterText.ToString();
+	ApplyFilter();
+}
+
+void SProjectCleanerDuplicateAssetsUI::ApplyFilter()
+{
+	if (FilterText.IsEmpty())
+	{
+		FilteredDuplicateAssets = DuplicateAssets;
+	}
+	else
+	{
+		TArray<int32> Indices;
+		SearchIndex.Query(FilterText, Indices);
+
+		FilteredDuplicateAssets.Reset(Indices.Num());
+		for (const int32 Index : Indices)
+		{
+			FilteredDuplicateAssets.Add(DuplicateAssets[Index]);
+		}
+	}
+
+	SortRows();
+
+	if (ListView.IsValid())
+	{
+		ListView->RequestListRefresh();
+	}
+}
+
+void SProjectCleanerDuplicateAssetsUI::OnSort(EColumnSortPriority::Type SortPriority, const FName& ColumnName, EColumnSortMode::Type InSortMode)
+{
+	SortColumn = ColumnName;
+	SortMode = InSortMode;
+
+	SortRows();
+
+	if (ListView.IsValid())
+	{
+		ListView->RequestListRefresh();
+	}
+}
+
+EColumnSortMode::Type SProjectCleanerDuplicateAssetsUI::GetSortMode(const FName ColumnName) const
+{
+	return SortColumn.IsEqual(ColumnName) ? SortMode : EColumnSortMode::None;
+}
+
+void SProjectCleanerDuplicateAssetsUI::SortRows()
+{
+	const bool bAscending = SortMode != EColumnSortMode::Descending;
+
+	// rows of same group stay together when sorting by group or size
+	FilteredDuplicateAssets.StableSort([&] (const TSharedPtr<FCleanerDuplicateAssetRow>& A, const TSharedPtr<FCleanerDuplicateAssetRow>& B)
+	{
+		if (SortColumn.IsEqual(TEXT("Group")))
+		{
+			return bAscending ? A->GroupIndex < B->GroupIndex : B->GroupIndex < A->GroupIndex;
+		}
+		if (SortColumn.IsEqual(TEXT("Size")))
+		{
+			return bAscending ? A->Size < B->Size : B->Size < A->Size;
+		}
+
+		const FString& KeyA = SortColumn.IsEqual(TEXT("Name")) ? A->AssetName : SortColumn.IsEqual(TEXT("Class")) ? A->AssetClass : A->AssetPath;
+		const FString& KeyB = SortColumn.IsEqual(TEXT("Name")) ? B->AssetName : SortColumn.IsEqual(TEXT("Class")) ? B->AssetClass : B->AssetPath;
+		return bAscending ? KeyA < KeyB : KeyB < KeyA;
+	});
+}
+
+FText SProjectCleanerDuplicateAssetsUI::GetSummaryText() const
+{
+	return FText::Format(
+		LOCTEXT("duplicate_assets_summary", "{0} groups, {1} can be freed by keeping one asset per group"),
+		FText::AsNumber(GroupsNum),
+		FText::AsMemory(WastedSize)
+	);
+}
+
+#undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -4,11 +4,13 @@
 #include "UI/ProjectCleanerCommands.h"
 #include "UI/ProjectCleanerStyle.h"
 #include "Core/ProjectCleanerManager.h"
+#include "Core/ProjectCleanerUtility.h"
 #include "StructsContainer.h"
 // Engine Headers
 #include "IContentBrowserSingleton.h"
 #include "Editor/ContentBrowser/Public/ContentBrowserModule.h"
 #include "Widgets/Layout/SScrollBox.h"
+#include "Widgets/Input/SSearchBox.h"
 #include "Toolkits/GlobalEditorCommonCommands.h"
 
 #define LOCTEXT_NAMESPACE "FProjectCleanerModule"
@@ -40,6 +42,12 @@ void SProjectCleanerExcludedAssetsUI::Construct(const FArguments& InArgs)
 	AssetPickerConfig.bCanShowFolders = true;
 	AssetPickerConfig.AssetShowWarningText = FText::FromName("No assets");
 	AssetPickerConfig.GetCurrentSelectionDelegates.Add(&GetCurrentSelectionDelegate);
+	AssetPickerConfig.RefreshAssetViewDelegates.Add(&RefreshAssetViewDelegate);
+	AssetPickerConfig.SetFilterDelegates.Add(&SetFilterDelegate);
+	AssetPickerConfig.OnShouldFilterAsset = FOnShouldFilterAsset::CreateRaw(
+		this,
+		&SProjectCleanerExcludedAssetsUI::OnShouldFilterAsset
+	);
 	AssetPickerConfig.OnAssetDoubleClicked = FOnAssetDoubleClicked::CreateStatic(
 		&SProjectCleanerExcludedAssetsUI::OnAssetDblClicked
 	);
@@ -58,54 +66,13 @@ void SProjectCleanerExcludedAssetsUI::Construct(const FArguments& InArgs)
 	PathPickerConfig.OnGetFolderContextMenu = FOnGetFolderContextMenu::CreateSP(
 		this, &SProjectCleanerExcludedAssetsUI::OnGetFolderContextMenu
 	);
-	
-	UpdateUI();
-}
 
-void SProjectCleanerExcludedAssetsUI::SetCleanerManager(FProjectCleanerManager* CleanerManagerPtr)
-{
-	if (!CleanerManagerPtr) return;
-	CleanerManager = CleanerManagerPtr;
-}
-
-void SProjectCleanerExcludedAssetsUI::RegisterCommands()
-{
-	FProjectCleanerCommands::Register();
-
-	Commands = MakeShareable(new FUICommandList);
-	Commands->MapAction(
-		FGlobalEditorCommonCommands::Get().FindInContentBrowser,
-		FUIAction(
-			FExecuteAction::CreateRaw(this, &SProjectCleanerExcludedAssetsUI::FindInContentBrowser),
-			FCanExecuteAction::CreateRaw(this, &SProjectCleanerExcludedAssetsUI::IsAnythingSelected)
-		)
-	);
+	GenerateFilter();
+	AssetPickerConfig.Filter = Filter;
 
-	Commands->MapAction(
-		FProjectCleanerCommands::Get().IncludeAsset,
-		FUIAction
-		(
-			FExecuteAction::CreateRaw(this,&SProjectCleanerExcludedAssetsUI::IncludeAssets),
-			FCanExecuteAction::CreateRaw(this, &SProjectCleanerExcludedAssetsUI::IsAnythingSelected)
-		)
-	);
+	RebuildSearchIndex();
 
-	Commands->MapAction(
-		FProjectCleanerCommands::Get().IncludePath,
-		FUIAction
-		(
-			FExecuteAction::CreateRaw(this,&SProjectCleanerExcludedAssetsUI::IncludePath)
-		)
-	);
-}
-
-void SProjectCleanerExcludedAssetsUI::UpdateUI()
-{
-	if (!ContentBrowserModule) return;
-	if (!CleanerManager->GetCleanerConfigs()) return;
-	
-	GenerateFilter();
-	
+	// pickers created only once, later updates done by refreshing them in place
 	ChildSlot
 	[
 		SNew(SSplitter)
@@ -155,9 +122,17 @@ void SProjectCleanerExcludedAssetsUI::UpdateUI()
 				]
 			]
 			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(10.0f, 0.0f)
+			[
+				SNew(SSearchBox)
+				.HintText(LOCTEXT("excluded_assets_search_hint", "Search excluded assets by path..."))
+				.OnTextChanged(this, &SProjectCleanerExcludedAssetsUI::OnSearchTextChanged)
+			]
+			+ SVerticalBox::Slot()
 			.Padding(10.0f, 10.0f)
 			[
-				SNew(SBox)
+				SAssignNew(AssetPickerBox, SBox)
 				.HeightOverride(300.0f)
 				.WidthOverride(300.0f)
 				[
@@ -168,6 +143,115 @@ void SProjectCleanerExcludedAssetsUI::UpdateUI()
 	];
 }
 
+void SProjectCleanerExcludedAssetsUI::SetCleanerManager(FProjectCleanerManager* CleanerManagerPtr)
+{
+	if (!CleanerManagerPtr) return;
+	CleanerManager = CleanerManagerPtr;
+}
+
+void SProjectCleanerExcludedAssetsUI::RegisterCommands()
+{
+	FProjectCleanerCommands::Register();
+
+	Commands = MakeShareable(new FUICommandList);
+	Commands->MapAction(
+		FGlobalEditorCommonCommands::Get().FindInContentBrowser,
+		FUIAction(
+			FExecuteAction::CreateRaw(this, &SProjectCleanerExcludedAssetsUI::FindInContentBrowser),
+			FCanExecuteAction::CreateRaw(this, &SProjectCleanerExcludedAssetsUI::IsAnythingSelected)
+		)
+	);
+
+	Commands->MapAction(
+		FProjectCleanerCommands::Get().IncludeAsset,
+		FUIAction
+		(
+			FExecuteAction::CreateRaw(this,&SProjectCleanerExcludedAssetsUI::IncludeAssets),
+			FCanExecuteAction::CreateRaw(this, &SProjectCleanerExcludedAssetsUI::IsAnythingSelected)
+		)
+	);
+
+	Commands->MapAction(
+		FProjectCleanerCommands::Get().IncludePath,
+		FUIAction
+		(
+			FExecuteAction::CreateRaw(this,&SProjectCleanerExcludedAssetsUI::IncludePath)
+		)
+	);
+}
+
+void SProjectCleanerExcludedAssetsUI::UpdateUI()
+{
+	if (!ContentBrowserModule) return;
+	if (!CleanerManager->GetCleanerConfigs()) return;
+
+	RebuildSearchIndex();
+
+	// developers folder visibility is picker creation option, so picker is recreated only when it changes
+	const bool bScanDeveloperContents = CleanerManager->GetCleanerConfigs()->bScanDeveloperContents;
+	if (AssetPickerBox.IsValid() && AssetPickerConfig.bCanShowDevelopersFolder != bScanDeveloperContents)
+	{
+		AssetPickerConfig.bCanShowDevelopersFolder = bScanDeveloperContents;
+		AssetPickerConfig.Filter = Filter;
+		AssetPickerBox->SetContent(ContentBrowserModule->Get().CreateAssetPicker(AssetPickerConfig));
+	}
+
+	// excluded assets set already updated in CleanerManager, so just asking picker to filter its items again
+	RefreshAssetViewDelegate.ExecuteIfBound(true);
+}
+
+void SProjectCleanerExcludedAssetsUI::MarkDirty()
+{
+	bDirty = true;
+}
+
+void SProjectCleanerExcludedAssetsUI::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	if (!bDirty) return;
+
+	bDirty = false;
+	UpdateUI();
+}
+
+void SProjectCleanerExcludedAssetsUI::OnSearchTextChanged(const FText& InSearchText)
+{
+	SearchText = InSearchText.ToString();
+	UpdateSearchMatches();
+	RefreshAssetViewDelegate.ExecuteIfBound(true);
+}
+
+void SProjectCleanerExcludedAssetsUI::RebuildSearchIndex()
+{
+	SearchPackages = CleanerManager->GetExcludedAssets().Array();
+
+	TArray<FString> SearchEntries;
+	SearchEntries.Reserve(SearchPackages.Num());
+	for (const auto& Package : SearchPackages)
+	{
+		SearchEntries.Add(Package.ToString());
+	}
+	SearchIndex.Build(SearchEntries);
+
+	UpdateSearchMatches();
+}
+
+void SProjectCleanerExcludedAssetsUI::UpdateSearchMatches()
+{
+	SearchMatches.Reset();
+	if (SearchText.IsEmpty()) return;
+
+	TArray<int32> Indices;
+	SearchIndex.Query(SearchText, Indices);
+
+	SearchMatches.Reserve(Indices.Num());
+	for (const int32 Index : Indices)
+	{
+		SearchMatches.Add(SearchPackages[Index]);
+	}
+}
+
 TSharedPtr<SWidget> SProjectCleanerExcludedAssetsUI::OnGetAssetContextMenu(const TArray<FAssetData>& SelectedAssets) const
 {
 	FMenuBuilder MenuBuilder{true, Commands};
@@ -177,6 +261,15 @@ TSharedPtr<SWidget> SProjectCleanerExcludedAssetsUI::OnGetAssetContextMenu(const
 		MenuBuilder.AddMenuEntry(FProjectCleanerCommands::Get().IncludeAsset);
 	}
 	MenuBuilder.EndSection();
+	if (CleanerManager)
+	{
+		FCleanerFootprint Footprint;
+		CleanerManager->GetDataManager().GetAssetsFootprint(SelectedAssets, Footprint);
+
+		MenuBuilder.BeginSection(TEXT("Footprint"), LOCTEXT("FootprintSectionLabel", "Footprint"));
+		MenuBuilder.AddWidget(SNew(STextBlock).Text(ProjectCleanerUtility::GetFootprintText(Footprint)), FText::GetEmpty());
+		MenuBuilder.EndSection();
+	}
 
 	return MenuBuilder.MakeWidget();
 }
@@ -190,6 +283,15 @@ TSharedPtr<SWidget> SProjectCleanerExcludedAssetsUI::OnGetFolderContextMenu(cons
 		MenuBuilder.AddMenuEntry(FProjectCleanerCommands::Get().IncludePath);
 	}
 	MenuBuilder.EndSection();
+	if (CleanerManager)
+	{
+		FCleanerFootprint Footprint;
+		CleanerManager->GetDataManager().GetFoldersFootprint(SelectedPaths, Footprint);
+
+		MenuBuilder.BeginSection(TEXT("Footprint"), LOCTEXT("FootprintSectionLabel", "Footprint"));
+		MenuBuilder.AddWidget(SNew(STextBlock).Text(ProjectCleanerUtility::GetFootprintText(Footprint)), FText::GetEmpty());
+		MenuBuilder.EndSection();
+	}
 
 	return MenuBuilder.MakeWidget();
 }
@@ -244,37 +346,29 @@ FReply SProjectCleanerExcludedAssetsUI::IncludeAllAssets() const
 
 void SProjectCleanerExcludedAssetsUI::GenerateFilter()
 {
+	// filter contains only selected path, excluded assets are filtered by OnShouldFilterAsset
 	Filter.Clear();
-	
-	if (CleanerManager->GetExcludedAssets().Num() == 0)
-	{
-		// this is needed for disabling showing primary assets in browser, when there is no unused assets
-		Filter.TagsAndValues.Add(FName{ "ProjectCleanerEmptyTag" }, FString{ "ProjectCleanerEmptyTag" });
-	}
-	else
-	{
-		Filter.PackageNames.Reserve(CleanerManager->GetExcludedAssets().Num());
-		for (const auto& Asset : CleanerManager->GetExcludedAssets())
-		{
-			Filter.PackageNames.Add(Asset);
-		}
-	}
 
 	if (!SelectedPath.IsNone())
 	{
 		Filter.PackagePaths.Add(SelectedPath);
 	}
-	
-	AssetPickerConfig.bCanShowDevelopersFolder = CleanerManager->GetCleanerConfigs()->bScanDeveloperContents;
-	AssetPickerConfig.Filter = Filter;
+}
+
+bool SProjectCleanerExcludedAssetsUI::OnShouldFilterAsset(const FAssetData& AssetData) const
+{
+	if (!SearchText.IsEmpty() && !SearchMatches.Contains(AssetData.PackageName)) return true;
+
+	return !CleanerManager->GetExcludedAssets().Contains(AssetData.PackageName);
 }
 
 void SProjectCleanerExcludedAssetsUI::OnPathSelected(const FString& Path)
 {
 	SelectedPath = FName{Path};
 	PathPickerConfig.DefaultPath = Path;
-	
-	UpdateUI();
+
+	GenerateFilter();
+	SetFilterDelegate.ExecuteIfBound(Filter);
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -3,7 +3,7 @@
 #include "UI/ProjectCleanerIndirectAssetsUI.h"
 #include "UI/ProjectCleanerStyle.h"
 // Engine Headers
-#include "Widgets/Layout/SScrollBox.h"
+#include "Widgets/Input/SSearchBox.h"
 #include "IContentBrowserSingleton.h"
 #include "Core/ProjectCleanerManager.h"
 #include "Editor/ContentBrowser/Public/ContentBrowserModule.h"
@@ -23,90 +23,101 @@ void SProjectCleanerIndirectAssetsUI::Construct(const FArguments& InArgs)
 		+ SOverlay::Slot()
 		.Padding(20.0f)
 		[
-			SNew(SScrollBox)
-			+ SScrollBox::Slot()
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot()
+			.AutoHeight()
 			[
-				SNew(SVerticalBox)
-				+ SVerticalBox::Slot()
-				.AutoHeight()
-				[
-					SNew(STextBlock)
-					.AutoWrapText(true)
-					.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light20"))
-					.Text(LOCTEXT("indirect_assets_title", "Assets Used Indirectly"))
-				]
-				+ SVerticalBox::Slot()
-				.Padding(FMargin{ 0.0f, 10.0f })
-				.AutoHeight()
-				[
-					SNew(STextBlock)
-					.AutoWrapText(true)
-					.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light15"))
-					.Text(LOCTEXT("indirect_assets_info", "List of assets that are used in source code, config or other files indirectly.\n"))
-				]
-				+ SVerticalBox::Slot()
-				.Padding(FMargin{0.0f, 10.0f})
-				.AutoHeight()
-				[
-					SNew(STextBlock)
-					.AutoWrapText(true)
-					.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light10"))
-					.Text(LOCTEXT("indirect_assets_dbl_click_on_row", "Double click on row to open in Explorer"))
-				]
-				+ SVerticalBox::Slot()
-				.AutoHeight()
-				.Padding(FMargin{0.0f, 20.0f})
-				[
-					SAssignNew(ListView, SListView<TWeakObjectPtr<UIndirectAsset>>)
-					.ListItemsSource(&IndirectAssets)
-					.SelectionMode(ESelectionMode::SingleToggle)
-					.OnGenerateRow(this, &SProjectCleanerIndirectAssetsUI::OnGenerateRow)
-					.OnMouseButtonDoubleClick_Raw(this, &SProjectCleanerIndirectAssetsUI::OnMouseDoubleClick)
-					.HeaderRow
-					(
-						SNew(SHeaderRow)
-						+ SHeaderRow::Column(FName("AssetName"))
-						.HAlignCell(HAlign_Center)
-						.VAlignCell(VAlign_Center)
-						.HAlignHeader(HAlign_Center)
-						.HeaderContentPadding(FMargin(10.0f))
-						.FillWidth(0.2f)
-						[
-							SNew(STextBlock)
-							.Text(LOCTEXT("AssetName", "Asset Name"))
-						]
-						+ SHeaderRow::Column(FName("AssetPath"))
-						.HAlignCell(HAlign_Center)
-						.VAlignCell(VAlign_Center)
-						.HAlignHeader(HAlign_Center)
-						.HeaderContentPadding(FMargin(10.0f))
-						.FillWidth(0.2f)
-						[
-							SNew(STextBlock)
-							.Text(LOCTEXT("AssetPath", "Asset Path"))
-						]
-						+ SHeaderRow::Column(FName("FilePath"))
-						.HAlignCell(HAlign_Center)
-						.VAlignCell(VAlign_Center)
-						.HAlignHeader(HAlign_Center)
-						.HeaderContentPadding(FMargin(10.0f))
-						.FillWidth(0.5f)
-						[
-							SNew(STextBlock)
-							.Text(LOCTEXT("FilePath", "File path"))
-						]
-						+ SHeaderRow::Column(FName("LineNum"))
-						.HAlignCell(HAlign_Center)
-						.VAlignCell(VAlign_Center)
-						.HAlignHeader(HAlign_Center)
-						.HeaderContentPadding(FMargin(10.0f))
-						.FillWidth(0.1f)
-						[
-							SNew(STextBlock)
-							.Text(LOCTEXT("LineNum", "Line Number"))
-						]
-					)
-				]
+				SNew(STextBlock)
+				.AutoWrapText(true)
+				.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light20"))
+				.Text(LOCTEXT("indirect_assets_title", "Assets Used Indirectly"))
+			]
+			+ SVerticalBox::Slot()
+			.Padding(FMargin{ 0.0f, 10.0f })
+			.AutoHeight()
+			[
+				SNew(STextBlock)
+				.AutoWrapText(true)
+				.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light15"))
+				.Text(LOCTEXT("indirect_assets_info", "List of assets that are used in source code, config or other files indirectly.\n"))
+			]
+			+ SVerticalBox::Slot()
+			.Padding(FMargin{0.0f, 10.0f})
+			.AutoHeight()
+			[
+				SNew(STextBlock)
+				.AutoWrapText(true)
+				.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light10"))
+				.Text(LOCTEXT("indirect_assets_dbl_click_on_row", "Double click on row to open in Explorer"))
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SSearchBox)
+				.HintText(LOCTEXT("indirect_assets_search_hint", "Search assets or files..."))
+				.OnTextChanged(this, &SProjectCleanerIndirectAssetsUI::OnFilterTextChanged)
+			]
+			+ SVerticalBox::Slot()
+			.FillHeight(1.0f)
+			.Padding(FMargin{0.0f, 20.0f})
+			[
+				SAssignNew(ListView, SListView<TSharedPtr<FCleanerIndirectAssetRow>>)
+				.ListItemsSource(&FilteredIndirectAssets)
+				.SelectionMode(ESelectionMode::SingleToggle)
+				.OnGenerateRow(this, &SProjectCleanerIndirectAssetsUI::OnGenerateRow)
+				.OnMouseButtonDoubleClick_Raw(this, &SProjectCleanerIndirectAssetsUI::OnMouseDoubleClick)
+				.HeaderRow
+				(
+					SNew(SHeaderRow)
+					+ SHeaderRow::Column(FName("AssetName"))
+					.HAlignCell(HAlign_Center)
+					.VAlignCell(VAlign_Center)
+					.HAlignHeader(HAlign_Center)
+					.HeaderContentPadding(FMargin(10.0f))
+					.FillWidth(0.2f)
+					.SortMode(this, &SProjectCleanerIndirectAssetsUI::GetSortMode, FName("AssetName"))
+					.OnSort(this, &SProjectCleanerIndirectAssetsUI::OnSort)
+					[
+						SNew(STextBlock)
+						.Text(LOCTEXT("AssetName", "Asset Name"))
+					]
+					+ SHeaderRow::Column(FName("AssetPath"))
+					.HAlignCell(HAlign_Center)
+					.VAlignCell(VAlign_Center)
+					.HAlignHeader(HAlign_Center)
+					.HeaderContentPadding(FMargin(10.0f))
+					.FillWidth(0.2f)
+					.SortMode(this, &SProjectCleanerIndirectAssetsUI::GetSortMode, FName("AssetPath"))
+					.OnSort(this, &SProjectCleanerIndirectAssetsUI::OnSort)
+					[
+						SNew(STextBlock)
+						.Text(LOCTEXT("AssetPath", "Asset Path"))
+					]
+					+ SHeaderRow::Column(FName("FilePath"))
+					.HAlignCell(HAlign_Center)
+					.VAlignCell(VAlign_Center)
+					.HAlignHeader(HAlign_Center)
+					.HeaderContentPadding(FMargin(10.0f))
+					.FillWidth(0.5f)
+					.SortMode(this, &SProjectCleanerIndirectAssetsUI::GetSortMode, FName("FilePath"))
+					.OnSort(this, &SProjectCleanerIndirectAssetsUI::OnSort)
+					[
+						SNew(STextBlock)
+						.Text(LOCTEXT("FilePath", "File path"))
+					]
+					+ SHeaderRow::Column(FName("LineNum"))
+					.HAlignCell(HAlign_Center)
+					.VAlignCell(VAlign_Center)
+					.HAlignHeader(HAlign_Center)
+					.HeaderContentPadding(FMargin(10.0f))
+					.FillWidth(0.1f)
+					.SortMode(this, &SProjectCleanerIndirectAssetsUI::GetSortMode, FName("LineNum"))
+					.OnSort(this, &SProjectCleanerIndirectAssetsUI::OnSort)
+					[
+						SNew(STextBlock)
+						.Text(LOCTEXT("LineNum", "Line Number"))
+					]
+				)
 			]
 		]
 	];
@@ -124,41 +135,163 @@ void SProjectCleanerIndirectAssetsUI::UpdateUI()
 {
 	if (!CleanerManager) return;
 
-	IndirectAssets.Reset();
-	IndirectAssets.Reserve(CleanerManager->GetIndirectAssets().Num());
+	const TMap<FAssetData, FIndirectAsset>& Assets = CleanerManager->GetIndirectAssets();
 
-	for (const auto& IndirectFile : CleanerManager->GetIndirectAssets())
+	// diffing with previous result, rows that stayed keep their list widgets
+	TMap<FName, TSharedPtr<FCleanerIndirectAssetRow>> PreviousRows = MoveTemp(RowsByAsset);
+	RowsByAsset.Reset();
+	RowsByAsset.Reserve(Assets.Num());
+
+	bool bChanged = PreviousRows.Num() != Assets.Num();
+	TArray<TSharedPtr<FCleanerIndirectAssetRow>> NewRows;
+	NewRows.Reserve(Assets.Num());
+
+	for (const auto& IndirectFile : Assets)
 	{
-		const auto IndirectAsset = NewObject<UIndirectAsset>();
-		IndirectAsset->AssetName = IndirectFile.Key.AssetName.ToString();
-		IndirectAsset->AssetPath = IndirectFile.Value.RelativePath.ToString();
-		IndirectAsset->FilePath = IndirectFile.Value.File;
-		IndirectAsset->LineNum = IndirectFile.Value.Line;
-		
-		IndirectAssets.Add(IndirectAsset);
+		TSharedPtr<FCleanerIndirectAssetRow> IndirectAsset;
+		const bool bSameRow =
+			PreviousRows.RemoveAndCopyValue(IndirectFile.Key.ObjectPath, IndirectAsset) &&
+			IndirectAsset->FilePath.Equals(IndirectFile.Value.File) &&
+			IndirectAsset->LineNum == IndirectFile.Value.Line;
+
+		if (!bSameRow)
+		{
+			IndirectAsset = MakeShared<FCleanerIndirectAssetRow>();
+			IndirectAsset->AssetData = IndirectFile.Key;
+			IndirectAsset->AssetName = IndirectFile.Key.AssetName.ToString();
+			IndirectAsset->AssetPath = IndirectFile.Value.RelativePath.ToString();
+			IndirectAsset->FilePath = IndirectFile.Value.File;
+			IndirectAsset->LineNum = IndirectFile.Value.Line;
+			bChanged = true;
+		}
+
+		RowsByAsset.Add(IndirectFile.Key.ObjectPath, IndirectAsset);
+		NewRows.Add(IndirectAsset);
 	}
-	
-	if (ListView.IsValid())
+
+	if (!bChanged) return;
+
+	IndirectAssets = MoveTemp(NewRows);
+
+	// search index refers to rows by position, so source array order must stay the same until next update
+	// newline can't be typed in search box, so queries never match across both paths
+	TArray<FString> SearchEntries;
+	SearchEntries.Reserve(IndirectAssets.Num());
+	for (const auto& Row : IndirectAssets)
 	{
-		ListView->RebuildList();
+		SearchEntries.Add(Row->AssetPath + TEXT("\n") + Row->FilePath);
 	}
+	SearchIndex.Build(SearchEntries);
+
+	ApplyFilter();
+}
+
+void SProjectCleanerIndirectAssetsUI::MarkDirty()
+{
+	bDirty = true;
+}
+
+void SProjectCleanerIndirectAssetsUI::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	if (!bDirty) return;
+
+	bDirty = false;
+	UpdateUI();
 }
 
 TSharedRef<ITableRow> SProjectCleanerIndirectAssetsUI::OnGenerateRow(
-	TWeakObjectPtr<UIndirectAsset> InItem,
+	TSharedPtr<FCleanerIndirectAssetRow> InItem,
 	const TSharedRef<STableViewBase>& OwnerTable) const
 {
 	return SNew(SIndirectAssetsUISelectionRow, OwnerTable).SelectedRowItem(InItem);
 }
 
-void SProjectCleanerIndirectAssetsUI::OnMouseDoubleClick(TWeakObjectPtr<UIndirectAsset> Item) const
+void SProjectCleanerIndirectAssetsUI::OnMouseDoubleClick(TSharedPtr<FCleanerIndirectAssetRow> Item) const
 {
 	if (!Item.IsValid()) return;
 
-	const auto DirectoryPath = FPaths::GetPath(Item.Get()->FilePath);
+	const auto DirectoryPath = FPaths::GetPath(Item->FilePath);
 	if (!FPaths::DirectoryExists(DirectoryPath)) return;
 
 	FPlatformProcess::ExploreFolder(*DirectoryPath);
 }
 
-#undef LOCTEXT_NAMESPACE
\ No newline at end of file
+void SProjectCleanerIndirectAssetsUI::OnFilterTextChanged(const FText& InFilterText)
+{
+	FilterText = InFilterText.ToString();
+	ApplyFilter();
+}
+
+void SProjectCleanerIndirectAssetsUI::ApplyFilter()
+{
+	if (FilterText.IsEmpty())
+	{
+		FilteredIndirectAssets = IndirectAssets;
+	}
+	else
+	{
+		TArray<int32> Indices;
+		SearchIndex.Query(FilterText, Indices);
+
+		FilteredIndirectAssets.Reset(Indices.Num());
+		for (const int32 Index : Indices)
+		{
+			FilteredIndirectAssets.Add(IndirectAssets[Index]);
+		}
+	}
+
+	SortRows();
+
+	if (ListView.IsValid())
+	{
+		ListView->RequestListRefresh();
+	}
+}
+
+void SProjectCleanerIndirectAssetsUI::OnSort(EColumnSortPriority::Type SortPriority, const FName& ColumnName, EColumnSortMode::Type InSortMode)
+{
+	SortColumn = ColumnName;
+	SortMode = InSortMode;
+
+	SortRows();
+
+	if (ListView.IsValid())
+	{
+		ListView->RequestListRefresh();
+	}
+}
+
+EColumnSortMode::Type SProjectCleanerIndirectAssetsUI::GetSortMode(const FName ColumnName) const
+{
+	return SortColumn.IsEqual(ColumnName) ? SortMode : EColumnSortMode::None;
+}
+
+void SProjectCleanerIndirectAssetsUI::SortRows()
+{
+	const bool bAscending = SortMode != EColumnSortMode::Descending;
+
+	if (SortColumn.IsEqual(TEXT("LineNum")))
+	{
+		FilteredIndirectAssets.Sort([&] (const TSharedPtr<FCleanerIndirectAssetRow>& A, const TSharedPtr<FCleanerIndirectAssetRow>& B)
+		{
+			return bAscending ? A->LineNum < B->LineNum : B->LineNum < A->LineNum;
+		});
+		return;
+	}
+
+	const auto GetKey = [&] (const FCleanerIndirectAssetRow& Row) -> const FString&
+	{
+		if (SortColumn.IsEqual(TEXT("AssetName"))) return Row.AssetName;
+		if (SortColumn.IsEqual(TEXT("FilePath"))) return Row.FilePath;
+		return Row.AssetPath;
+	};
+
+	FilteredIndirectAssets.Sort([&] (const TSharedPtr<FCleanerIndirectAssetRow>& A, const TSharedPtr<FCleanerIndirectAssetRow>& B)
+	{
+		return bAscending ? GetKey(*A) < GetKey(*B) : GetKey(*B) < GetKey(*A);
+	});
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -7,8 +7,11 @@
 #include "UI/ProjectCleanerNonEngineFilesUI.h"
 #include "UI/ProjectCleanerConfigsUI.h"
 #include "UI/ProjectCleanerCorruptedFilesUI.h"
+#include "UI/ProjectCleanerDuplicateAssetsUI.h"
+#include "UI/ProjectCleanerBiggestWinsUI.h"
 #include "UI/ProjectCleanerIndirectAssetsUI.h"
 #include "UI/ProjectCleanerExcludedAssetsUI.h"
+#include "UI/ProjectCleanerSpaceBreakdownUI.h"
 #include "Core/ProjectCleanerManager.h"
 #include "UI/ProjectCleanerNotificationManager.h"
 // Engine Headers
@@ -23,7 +26,10 @@ static const FName UnusedAssetsTab = FName{ TEXT("UnusedAssetsTab") };
 static const FName IndirectAssetsTab = FName{ TEXT("IndirectAssetsTab") };
 static const FName NonEngineFilesTab = FName{ TEXT("NonEngineFilesTab") };
 static const FName CorruptedFilesTab = FName{ TEXT("CorruptedFilesTab") };
+static const FName DuplicateAssetsTab = FName{ TEXT("DuplicateAssetsTab") };
+static const FName BiggestWinsTab = FName{ TEXT("BiggestWinsTab") };
 static const FName ExcludedAssetsTab = FName{ TEXT("ExcludedAssetsTab") };
+static const FName SpaceBreakdownTab = FName{ TEXT("SpaceBreakdownTab") };
 
 #define LOCTEXT_NAMESPACE "FProjectCleanerModule"
 
@@ -166,7 +172,10 @@ SProjectCleanerMainUI::~SProjectCleanerMainUI()
 	TabManager->UnregisterTabSpawner(IndirectAssetsTab);
 	TabManager->UnregisterTabSpawner(NonEngineFilesTab);
 	TabManager->UnregisterTabSpawner(CorruptedFilesTab);
+	TabManager->UnregisterTabSpawner(DuplicateAssetsTab);
+	TabManager->UnregisterTabSpawner(BiggestWinsTab);
 	TabManager->UnregisterTabSpawner(ExcludedAssetsTab);
+	TabManager->UnregisterTabSpawner(SpaceBreakdownTab);
 	CleanerManager->OnCleanerManagerUpdated.Unbind();
 	CleanerManager = nullptr;
 }
@@ -192,10 +201,13 @@ void SProjectCleanerMainUI::InitTabs()
 			FTabManager::NewStack()
 			->SetSizeCoefficient(0.4f)
 			->AddTab(UnusedAssetsTab, ETabState::OpenedTab)
+			->AddTab(BiggestWinsTab, ETabState::OpenedTab)
 			->AddTab(ExcludedAssetsTab, ETabState::OpenedTab)
 			->AddTab(IndirectAssetsTab, ETabState::OpenedTab)
 			->AddTab(NonEngineFilesTab, ETabState::OpenedTab)
 			->AddTab(CorruptedFilesTab, ETabState::OpenedTab)
+			->AddTab(DuplicateAssetsTab, ETabState::OpenedTab)
+			->AddTab(SpaceBreakdownTab, ETabState::OpenedTab)
 			->SetForegroundTab(UnusedAssetsTab)
 		)
 	);
@@ -220,33 +232,62 @@ void SProjectCleanerMainUI::InitTabs()
 		this,
 		&SProjectCleanerMainUI::OnCorruptedFilesTabSpawn)
 	);
+	TabManager->RegisterTabSpawner(DuplicateAssetsTab, FOnSpawnTab::CreateRaw(
+		this,
+		&SProjectCleanerMainUI::OnDuplicateAssetsTabSpawn)
+	);
+	TabManager->RegisterTabSpawner(BiggestWinsTab, FOnSpawnTab::CreateRaw(
+		this,
+		&SProjectCleanerMainUI::OnBiggestWinsTabSpawn)
+	);
+	TabManager->RegisterTabSpawner(SpaceBreakdownTab, FOnSpawnTab::CreateRaw(
+		this,
+		&SProjectCleanerMainUI::OnSpaceBreakdownTabSpawn)
+	);
 }
 
 void SProjectCleanerMainUI::OnCleanerManagerUpdated() const
 {
+	// tabs only marked as dirty and update themselves on next tick
+	// background tabs are not ticked, so they rebuild only when user switches to them
 	if (UnusedAssetsBrowserUI.IsValid())
 	{
-		UnusedAssetsBrowserUI.Pin()->UpdateUI();
+		UnusedAssetsBrowserUI.Pin()->MarkDirty();
 	}
 
 	if (ExcludedAssetsUI.IsValid())
 	{
-		ExcludedAssetsUI.Pin()->UpdateUI();
+		ExcludedAssetsUI.Pin()->MarkDirty();
 	}
 
 	if (IndirectAssetsUI.IsValid())
 	{
-		IndirectAssetsUI.Pin()->UpdateUI();
+		IndirectAssetsUI.Pin()->MarkDirty();
 	}
 
 	if (NonEngineFilesUI.IsValid())
 	{
-		NonEngineFilesUI.Pin()->UpdateUI();
+		NonEngineFilesUI.Pin()->MarkDirty();
 	}
 
 	if (CorruptedFilesUI.IsValid())
 	{
-		CorruptedFilesUI.Pin()->UpdateUI();
+		CorruptedFilesUI.Pin()->MarkDirty();
+	}
+
+	if (DuplicateAssetsUI.IsValid())
+	{
+		DuplicateAssetsUI.Pin()->MarkDirty();
+	}
+
+	if (BiggestWinsUI.IsValid())
+	{
+		BiggestWinsUI.Pin()->MarkDirty();
+	}
+
+	if (SpaceBreakdownUI.IsValid())
+	{
+		SpaceBreakdownUI.Pin()->MarkDirty();
 	}
 }
 
@@ -321,6 +362,28 @@ TSharedRef<SDockTab> SProjectCleanerMainUI::OnCorruptedFilesTabSpawn(const FSpaw
 		];
 }
 
+TSharedRef<SDockTab> SProjectCleanerMainUI::OnDuplicateAssetsTabSpawn(const FSpawnTabArgs& SpawnTabArgs)
+{
+	return SNew(SDockTab)
+		.TabRole(ETabRole::NomadTab)
+		.Label(NSLOCTEXT("DuplicateAssetsTab", "TabTitle", "Duplicate Assets"))
+		[
+			SAssignNew(DuplicateAssetsUI, SProjectCleanerDuplicateAssetsUI)
+			.CleanerManager(CleanerManager)
+		];
+}
+
+TSharedRef<SDockTab> SProjectCleanerMainUI::OnBiggestWinsTabSpawn(const FSpawnTabArgs& SpawnTabArgs)
+{
+	return SNew(SDockTab)
+		.TabRole(ETabRole::NomadTab)
+		.Label(NSLOCTEXT("BiggestWinsTab", "TabTitle", "Biggest Wins"))
+		[
+			SAssignNew(BiggestWinsUI, SProjectCleanerBiggestWinsUI)
+			.CleanerManager(CleanerManager)
+		];
+}
+
 TSharedRef<SDockTab> SProjectCleanerMainUI::OnIndirectAssetsTabSpawn(const FSpawnTabArgs& SpawnTabArgs)
 {
 	return SNew(SDockTab)
@@ -332,6 +395,17 @@ TSharedRef<SDockTab> SProjectCleanerMainUI::OnIndirectAssetsTabSpawn(const FSpaw
 		];
 }
 
+TSharedRef<SDockTab> SProjectCleanerMainUI::OnSpaceBreakdownTabSpawn(const FSpawnTabArgs& SpawnTabArgs)
+{
+	return SNew(SDockTab)
+		.TabRole(ETabRole::NomadTab)
+		.Label(NSLOCTEXT("SpaceBreakdownTab", "TabTitle", "Space Breakdown"))
+		[
+			SAssignNew(SpaceBreakdownUI, SProjectCleanerSpaceBreakdownUI)
+			.CleanerManager(CleanerManager)
+		];
+}
+
 FReply SProjectCleanerMainUI::OnRefreshBtnClick() const
 {
 	CleanerManager->Update();
@@ -4,7 +4,7 @@
 #include "UI/ProjectCleanerStyle.h"
 #include "Core/ProjectCleanerManager.h"
 // Engine Headers
-#include "Widgets/Layout/SScrollBox.h"
+#include "Widgets/Input/SSearchBox.h"
 
 #define LOCTEXT_NAMESPACE "FProjectCleanerModule"
 
@@ -21,61 +21,68 @@ void SProjectCleanerNonEngineFilesUI::Construct(const FArguments& InArgs)
 		+ SOverlay::Slot()
 		.Padding(20.0f)
 		[
-			SNew(SScrollBox)
-			+ SScrollBox::Slot()
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot()
+			.AutoHeight()
 			[
-				SNew(SVerticalBox)
-				+ SVerticalBox::Slot()
-				.AutoHeight()
-				[
-					SNew(STextBlock)
-					.AutoWrapText(true)
-					.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light20"))
-					.Text(LOCTEXT("non_engine_files", "Non Engine files"))
-				]
-				+ SVerticalBox::Slot()
-				.Padding(FMargin{0.0f, 10.0f})
-				.AutoHeight()
-				[
-					SNew(STextBlock)
-					.AutoWrapText(true)
-					.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light10"))
-					.Text(LOCTEXT("non_engine_files_dblclickonrow", "Double click on row to open in Explorer"))
-				]
-				+ SVerticalBox::Slot()
-				.AutoHeight()
-				.Padding(FMargin{0.0f, 20.0f})
-				[
-					SAssignNew(ListView, SListView<TWeakObjectPtr<UNonEngineFile>>)
-					.ListItemsSource(&NonEngineFiles)
-					.SelectionMode(ESelectionMode::SingleToggle)
-					.OnGenerateRow(this, &SProjectCleanerNonEngineFilesUI::OnGenerateRow)
-					.OnMouseButtonDoubleClick_Raw(this, &SProjectCleanerNonEngineFilesUI::OnMouseDoubleClick)
-					.HeaderRow
-					(
-						SNew(SHeaderRow)
-						+ SHeaderRow::Column(FName("FileName"))
-						.HAlignCell(HAlign_Center)
-						.VAlignCell(VAlign_Center)
-						.HAlignHeader(HAlign_Center)
-						.HeaderContentPadding(FMargin(10.0f))
-						.FillWidth(0.3f)
-						[
-							SNew(STextBlock)
-							.Text(LOCTEXT("NameColumn", "FileName"))
-						]
-						+ SHeaderRow::Column(FName("FilePath"))
-						.HAlignCell(HAlign_Center)
-						.VAlignCell(VAlign_Center)
-						.HAlignHeader(HAlign_Center)
-						.HeaderContentPadding(FMargin(10.0f))
-						.FillWidth(0.7f)
-						[
-							SNew(STextBlock)
-							.Text(LOCTEXT("PathColumn", "FilePath"))
-						]
-					)
-				]
+				SNew(STextBlock)
+				.AutoWrapText(true)
+				.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light20"))
+				.Text(LOCTEXT("non_engine_files", "Non Engine files"))
+			]
+			+ SVerticalBox::Slot()
+			.Padding(FMargin{0.0f, 10.0f})
+			.AutoHeight()
+			[
+				SNew(STextBlock)
+				.AutoWrapText(true)
+				.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light10"))
+				.Text(LOCTEXT("non_engine_files_dblclickonrow", "Double click on row to open in Explorer"))
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SSearchBox)
+				.HintText(LOCTEXT("non_engine_files_search_hint", "Search files..."))
+				.OnTextChanged(this, &SProjectCleanerNonEngineFilesUI::OnFilterTextChanged)
+			]
+			+ SVerticalBox::Slot()
+			.FillHeight(1.0f)
+			.Padding(FMargin{0.0f, 20.0f})
+			[
+				SAssignNew(ListView, SListView<TSharedPtr<FCleanerNonEngineFileRow>>)
+				.ListItemsSource(&FilteredNonEngineFiles)
+				.SelectionMode(ESelectionMode::SingleToggle)
+				.OnGenerateRow(this, &SProjectCleanerNonEngineFilesUI::OnGenerateRow)
+				.OnMouseButtonDoubleClick_Raw(this, &SProjectCleanerNonEngineFilesUI::OnMouseDoubleClick)
+				.HeaderRow
+				(
+					SNew(SHeaderRow)
+					+ SHeaderRow::Column(FName("FileName"))
+					.HAlignCell(HAlign_Center)
+					.VAlignCell(VAlign_Center)
+					.HAlignHeader(HAlign_Center)
+					.HeaderContentPadding(FMargin(10.0f))
+					.FillWidth(0.3f)
+					.SortMode(this, &SProjectCleanerNonEngineFilesUI::GetSortMode, FName("FileName"))
+					.OnSort(this, &SProjectCleanerNonEngineFilesUI::OnSort)
+					[
+						SNew(STextBlock)
+						.Text(LOCTEXT("NameColumn", "FileName"))
+					]
+					+ SHeaderRow::Column(FName("FilePath"))
+					.HAlignCell(HAlign_Center)
+					.VAlignCell(VAlign_Center)
+					.HAlignHeader(HAlign_Center)
+					.HeaderContentPadding(FMargin(10.0f))
+					.FillWidth(0.7f)
+					.SortMode(this, &SProjectCleanerNonEngineFilesUI::GetSortMode, FName("FilePath"))
+					.OnSort(this, &SProjectCleanerNonEngineFilesUI::OnSort)
+					[
+						SNew(STextBlock)
+						.Text(LOCTEXT("PathColumn", "FilePath"))
+					]
+				)
 			]
 		]
 	];
@@ -92,40 +99,144 @@ void SProjectCleanerNonEngineFilesUI::SetCleanerManager(FProjectCleanerManager*
 void SProjectCleanerNonEngineFilesUI::UpdateUI()
 {
 	if (!CleanerManager) return;
-	
-	NonEngineFiles.Reset();
-	NonEngineFiles.Reserve(CleanerManager->GetNonEngineFiles().Num());
 
-	for (const auto& File: CleanerManager->GetNonEngineFiles())
+	const TSet<FName>& Files = CleanerManager->GetNonEngineFiles();
+
+	// diffing with previous result, rows that stayed keep their list widgets
+	TMap<FName, TSharedPtr<FCleanerNonEngineFileRow>> PreviousRows = MoveTemp(RowsByFile);
+	RowsByFile.Reset();
+	RowsByFile.Reserve(Files.Num());
+
+	bool bChanged = PreviousRows.Num() != Files.Num();
+	TArray<TSharedPtr<FCleanerNonEngineFileRow>> NewRows;
+	NewRows.Reserve(Files.Num());
+
+	// NonEngineFiles is set already, so no need to check duplicates here
+	for (const auto& File : Files)
 	{
-		const auto& NonUassetFile = NewObject<UNonEngineFile>();
-		if(!NonUassetFile) continue;
-		NonUassetFile->FileName = FPaths::GetBaseFilename(File.ToString()) + "." + FPaths::GetExtension(File.ToString());
-		NonUassetFile->FilePath = File.ToString();
-		NonEngineFiles.AddUnique(NonUassetFile);
+		TSharedPtr<FCleanerNonEngineFileRow> NonEngineFile;
+		if (!PreviousRows.RemoveAndCopyValue(File, NonEngineFile))
+		{
+			NonEngineFile = MakeShared<FCleanerNonEngineFileRow>();
+			NonEngineFile->FilePath = File.ToString();
+			NonEngineFile->FileName = FPaths::GetCleanFilename(NonEngineFile->FilePath);
+			bChanged = true;
+		}
+
+		RowsByFile.Add(File, NonEngineFile);
+		NewRows.Add(NonEngineFile);
 	}
 
-	if (ListView.IsValid())
+	// same files as before, so keeping old rows order, search index and filtered list
+	if (!bChanged) return;
+
+	NonEngineFiles = MoveTemp(NewRows);
+
+	// search index refers to rows by position, so source array order must stay the same until next update
+	TArray<FString> SearchEntries;
+	SearchEntries.Reserve(NonEngineFiles.Num());
+	for (const auto& Row : NonEngineFiles)
 	{
-		ListView->RebuildList();
+		SearchEntries.Add(Row->FilePath);
 	}
+	SearchIndex.Build(SearchEntries);
+
+	ApplyFilter();
+}
+
+void SProjectCleanerNonEngineFilesUI::MarkDirty()
+{
+	bDirty = true;
+}
+
+void SProjectCleanerNonEngineFilesUI::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	if (!bDirty) return;
+
+	bDirty = false;
+	UpdateUI();
 }
 
 TSharedRef<ITableRow> SProjectCleanerNonEngineFilesUI::OnGenerateRow(
-	TWeakObjectPtr<UNonEngineFile> InItem,
+	TSharedPtr<FCleanerNonEngineFileRow> InItem,
 	const TSharedRef<STableViewBase>& OwnerTable) const
 {
 	return SNew(SNonEngineFilesUISelectionRow, OwnerTable).SelectedRowItem(InItem);
 }
 
-void SProjectCleanerNonEngineFilesUI::OnMouseDoubleClick(TWeakObjectPtr<UNonEngineFile> Item) const
+void SProjectCleanerNonEngineFilesUI::OnMouseDoubleClick(TSharedPtr<FCleanerNonEngineFileRow> Item) const
 {
 	if (!Item.IsValid()) return;
 
-	const auto DirectoryPath = FPaths::GetPath(Item.Get()->FilePath);
+	const auto DirectoryPath = FPaths::GetPath(Item->FilePath);
 	if (!FPaths::DirectoryExists(DirectoryPath)) return;
 
 	FPlatformProcess::ExploreFolder(*DirectoryPath);
 }
 
+void SProjectCleanerNonEngineFilesUI::OnFilterTextChanged(const FText& InFilterText)
+{
+	FilterText = InFilterText.ToString();
+	ApplyFilter();
+}
+
+void SProjectCleanerNonEngineFilesUI::ApplyFilter()
+{
+	if (FilterText.IsEmpty())
+	{
+		FilteredNonEngineFiles = NonEngineFiles;
+	}
+	else
+	{
+		TArray<int32> Indices;
+		SearchIndex.Query(FilterText, Indices);
+
+		FilteredNonEngineFiles.Reset(Indices.Num());
+		for (const int32 Index : Indices)
+		{
+			FilteredNonEngineFiles.Add(NonEngineFiles[Index]);
+		}
+	}
+
+	SortRows();
+
+	if (ListView.IsValid())
+	{
+		ListView->RequestListRefresh();
+	}
+}
+
+void SProjectCleanerNonEngineFilesUI::OnSort(EColumnSortPriority::Type SortPriority, const FName& ColumnName, EColumnSortMode::Type InSortMode)
+{
+	SortColumn = ColumnName;
+	SortMode = InSortMode;
+
+	SortRows();
+
+	if (ListView.IsValid())
+	{
+		ListView->RequestListRefresh();
+	}
+}
+
+EColumnSortMode::Type SProjectCleanerNonEngineFilesUI::GetSortMode(const FName ColumnName) const
+{
+	return SortColumn.IsEqual(ColumnName) ? SortMode : EColumnSortMode::None;
+}
+
+void SProjectCleanerNonEngineFilesUI::SortRows()
+{
+	const bool bAscending = SortMode != EColumnSortMode::Descending;
+	const bool bByName = SortColumn.IsEqual(TEXT("FileName"));
+
+	FilteredNonEngineFiles.Sort([&] (const TSharedPtr<FCleanerNonEngineFileRow>& A, const TSharedPtr<FCleanerNonEngineFileRow>& B)
+	{
+		const FString& KeyA = bByName ? A->FileName : A->FilePath;
+		const FString& KeyB = bByName ? B->FileName : B->FilePath;
+		return bAscending ? KeyA < KeyB : KeyB < KeyA;
+	});
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
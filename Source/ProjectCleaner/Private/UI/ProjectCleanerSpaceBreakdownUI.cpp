@@ -0,0 +1,244 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "UI/ProjectCleanerSpaceBreakdownUI.h"
+#include "UI/ProjectCleanerStyle.h"
+#include "Core/ProjectCleanerManager.h"
+// Engine Headers
+#include "IContentBrowserSingleton.h"
+#include "Editor/ContentBrowser/Public/ContentBrowserModule.h"
+#include "Widgets/Layout/SSplitter.h"
+
+#define LOCTEXT_NAMESPACE "FProjectCleanerModule"
+
+void SProjectCleanerSpaceBreakdownUI::Construct(const FArguments& InArgs)
+{
+	if (InArgs._CleanerManager)
+	{
+		SetCleanerManager(InArgs._CleanerManager);
+	}
+
+	ChildSlot
+	[
+		SNew(SOverlay)
+		+ SOverlay::Slot()
+		.Padding(20.0f)
+		[
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(STextBlock)
+				.AutoWrapText(true)
+				.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light20"))
+				.Text(LOCTEXT("space_breakdown_title", "Space Breakdown"))
+			]
+			+ SVerticalBox::Slot()
+			.Padding(FMargin{0.0f, 10.0f})
+			.AutoHeight()
+			[
+				SNew(STextBlock)
+				.AutoWrapText(true)
+				.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light10"))
+				.Text(LOCTEXT("space_breakdown_info", "Folder values include all subfolders. Click on column header to sort, double click on folder to show it in Content Browser"))
+			]
+			+ SVerticalBox::Slot()
+			.FillHeight(1.0f)
+			.Padding(FMargin{0.0f, 10.0f})
+			[
+				SNew(SSplitter)
+				.Orientation(Orient_Vertical)
+				.Style(FEditorStyle::Get(), "ContentBrowser.Splitter")
+				.PhysicalSplitterHandleSize(3.0f)
+				+ SSplitter::Slot()
+				.Value(0.6f)
+				[
+					SAssignNew(FoldersListView, SListView<TSharedPtr<FCleanerAggregateStats>>)
+					.ListItemsSource(&Folders)
+					.SelectionMode(ESelectionMode::SingleToggle)
+					.OnGenerateRow(this, &SProjectCleanerSpaceBreakdownUI::OnGenerateRow)
+					.OnMouseButtonDoubleClick_Raw(this, &SProjectCleanerSpaceBreakdownUI::OnFolderDoubleClick)
+					.HeaderRow(CreateHeaderRow(LOCTEXT("FolderColumn", "Folder"), true))
+				]
+				+ SSplitter::Slot()
+				.Value(0.4f)
+				[
+					SAssignNew(ClassesListView, SListView<TSharedPtr<FCleanerAggregateStats>>)
+					.ListItemsSource(&Classes)
+					.SelectionMode(ESelectionMode::SingleToggle)
+					.OnGenerateRow(this, &SProjectCleanerSpaceBreakdownUI::OnGenerateRow)
+					.HeaderRow(CreateHeaderRow(LOCTEXT("ClassColumn", "Class"), false))
+				]
+			]
+		]
+	];
+
+	UpdateUI();
+}
+
+void SProjectCleanerSpaceBreakdownUI::SetCleanerManager(FProjectCleanerManager* CleanerManagerPtr)
+{
+	if (!CleanerManagerPtr) return;
+	CleanerManager = CleanerManagerPtr;
+}
+
+void SProjectCleanerSpaceBreakdownUI::UpdateUI()
+{
+	if (!CleanerManager) return;
+
+	Folders.Reset(CleanerManager->GetFolderStats().Num());
+	for (const auto& FolderStat : CleanerManager->GetFolderStats())
+	{
+		Folders.Add(MakeShared<FCleanerAggregateStats>(FolderStat.Value));
+	}
+
+	Classes.Reset(CleanerManager->GetClassStats().Num());
+	for (const auto& ClassStat : CleanerManager->GetClassStats())
+	{
+		Classes.Add(MakeShared<FCleanerAggregateStats>(ClassStat.Value));
+	}
+
+	SortRows(Folders, FoldersSortColumn, FoldersSortMode);
+	SortRows(Classes, ClassesSortColumn, ClassesSortMode);
+
+	if (FoldersListView.IsValid())
+	{
+		FoldersListView->RequestListRefresh();
+	}
+
+	if (ClassesListView.IsValid())
+	{
+		ClassesListView->RequestListRefresh();
+	}
+}
+
+void SProjectCleanerSpaceBreakdownUI::MarkDirty()
+{
+	bDirty = true;
+}
+
+void SProjectCleanerSpaceBreakdownUI::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	if (!bDirty) return;
+
+	bDirty = false;
+	UpdateUI();
+}
+
+TSharedRef<SHeaderRow> SProjectCleanerSpaceBreakdownUI::CreateHeaderRow(const FText& NameColumnText, const bool bFolders)
+{
+	const auto AddColumn = [&] (const TSharedRef<SHeaderRow>& HeaderRow, const FName& ColumnName, const FText& ColumnText, const float Width)
+	{
+		HeaderRow->AddColumn(
+			SHeaderRow::Column(ColumnName)
+			.HAlignCell(HAlign_Center)
+			.VAlignCell(VAlign_Center)
+			.HAlignHeader(HAlign_Center)
+			.HeaderContentPadding(FMargin(10.0f))
+			.FillWidth(Width)
+			.SortMode(this, &SProjectCleanerSpaceBreakdownUI::GetSortMode, ColumnName, bFolders)
+			.OnSort(this, &SProjectCleanerSpaceBreakdownUI::OnSort, bFolders)
+			[
+				SNew(STextBlock)
+				.Text(ColumnText)
+			]
+		);
+	};
+
+	const TSharedRef<SHeaderRow> HeaderRow = SNew(SHeaderRow);
+	AddColumn(HeaderRow, TEXT("Name"), NameColumnText, 0.4f);
+	AddColumn(HeaderRow, TEXT("AssetsNum"), LOCTEXT("AssetsNumColumn", "Assets"), 0.12f);
+	AddColumn(HeaderRow, TEXT("UnusedAssetsNum"), LOCTEXT("UnusedAssetsNumColumn", "Unused Assets"), 0.12f);
+	AddColumn(HeaderRow, TEXT("TotalSize"), LOCTEXT("TotalSizeColumn", "Size"), 0.18f);
+	AddColumn(HeaderRow, TEXT("UnusedSize"), LOCTEXT("UnusedSizeColumn", "Unused Size"), 0.18f);
+
+	return HeaderRow;
+}
+
+TSharedRef<ITableRow> SProjectCleanerSpaceBreakdownUI::OnGenerateRow(
+	TSharedPtr<FCleanerAggregateStats> InItem,
+	const TSharedRef<STableViewBase>& OwnerTable) const
+{
+	return SNew(SSpaceBreakdownUISelectionRow, OwnerTable).SelectedRowItem(InItem);
+}
+
+void SProjectCleanerSpaceBreakdownUI::OnFolderDoubleClick(TSharedPtr<FCleanerAggregateStats> Item) const
+{
+	if (!Item.IsValid()) return;
+
+	TArray<FString> FocusFolders;
+	FocusFolders.Add(Item->Name.ToString());
+
+	const FContentBrowserModule& CBModule = FModuleManager::Get().LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
+	CBModule.Get().SyncBrowserToFolders(FocusFolders);
+}
+
+void SProjectCleanerSpaceBreakdownUI::OnSort(EColumnSortPriority::Type SortPriority, const FName& ColumnName, EColumnSortMode::Type SortMode, const bool bFolders)
+{
+	if (bFolders)
+	{
+		FoldersSortColumn = ColumnName;
+		FoldersSortMode = SortMode;
+		SortRows(Folders, FoldersSortColumn, FoldersSortMode);
+		FoldersListView->RequestListRefresh();
+	}
+	else
+	{
+		ClassesSortColumn = ColumnName;
+		ClassesSortMode = SortMode;
+		SortRows(Classes, ClassesSortColumn, ClassesSortMode);
+		ClassesListView->RequestListRefresh();
+	}
+}
+
+EColumnSortMode::Type SProjectCleanerSpaceBreakdownUI::GetSortMode(const FName ColumnName, const bool bFolders) const
+{
+	const FName& SortColumn = bFolders ? FoldersSortColumn : ClassesSortColumn;
+	if (!SortColumn.IsEqual(ColumnName))
+	{
+		return EColumnSortMode::None;
+	}
+
+	return bFolders ? FoldersSortMode : ClassesSortMode;
+}
+
+void SProjectCleanerSpaceBreakdownUI::SortRows(TArray<TSharedPtr<FCleanerAggregateStats>>& Rows, const FName& ColumnName, const EColumnSortMode::Type SortMode)
+{
+	if (SortMode == EColumnSortMode::None) return;
+
+	const bool bAscending = SortMode == EColumnSortMode::Ascending;
+	const auto SortByKey = [&] (auto KeyGetter)
+	{
+		Rows.Sort([&] (const TSharedPtr<FCleanerAggregateStats>& A, const TSharedPtr<FCleanerAggregateStats>& B)
+		{
+			return bAscending ? KeyGetter(*A) < KeyGetter(*B) : KeyGetter(*B) < KeyGetter(*A);
+		});
+	};
+
+	if (ColumnName == TEXT("Name"))
+	{
+		Rows.Sort([&] (const TSharedPtr<FCleanerAggregateStats>& A, const TSharedPtr<FCleanerAggregateStats>& B)
+		{
+			return bAscending ? A->Name.LexicalLess(B->Name) : B->Name.LexicalLess(A->Name);
+		});
+	}
+	else if (ColumnName == TEXT("AssetsNum"))
+	{
+		SortByKey([] (const FCleanerAggregateStats& Stats) { return Stats.AssetsNum; });
+	}
+	else if (ColumnName == TEXT("UnusedAssetsNum"))
+	{
+		SortByKey([] (const FCleanerAggregateStats& Stats) { return Stats.UnusedAssetsNum; });
+	}
+	else if (ColumnName == TEXT("TotalSize"))
+	{
+		SortByKey([] (const FCleanerAggregateStats& Stats) { return Stats.TotalSize; });
+	}
+	else
+	{
+		SortByKey([] (const FCleanerAggregateStats& Stats) { return Stats.UnusedSize; });
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
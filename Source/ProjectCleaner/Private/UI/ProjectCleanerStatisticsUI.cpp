@@ -6,6 +6,7 @@
 #include "Core/ProjectCleanerUtility.h"
 // Engine Headers
 #include "Widgets/Notifications/SProgressBar.h"
+#include "Widgets/Layout/SExpandableArea.h"
 
 #define LOCTEXT_NAMESPACE "FProjectCleanerModule"
 
@@ -158,6 +159,30 @@ void SProjectCleanerStatisticsUI::Construct(const FArguments& InArgs)
 			.MaxHeight(MaxHeight)
 			.Padding(FMargin{0.0, 0.0f, 0.0f, 3.0f})
 			.HAlign(HAlign_Center)
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(STextBlock)
+					.AutoWrapText(true)
+					.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light20"))
+					.Text(LOCTEXT("stat_orphaned_files_num", "Orphaned Files - "))
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(STextBlock)
+					.AutoWrapText(true)
+					.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light20"))
+					.ToolTipText(LOCTEXT("stat_orphaned_files_tooltip", ".uexp, .ubulk and .uptnl files without .uasset or .umap next to them"))
+					.Text(this, &SProjectCleanerStatisticsUI::GetOrphanedFilesText)
+				]
+			]
+			+ SVerticalBox::Slot()
+			.MaxHeight(MaxHeight)
+			.Padding(FMargin{0.0, 0.0f, 0.0f, 3.0f})
+			.HAlign(HAlign_Center)
 			[
 				SNew(SHorizontalBox)
 				+ SHorizontalBox::Slot()
@@ -281,6 +306,26 @@ void SProjectCleanerStatisticsUI::Construct(const FArguments& InArgs)
 					]
 				]
 			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(FMargin{0.0, 10.0f, 0.0f, 3.0f})
+			[
+				SNew(SExpandableArea)
+				.InitiallyCollapsed(true)
+				.HeaderContent()
+				[
+					SNew(STextBlock)
+					.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light15"))
+					.Text_Raw(this, &SProjectCleanerStatisticsUI::GetAnalysisTimeText)
+				]
+				.BodyContent()
+				[
+					SNew(STextBlock)
+					.AutoWrapText(true)
+					.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light10"))
+					.Text_Raw(this, &SProjectCleanerStatisticsUI::GetAnalysisReportText)
+				]
+			]
 		]
 	];
 }
@@ -303,14 +348,12 @@ FText SProjectCleanerStatisticsUI::GetUnusedAssetsNum() const
 
 FText SProjectCleanerStatisticsUI::GetTotalProjectSize() const
 {
-	const int64 TotalProjectSize = ProjectCleanerUtility::GetTotalSize(CleanerManager->GetAllAssets());
-	return FText::AsMemory(TotalProjectSize);
+	return FText::AsMemory(CleanerManager->GetTotalProjectSize());
 }
 
 FText SProjectCleanerStatisticsUI::GetTotalUnusedAssetsSize() const
 {
-	const int64 UnusedSize = ProjectCleanerUtility::GetTotalSize(CleanerManager->GetUnusedAssets());
-	return FText::AsMemory(UnusedSize);
+	return FText::AsMemory(CleanerManager->GetTotalUnusedSize());
 }
 
 FText SProjectCleanerStatisticsUI::GetNonEngineFilesNum() const
@@ -318,6 +361,15 @@ FText SProjectCleanerStatisticsUI::GetNonEngineFilesNum() const
 	return FText::AsNumber(CleanerManager->GetNonEngineFiles().Num());
 }
 
+FText SProjectCleanerStatisticsUI::GetOrphanedFilesText() const
+{
+	return FText::Format(
+		FText::FromString(TEXT("{0} ({1})")),
+		FText::AsNumber(CleanerManager->GetOrphanedFiles().Num()),
+		FText::AsMemory(CleanerManager->GetOrphanedFilesSize())
+	);
+}
+
 FText SProjectCleanerStatisticsUI::GetIndirectAssetsNum() const
 {
 	return FText::AsNumber(CleanerManager->GetIndirectAssets().Num());
@@ -376,4 +428,33 @@ FText SProjectCleanerStatisticsUI::GetProgressBarText() const
 	);
 }
 
+FText SProjectCleanerStatisticsUI::GetAnalysisTimeText() const
+{
+	const FCleanerAnalysisReport& Report = CleanerManager->GetAnalysisReport();
+	return FText::Format(
+		LOCTEXT("stat_analysis_time", "Last scan - {0} s (CPU {1} s)"),
+		FText::AsNumber(Report.TotalWallTime, &FNumberFormattingOptions::DefaultNoGrouping()),
+		FText::AsNumber(Report.TotalCpuTime, &FNumberFormattingOptions::DefaultNoGrouping())
+	);
+}
+
+FText SProjectCleanerStatisticsUI::GetAnalysisReportText() const
+{
+	FString ReportText;
+	for (const auto& Stage : CleanerManager->GetAnalysisReport().Stages)
+	{
+		ReportText += FString::Printf(
+			TEXT("%s - %.3f s, CPU %.3f s, Mem %+lld KB, %lld items (%.0f/s)\n"),
+			*Stage.Name.ToString(),
+			Stage.WallTime,
+			Stage.CpuTime,
+			Stage.MemoryDelta / 1024,
+			Stage.ItemsProcessed,
+			Stage.GetThroughput()
+		);
+	}
+
+	return FText::FromString(ReportText);
+}
+
 #undef LOCTEXT_NAMESPACE
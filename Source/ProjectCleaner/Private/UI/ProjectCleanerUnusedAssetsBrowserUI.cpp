@@ -2,13 +2,17 @@
 
 #include "UI/ProjectCleanerUnusedAssetsBrowserUI.h"
 #include "UI/ProjectCleanerCommands.h"
+#include "UI/ProjectCleanerStyle.h"
 #include "Core/ProjectCleanerManager.h"
+#include "Core/ProjectCleanerUtility.h"
 #include "StructsContainer.h"
 // Engine Headers
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Editor/ContentBrowser/Public/ContentBrowserModule.h"
 #include "Widgets/Layout/SScrollBox.h"
 #include "Widgets/Layout/SScrollBorder.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Input/SSearchBox.h"
 #include "Toolkits/GlobalEditorCommonCommands.h"
 
 #define LOCTEXT_NAMESPACE "FProjectCleanerModule"
@@ -41,6 +45,11 @@ void SProjectCleanerUnusedAssetsBrowserUI::Construct(const FArguments& InArgs)
 	AssetPickerConfig.AssetShowWarningText = FText::FromName("No assets");
 	AssetPickerConfig.GetCurrentSelectionDelegates.Add(&CurrentSelectionDelegate);
 	AssetPickerConfig.RefreshAssetViewDelegates.Add(&RefreshAssetViewDelegate);
+	AssetPickerConfig.SetFilterDelegates.Add(&SetFilterDelegate);
+	AssetPickerConfig.OnShouldFilterAsset = FOnShouldFilterAsset::CreateRaw(
+		this,
+		&SProjectCleanerUnusedAssetsBrowserUI::OnShouldFilterAsset
+	);
 	AssetPickerConfig.OnAssetDoubleClicked = FOnAssetDoubleClicked::CreateStatic(
 		&SProjectCleanerUnusedAssetsBrowserUI::OnAssetDblClicked
 	);
@@ -59,8 +68,52 @@ void SProjectCleanerUnusedAssetsBrowserUI::Construct(const FArguments& InArgs)
 	PathPickerConfig.OnGetFolderContextMenu = FOnGetFolderContextMenu::CreateSP(
 		this, &SProjectCleanerUnusedAssetsBrowserUI::OnGetFolderContextMenu
 	);
-	
-	UpdateUI();
+
+	GenerateFilter();
+	AssetPickerConfig.Filter = Filter;
+
+	RebuildSearchIndex();
+
+	// pickers created only once, later updates done by refreshing them in place
+	ChildSlot
+	[
+		SNew(SSplitter)
+		.Style(FEditorStyle::Get(), "ContentBrowser.Splitter")
+		.PhysicalSplitterHandleSize(2.0f)
+		+ SSplitter::Slot()
+		.Value(0.3f)
+		[
+			ContentBrowserModule->Get().CreatePathPicker(PathPickerConfig)
+		]
+		+ SSplitter::Slot()
+		[
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(FMargin{5.0f, 5.0f})
+			[
+				SNew(STextBlock)
+				.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light10"))
+				.Text_Raw(this, &SProjectCleanerUnusedAssetsBrowserUI::GetSelectedPathStatsText)
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(FMargin{5.0f, 0.0f, 5.0f, 5.0f})
+			[
+				SNew(SSearchBox)
+				.HintText(LOCTEXT("unused_assets_search_hint", "Search unused assets by path..."))
+				.OnTextChanged(this, &SProjectCleanerUnusedAssetsBrowserUI::OnSearchTextChanged)
+			]
+			+ SVerticalBox::Slot()
+			.FillHeight(1.0f)
+			[
+				SAssignNew(AssetPickerBox, SBox)
+				[
+					ContentBrowserModule->Get().CreateAssetPicker(AssetPickerConfig)
+				]
+			]
+		]
+	];
 }
 
 void SProjectCleanerUnusedAssetsBrowserUI::SetCleanerManager(FProjectCleanerManager* CleanerManagerPtr)
@@ -149,50 +202,89 @@ void SProjectCleanerUnusedAssetsBrowserUI::UpdateUI()
 	if (!ContentBrowserModule) return;
 	if (!CleanerManager->GetCleanerConfigs()) return;
 
-	GenerateFilter();
-	
-	ChildSlot
-	[
-		SNew(SSplitter)
-		.Style(FEditorStyle::Get(), "ContentBrowser.Splitter")
-		.PhysicalSplitterHandleSize(2.0f)
-		+ SSplitter::Slot()
-		.Value(0.3f)
-		[
-			ContentBrowserModule->Get().CreatePathPicker(PathPickerConfig)
-		]
-		+ SSplitter::Slot()
-		[
-			ContentBrowserModule->Get().CreateAssetPicker(AssetPickerConfig)
-		]
-	];
+	RebuildSearchIndex();
+
+	// developers folder visibility is picker creation option, so picker is recreated only when it changes
+	const bool bScanDeveloperContents = CleanerManager->GetCleanerConfigs()->bScanDeveloperContents;
+	if (AssetPickerBox.IsValid() && AssetPickerConfig.bCanShowDevelopersFolder != bScanDeveloperContents)
+	{
+		AssetPickerConfig.bCanShowDevelopersFolder = bScanDeveloperContents;
+		AssetPickerConfig.Filter = Filter;
+		AssetPickerBox->SetContent(ContentBrowserModule->Get().CreateAssetPicker(AssetPickerConfig));
+	}
+
+	// unused assets set already updated in CleanerManager, so just asking picker to filter its items again
+	RefreshAssetViewDelegate.ExecuteIfBound(true);
 }
 
-void SProjectCleanerUnusedAssetsBrowserUI::GenerateFilter()
+void SProjectCleanerUnusedAssetsBrowserUI::MarkDirty()
 {
-	Filter.Clear();
-	
-	if (CleanerManager->GetUnusedAssets().Num() == 0)
+	bDirty = true;
+}
+
+void SProjectCleanerUnusedAssetsBrowserUI::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	if (!bDirty) return;
+
+	bDirty = false;
+	UpdateUI();
+}
+
+void SProjectCleanerUnusedAssetsBrowserUI::OnSearchTextChanged(const FText& InSearchText)
+{
+	SearchText = InSearchText.ToString();
+	UpdateSearchMatches();
+	RefreshAssetViewDelegate.ExecuteIfBound(true);
+}
+
+void SProjectCleanerUnusedAssetsBrowserUI::RebuildSearchIndex()
+{
+	SearchPackages = CleanerManager->GetUnusedPackages().Array();
+
+	TArray<FString> SearchEntries;
+	SearchEntries.Reserve(SearchPackages.Num());
+	for (const auto& Package : SearchPackages)
 	{
-		// this is needed for disabling showing primary assets in browser, when there is no unused assets
-		Filter.TagsAndValues.Add(FName{ "ProjectCleanerEmptyTag" }, FString{ "ProjectCleanerEmptyTag" });
+		SearchEntries.Add(Package.ToString());
 	}
-	else
+	SearchIndex.Build(SearchEntries);
+
+	UpdateSearchMatches();
+}
+
+void SProjectCleanerUnusedAssetsBrowserUI::UpdateSearchMatches()
+{
+	SearchMatches.Reset();
+	if (SearchText.IsEmpty()) return;
+
+	TArray<int32> Indices;
+	SearchIndex.Query(SearchText, Indices);
+
+	SearchMatches.Reserve(Indices.Num());
+	for (const int32 Index : Indices)
 	{
-		Filter.PackageNames.Reserve(CleanerManager->GetUnusedAssets().Num());
-		for (const auto& Asset : CleanerManager->GetUnusedAssets())
-		{
-			Filter.PackageNames.Add(Asset.PackageName);
-		}
+		SearchMatches.Add(SearchPackages[Index]);
 	}
+}
+
+void SProjectCleanerUnusedAssetsBrowserUI::GenerateFilter()
+{
+	// filter contains only selected path, unused assets are filtered by OnShouldFilterAsset
+	Filter.Clear();
 
 	if (!SelectedPath.IsNone())
 	{
 		Filter.PackagePaths.Add(SelectedPath);
 	}
-	
-	AssetPickerConfig.bCanShowDevelopersFolder = CleanerManager->GetCleanerConfigs()->bScanDeveloperContents;
-	AssetPickerConfig.Filter = Filter;
+}
+
+bool SProjectCleanerUnusedAssetsBrowserUI::OnShouldFilterAsset(const FAssetData& AssetData) const
+{
+	if (!SearchText.IsEmpty() && !SearchMatches.Contains(AssetData.PackageName)) return true;
+
+	return !CleanerManager->GetUnusedPackages().Contains(AssetData.PackageName);
 }
 
 TSharedPtr<SWidget> SProjectCleanerUnusedAssetsBrowserUI::OnGetFolderContextMenu(const TArray<FString>& SelectedPaths,
@@ -204,6 +296,15 @@ TSharedPtr<SWidget> SProjectCleanerUnusedAssetsBrowserUI::OnGetFolderContextMenu
 		MenuBuilder.AddMenuEntry(FProjectCleanerCommands::Get().ExcludePath);
 	}
 	MenuBuilder.EndSection();
+	if (CleanerManager)
+	{
+		FCleanerFootprint Footprint;
+		CleanerManager->GetDataManager().GetFoldersFootprint(SelectedPaths, Footprint);
+
+		MenuBuilder.BeginSection(TEXT("Footprint"), LOCTEXT("FootprintSectionLabel", "Footprint"));
+		MenuBuilder.AddWidget(SNew(STextBlock).Text(ProjectCleanerUtility::GetFootprintText(Footprint)), FText::GetEmpty());
+		MenuBuilder.EndSection();
+	}
 
 	return MenuBuilder.MakeWidget();
 }
@@ -219,6 +320,15 @@ TSharedPtr<SWidget> SProjectCleanerUnusedAssetsBrowserUI::OnGetAssetContextMenu(
 		MenuBuilder.AddMenuEntry(FProjectCleanerCommands::Get().ExcludeByType);
 	}
 	MenuBuilder.EndSection();
+	if (CleanerManager)
+	{
+		FCleanerFootprint Footprint;
+		CleanerManager->GetDataManager().GetAssetsFootprint(SelectedAssets, Footprint);
+
+		MenuBuilder.BeginSection(TEXT("Footprint"), LOCTEXT("FootprintSectionLabel", "Footprint"));
+		MenuBuilder.AddWidget(SNew(STextBlock).Text(ProjectCleanerUtility::GetFootprintText(Footprint)), FText::GetEmpty());
+		MenuBuilder.EndSection();
+	}
 
 	return MenuBuilder.MakeWidget();
 }
@@ -237,8 +347,27 @@ void SProjectCleanerUnusedAssetsBrowserUI::OnPathSelected(const FString& Path)
 {
 	SelectedPath = FName{Path};
 	PathPickerConfig.DefaultPath = Path;
-	
-	UpdateUI();
+
+	GenerateFilter();
+	SetFilterDelegate.ExecuteIfBound(Filter);
+}
+
+FText SProjectCleanerUnusedAssetsBrowserUI::GetSelectedPathStatsText() const
+{
+	const FCleanerAggregateStats* FolderStats = CleanerManager->GetFolderStats().Find(SelectedPath);
+	if (!FolderStats)
+	{
+		return FText::Format(LOCTEXT("selected_path_no_assets", "{0} - No assets"), FText::FromName(SelectedPath));
+	}
+
+	return FText::Format(
+		LOCTEXT("selected_path_stats", "{0} - Assets: {1}  |  Unused: {2}  |  Size: {3}  |  Unused Size: {4}"),
+		FText::FromName(SelectedPath),
+		FText::AsNumber(FolderStats->AssetsNum),
+		FText::AsNumber(FolderStats->UnusedAssetsNum),
+		FText::AsMemory(FolderStats->TotalSize),
+		FText::AsMemory(FolderStats->UnusedSize)
+	);
 }
 
 void SProjectCleanerUnusedAssetsBrowserUI::FindInContentBrowser() const
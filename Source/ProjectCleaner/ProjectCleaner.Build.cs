@@ -29,6 +29,7 @@ public class ProjectCleaner : ModuleRules
 			new string[]
 			{
 				"Core",
+				"ProjectCleanerCore",
 			}
 		);
 
@@ -50,7 +51,9 @@ public class ProjectCleaner : ModuleRules
 				"UnrealEd",
 				"ToolMenus",
 				"AssetTools",
-				"AssetRegistry"
+				"AssetRegistry",
+				"DirectoryWatcher",
+				"Json"
 			}
 		);
 
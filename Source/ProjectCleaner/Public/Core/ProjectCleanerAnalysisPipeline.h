@@ -0,0 +1,52 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "StructsContainer.h"
+// Engine Headers
+#include "CoreMinimal.h"
+
+/**
+ * Single named step of project analysis
+ * Work function returns number of items it processed, used for throughput
+ */
+class FProjectCleanerAnalysisStage
+{
+public:
+	FProjectCleanerAnalysisStage(const FName InName, TFunction<int64()> InWork);
+
+	void Run(FCleanerStageStats& OutStats) const;
+	FName GetName() const;
+private:
+	FName Name;
+	TFunction<int64()> Work;
+};
+
+/**
+ * Runs analysis stages in order and measures each of them
+ */
+class PROJECTCLEANER_API FProjectCleanerAnalysisPipeline
+{
+public:
+	void AddStage(const FName Name, TFunction<int64()> Work);
+	/** Stage is not run, only listed in report as skipped */
+	void SkipStage(const FName Name);
+	void Run(FCleanerAnalysisReport& OutReport) const;
+
+	/** Run split into steps, for callers that spread stages over several frames */
+	void Begin(FCleanerAnalysisReport& OutReport) const;
+	void RunStage(const int32 Index, FCleanerAnalysisReport& OutReport) const;
+	void End(FCleanerAnalysisReport& OutReport) const;
+	int32 GetStagesNum() const;
+	FName GetStageName(const int32 Index) const;
+
+	static void PrintReport(const FCleanerAnalysisReport& Report);
+	static FString ReportToJson(const FCleanerAnalysisReport& Report);
+	static bool SaveReport(const FCleanerAnalysisReport& Report, const FString& FilePath);
+	static FString GetDefaultReportPath();
+	/** CPU time consumed by process so far, in seconds */
+	static double GetProcessCpuTime();
+private:
+	TArray<FProjectCleanerAnalysisStage> Stages;
+	TArray<FName> SkippedStages;
+};
@@ -0,0 +1,78 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+// Engine Headers
+#include "CoreMinimal.h"
+#include "Misc/SecureHash.h"
+
+struct FAssetData;
+struct FFileChangeData;
+class FProjectCleanerDataManager;
+
+struct FCleanerSessionConfigs
+{
+	TArray<FString> ExcludedAssets;
+	TArray<FString> ExcludedPaths;
+	TArray<FString> ExcludedClasses;
+	bool bScanDeveloperContents = false;
+
+	/** Order of excluded entries does not change hash */
+	FSHAHash GetHash() const;
+};
+
+/**
+ * Keeps last read only analysis and answers queries from it, while configs stay same and project does not change
+ * Any asset registry change or file change in Content, Config, Source or Plugins folders invalidates it
+ */
+class FProjectCleanerAnalysisSession
+{
+public:
+	static FProjectCleanerAnalysisSession& Get();
+	static void Shutdown();
+
+	~FProjectCleanerAnalysisSession();
+
+	/** Analyzes project only if there is no valid result for given configs */
+	const FProjectCleanerDataManager& GetAnalysis(const FCleanerSessionConfigs& Configs);
+	/** Valid result for given configs, or nullptr */
+	const FProjectCleanerDataManager* FindAnalysis(const FCleanerSessionConfigs& Configs) const;
+
+	/**
+	 * Creates configured data manager for caller to analyze in its own pace
+	 * Result is cached by FinishAnalysis, unless project changed since StartAnalysis or newer analysis was started
+	 */
+	TSharedRef<FProjectCleanerDataManager> StartAnalysis(const FCleanerSessionConfigs& Configs);
+	void FinishAnalysis(const TSharedRef<FProjectCleanerDataManager>& Analysis);
+
+	void Invalidate();
+	bool IsValid() const;
+	/** Identifies analysis GetAnalysis returns, changes every time new analysis is started */
+	int32 GetAnalysisToken() const;
+private:
+	FProjectCleanerAnalysisSession();
+
+	void RegisterWatchers();
+	void UnregisterWatchers();
+	void OnAssetChanged(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void OnPathChanged(const FString& Path);
+	void OnDirectoryChanged(const TArray<FFileChangeData>& FileChanges);
+
+	TSharedPtr<FProjectCleanerDataManager> DataManager;
+	FSHAHash ConfigsHash;
+	bool bValid = false;
+	/** Increased on every project change, analysis started before change is not cached */
+	uint32 ProjectGeneration = 0;
+	uint32 AnalysisGeneration = 0;
+	int32 AnalysisToken = 0;
+
+	TArray<TPair<FString, FDelegateHandle>> DirectoryWatcherHandles;
+	FDelegateHandle OnAssetAddedHandle;
+	FDelegateHandle OnAssetRemovedHandle;
+	FDelegateHandle OnAssetRenamedHandle;
+	FDelegateHandle OnPathAddedHandle;
+	FDelegateHandle OnPathRemovedHandle;
+
+	static TUniquePtr<FProjectCleanerAnalysisSession> Instance;
+};
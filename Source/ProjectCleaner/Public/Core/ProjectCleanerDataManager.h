@@ -3,17 +3,24 @@
 #pragma once
 
 #include "StructsContainer.h"
+#include "ProjectCleanerAnalysisCore.h"
 #include "CoreMinimal.h"
 
 struct FAssetData;
+struct FARFilter;
 class FAssetToolsModule;
 class FAssetRegistryModule;
 class IPlatformFile;
+class FProjectCleanerReportWriter;
+class FProjectCleanerAnalysisPipeline;
 
 class FProjectCleanerDataManager : public ICleanerUIActions
 {
 public:
 
+	/** Packages DeleteAllUnusedAssets loads and deletes at once */
+	static constexpr int32 DeletionBucketSize = 500;
+
 	// ctor/dtor
 	FProjectCleanerDataManager();
 	virtual ~FProjectCleanerDataManager() override;
@@ -22,10 +29,30 @@ public:
 	void AnalyzeProject();
 	void PrintInfo();
 
+	/**
+	 * Same analysis as AnalyzeProject, run one stage per call, so caller can spread it over several frames
+	 * BeginAnalysis returns false if asset registry is still loading
+	 */
+	bool BeginAnalysis();
+	/** Returns false when there are no stages left */
+	bool RunNextAnalysisStage();
+	void FinishAnalysis();
+	void CancelAnalysis();
+	bool IsAnalysisRunning() const;
+	float GetAnalysisProgress() const;
+	FName GetNextAnalysisStageName() const;
+
 	// cli
 	void SetExcludeClasses(const TArray<FString>& Classes);
 	void SetExcludePaths(const TArray<FString>& Paths);
 	void SetUserExcludedAssets(const TArray<FString>& Assets);
+	/**
+	 * Groups unused assets of last analysis into deletion buckets of about BucketSize packages, nothing is deleted
+	 * Assets of package always land in same or later bucket than assets referencing them, returns number of planned assets
+	 */
+	int32 PlanDeletion(const int32 BucketSize, TArray<TArray<FAssetData>>& OutBuckets) const;
+	/** Streams every result category of last analysis into given writer, called once analysis finished, reuses sizes stages already measured */
+	void WriteReport(FProjectCleanerReportWriter& Writer) const;
 
 	// UI Actions
 	virtual void ExcludeSelectedAssets(const TArray<FAssetData>& Assets) override;
@@ -42,32 +69,87 @@ public:
 	const FAssetRegistryModule* GetAssetRegistry() const;
 	const TArray<FAssetData>& GetAllAssets() const;
 	const TArray<FAssetData>& GetUnusedAssets() const;
+	const TSet<FName>& GetUnusedPackages() const;
+	/** On disk footprint of all and of unused packages, summed once per analysis */
+	int64 GetTotalProjectSize() const;
+	int64 GetTotalUnusedSize() const;
 	const TSet<FName>& GetExcludedAssets() const;
 	const TSet<FName>& GetCorruptedAssets() const;
 	const TSet<FName>& GetNonEngineFiles() const;
+	const TSet<FName>& GetOrphanedFiles() const;
+	int64 GetOrphanedFilesSize() const;
 	const TSet<FName>& GetEmptyFolders() const;
 	const TSet<FName>& GetPrimaryAssetClasses() const;
 	const TMap<FAssetData, FIndirectAsset>& GetIndirectAssets() const;
+	/** Same assets as GetIndirectAssets keys, in array that can be read by index */
+	const TArray<FAssetData>& GetIndirectAssetsList() const;
+	const TArray<FAssetData>& GetRedirectors() const;
+	const TArray<FCleanerDuplicateGroup>& GetDuplicateGroups() const;
+	/** Unused packages by footprint, non engine files by size and folders by unused size, BiggestWinsNum of each */
+	const FCleanerTopK& GetBiggestUnusedAssets() const;
+	const FCleanerTopK& GetBiggestNonEngineFiles() const;
+	const FCleanerTopK& GetBiggestUnusedFolders() const;
+	const TMap<FName, FCleanerAggregateStats>& GetFolderStats() const;
+	const TMap<FName, FCleanerAggregateStats>& GetClassStats() const;
+	const FCleanerAnalysisReport& GetAnalysisReport() const;
+	/** Package file with its .uexp, .ubulk and .uptnl files as found on disk, falls back to header or registry size */
+	int64 GetPackageSize(const FName PackageName) const;
+	/** On disk footprint of packages of given assets, every package counted once */
+	int64 GetTotalSize(const TArray<FAssetData>& Assets) const;
+	/** Bytes given assets pull in through their dependencies, and part of them nothing else depends on */
+	void GetAssetsFootprint(const TArray<FAssetData>& Assets, FCleanerFootprint& OutFootprint) const;
+	/** Same as assets footprint, for all packages under given folders */
+	void GetFoldersFootprint(const TArray<FString>& Folders, FCleanerFootprint& OutFootprint) const;
 	
 	// setters
 	void SetCleanerConfigs(const UCleanerConfigs* CleanerConfigs);
 	void SetSilentMode(const bool SilentMode);
 	void SetScanDeveloperContents(const bool bScan);
+	/**
+	 * Read only analysis never loads or saves packages and never changes editor settings
+	 * Redirectors are left as they are and deleting is refused, so several runs can share one workspace
+	 */
+	void SetReadOnly(const bool bInReadOnly);
+	bool IsReadOnly() const;
+	/**
+	 * Assets, their classes and package dependencies are read from package file headers instead of asset registry
+	 * Useful when registry was never gathered, registry is still used for class hierarchy and external referencers
+	 */
+	void SetReadPackageHeaders(const bool bInReadPackageHeaders);
+	/** Package files registry lists are also checked for broken or truncated headers and reported as corrupted */
+	void SetValidatePackages(const bool bInValidatePackages);
+	/** Adds stage grouping assets with same package content, off by default because it reads candidate files fully */
+	void SetFindDuplicates(const bool bInFindDuplicates);
+	/**
+	 * Registry state was loaded from file instead of gathered from disk
+	 * Package files it does not list are counted, not reported as corrupted, registry written by cook lists cooked packages only
+	 */
+	void SetRegistryFromFile(const bool bInRegistryFromFile);
 	
 private:
 	
-	void FixupRedirectors() const;
+	void BuildAnalysisPipeline(FProjectCleanerAnalysisPipeline& Pipeline);
+	int32 FixupRedirectors() const;
 	void FindAllAssets();
-	void FindInvalidFilesAndAssets();
-	void FindIndirectAssets();
+	void FindAllAssetsFromPackageHeaders();
+	void GetPackageDependencies(const FName PackageName, TArray<FName>& OutDependencies) const;
+	void GetAssets(const FARFilter& Filter, TArray<FAssetData>& OutAssets) const;
+	int32 FindInvalidFilesAndAssets();
+	void ValidatePackageFiles(const TArray<FString>& PackageFiles);
+	int32 ResolveRedirectors();
+	FName FindRedirectorDestination(const FAssetData& Redirector) const;
+	int32 FindIndirectAssets();
 	void FindEmptyFolders(const bool bScanDevelopersContent);
 	void FindPrimaryAssetClasses();
 	void FindAssetsWithExternalReferencers();
-	void FindUnusedAssets();
+	void ClassifyAssets(const TSet<FName>& UsedAssetsDependencies);
+	int32 FindDuplicateAssets();
 	void FindUsedAssets(TSet<FName>& UsedAssets);
+	int32 BuildDependencyGraph();
 	void FindUsedAssetsDependencies(const TSet<FName>& UsedAssets, TSet<FName>& UsedAssetsDeps) const;
 	void FindExcludedAssets(TSet<FName>& UsedAssets);
-	void FillBucketWithAssets(TArray<FAssetData>& Bucket, const int32 BucketSize);
+	/** Sizes are zero for assets whose package was already counted */
+	void AddToAggregateStats(const FAssetData& AssetData, const bool bUnused, const int64 PackageSize, const int64 UnusedPackageSize);
 	bool PrepareBucketForDeletion(const TArray<FAssetData>& Bucket, TArray<UObject*>& LoadedAssets);
 	int32 DeleteBucket(const TArray<UObject*>& LoadedAssets);
 	void CleanupAfterDelete();
@@ -75,25 +157,68 @@ private:
 	/* Check Functions */
 	bool IsExcludedByClass(const FAssetData& AssetData) const;
 	bool IsExcludedByPath(const FAssetData& AssetData) const;
+	void RebuildExcludedPathsTrie();
 	
 	/* Data Containers */
 	TArray<FAssetData> AllAssets;
 	TArray<FAssetData> UnusedAssets;
-	TArray<FAssetData> PrimaryAssets;
+	TSet<FName> UnusedPackages;
+	int64 TotalProjectSize;
+	int64 TotalUnusedSize;
+	/* Packages of primary assets and map build data, refilled every analysis */
+	TSet<FName> PrimaryAssetPackages;
 	TArray<FAssetData> UserExcludedAssets;
 	TArray<FAssetData> AssetsWithExternalRefs;
 	TSet<FName> CorruptedAssets;
 	TSet<FName> NonEngineFiles;
+	/* Companion files (.uexp, .ubulk, .uptnl) without .uasset or .umap next to them, not part of NonEngineFiles */
+	TSet<FName> OrphanedFiles;
+	int64 OrphanedFilesSize;
+	/* Sizes of NonEngineFiles and OrphanedFiles, measured once while walking Content folder */
+	TMap<FName, int64> LooseFileSizes;
+	/* Sizes of package file and its companion files found in Content folder */
+	TMap<FName, int64> PackageDiskSizes;
 	TSet<FName> EmptyFolders;
 	TSet<FName> PrimaryAssetClasses;
 	TSet<FName> ExcludedAssets;
 	TMap<FAssetData, FIndirectAsset> IndirectAssets;
+	TArray<FAssetData> IndirectAssetsList;
+	/* Redirectors are not part of AllAssets, references to them are followed to final destination package */
+	TArray<FAssetData> Redirectors;
+	TMap<FName, FName> RedirectorDestinations;
+	TArray<FCleanerDuplicateGroup> DuplicateGroups;
+	FCleanerTopK BiggestUnusedAssets;
+	FCleanerTopK BiggestNonEngineFiles;
+	FCleanerTopK BiggestUnusedFolders;
+	TMap<FName, FCleanerAggregateStats> FolderStats;
+	TMap<FName, FCleanerAggregateStats> ClassStats;
+	FCleanerAnalysisReport AnalysisReport;
+	TUniquePtr<FProjectCleanerAnalysisPipeline> ActivePipeline;
+	int32 NextAnalysisStage;
+
+	/* Dependency graph of all project packages, built once per analysis */
+	FCleanerDependencyGraph DependencyGraph;
+	TArray<FName> GraphPackages;
+	TMap<FName, int32> GraphPackageIndices;
+	/* Graph nodes by folder directly containing their package, subfolders not included */
+	TMap<FName, TArray<int32>> FolderGraphNodes;
+	FCleanerFootprintCalculator FootprintCalculator;
+
+	/* Package headers, filled only when reading them instead of asset registry */
+	TArray<FCleanerPackageHeader> PackageHeaders;
+	TMap<FName, int32> PackageHeaderIndices;
 
 	/* Configs */
 	bool bSilentMode;
+	bool bReadOnly;
+	bool bReadPackageHeaders;
+	bool bValidatePackages;
+	bool bFindDuplicates;
+	bool bRegistryFromFile;
 	bool bScanDeveloperContents;
 	bool bAutomaticallyDeleteEmptyFolders;
 	TSet<FName> ExcludedPaths;
+	FCleanerPathTrie ExcludedPathsTrie;
 	TSet<FName> ExcludedClasses;
 	bool bCancelledByUser;
 
@@ -104,4 +229,5 @@ private:
 
 	/* Constants */
 	const FName RelativeRoot;
+	const int32 BiggestWinsNum;
 };
\ No newline at end of file
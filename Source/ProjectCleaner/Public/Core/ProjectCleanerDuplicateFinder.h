@@ -0,0 +1,74 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "StructsContainer.h"
+// Engine Headers
+#include "CoreMinimal.h"
+
+/**
+ * Finds packages with same content
+ *
+ * Package header holds package own name and path, so same texture imported into different folders
+ * differs only there. Content after header is what is compared.
+ * Packages are grouped by class and content size first, only packages sharing group with others are hashed.
+ * Packages with equal hashes are compared byte by byte before reported as duplicates.
+ * Header sizes and hashes are cached by file size and modification time in Saved/ProjectCleaner.
+ *
+ *
+ * Near duplicates (same source re-imported with other settings, resaved with changed property) are found
+ * among remaining packages of same class and similar size. Content is split into content defined chunks,
+ * so inserted bytes change only chunks around them, and smallest chunk hashes of every package make its sketch.
+ * Packages sharing enough of sketch are grouped, with estimated similarity reported on group.
+ */
+class FProjectCleanerDuplicateFinder
+{
+public:
+	explicit FProjectCleanerDuplicateFinder(const int32 InBatchSize = 16);
+
+	/** Groups are sorted by wasted size, biggest first */
+	void Find(const TArray<FAssetData>& Assets, TArray<FCleanerDuplicateGroup>& OutGroups);
+	/** Writes cache back to disk atomically, safe for concurrent read only runs */
+	bool SaveCache();
+
+	static FString GetDefaultCachePath();
+private:
+	struct FCachedContent
+	{
+		int64 FileSize = 0;
+		FDateTime ModificationTime;
+		int64 HeaderSize = INDEX_NONE;
+		uint64 Hash = 0;
+		bool bHashed = false;
+		/** Smallest chunk hashes, sorted */
+		TArray<uint64> Sketch;
+		bool bSketched = false;
+
+		friend FArchive& operator<<(FArchive& Ar, FCachedContent& Content)
+		{
+			return Ar << Content.FileSize << Content.ModificationTime << Content.HeaderSize << Content.Hash << Content.bHashed << Content.Sketch << Content.bSketched;
+		}
+	};
+
+	struct FCandidate
+	{
+		int32 AssetIndex = INDEX_NONE;
+		FString File;
+		FCachedContent Content;
+	};
+
+	static bool ReadHeaderSize(const FString& File, TArray<uint8>& Buffer, int64& OutHeaderSize);
+	static bool HashContent(const FString& File, const int64 Offset, TArray<uint8>& Buffer, uint64& OutHash);
+	static bool IsSameContent(const FCandidate& A, const FCandidate& B, TArray<uint8>& BufferA, TArray<uint8>& BufferB);
+	static bool SketchContent(const FString& File, const int64 Offset, TArray<uint8>& Buffer, TArray<uint64>& OutSketch);
+	/** Estimated share of chunks both contents have, from their sketches */
+	static float GetSimilarity(const TArray<uint64>& SketchA, const TArray<uint64>& SketchB);
+	static void FindNearDuplicates(const TArray<FAssetData>& Assets, const TArray<FCandidate>& Candidates, const TArray<int32>& NearCandidates, TArray<FCleanerDuplicateGroup>& OutGroups);
+	/** Returns cached result if file did not change since, otherwise resets it to current file size and time */
+	bool FindCachedContent(const FString& File, const FFileStatData& StatData, FCachedContent& OutContent) const;
+	void LoadCache();
+
+	TMap<FString, FCachedContent> Cache;
+	int32 BatchSize;
+	bool bCacheLoaded;
+};
@@ -33,12 +33,24 @@ public:
 	const FProjectCleanerDataManager& GetDataManager() const;
 	const TArray<FAssetData>& GetAllAssets() const;
 	const TArray<FAssetData>& GetUnusedAssets() const;
+	const TSet<FName>& GetUnusedPackages() const;
+	int64 GetTotalProjectSize() const;
+	int64 GetTotalUnusedSize() const;
 	const TSet<FName>& GetExcludedAssets() const;
 	const TSet<FName>& GetCorruptedAssets() const;
+	const TArray<FCleanerDuplicateGroup>& GetDuplicateGroups() const;
+	const FCleanerTopK& GetBiggestUnusedAssets() const;
+	const FCleanerTopK& GetBiggestNonEngineFiles() const;
+	const FCleanerTopK& GetBiggestUnusedFolders() const;
 	const TSet<FName>& GetNonEngineFiles() const;
+	const TSet<FName>& GetOrphanedFiles() const;
+	int64 GetOrphanedFilesSize() const;
 	const TMap<FAssetData, FIndirectAsset>& GetIndirectAssets() const;
 	const TSet<FName>& GetEmptyFolders() const;
 	const TSet<FName>& GetPrimaryAssetClasses() const;
+	const TMap<FName, FCleanerAggregateStats>& GetFolderStats() const;
+	const TMap<FName, FCleanerAggregateStats>& GetClassStats() const;
+	const FCleanerAnalysisReport& GetAnalysisReport() const;
 	UCleanerConfigs* GetCleanerConfigs() const;
 	float GetUnusedAssetsPercent() const;
 
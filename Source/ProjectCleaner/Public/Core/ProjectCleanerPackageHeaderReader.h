@@ -0,0 +1,34 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "StructsContainer.h"
+// Engine Headers
+#include "CoreMinimal.h"
+
+class IFileHandle;
+struct FPackageFileSummary;
+
+/**
+ * Reads package summary, name, import, export and soft package reference tables straight from package files
+ *
+ * Only header bytes are read, package is never loaded, so dependencies and asset classes are known
+ * without asset registry gatherer. Files are split into batches, which are read in parallel on task graph workers.
+ */
+class FProjectCleanerPackageHeaderReader
+{
+public:
+	explicit FProjectCleanerPackageHeaderReader(const int32 InBatchSize = 64);
+
+	/** OutHeaders has one entry per given file, in same order. Headers that failed to parse are not valid */
+	void Read(const TArray<FString>& PackageFiles, TArray<FCleanerPackageHeader>& OutHeaders) const;
+
+	static bool ReadHeader(const FString& PackageFile, FCleanerPackageHeader& OutHeader, TArray<uint8>& Buffer);
+	/** Reads beginning of file into Buffer and parses summary from it, false if there is no package tag */
+	static bool ReadSummary(IFileHandle& FileHandle, TArray<uint8>& Buffer, FPackageFileSummary& OutSummary);
+	/** Appends next Num bytes of file to Buffer */
+	static bool ReadBytes(IFileHandle& FileHandle, TArray<uint8>& Buffer, const int64 Num);
+private:
+
+	int32 BatchSize;
+};
@@ -0,0 +1,46 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+// Engine Headers
+#include "CoreMinimal.h"
+
+/**
+ * Deep check of package files, catches packages asset registry still lists, but engine can not load
+ *
+ * Summary of every package is read and checked: package tag, engine versions and header size against file size.
+ * Tag at the end of file is checked too, so packages truncated by interrupted sync are found.
+ * Results are cached by file size and modification time in Saved/ProjectCleaner, unchanged files are not read again.
+ */
+class FProjectCleanerPackageValidator
+{
+public:
+	explicit FProjectCleanerPackageValidator(const int32 InBatchSize = 64);
+
+	/** OutErrors has one entry per given file, empty for valid packages */
+	void Validate(const TArray<FString>& PackageFiles, TArray<FString>& OutErrors);
+	/** Writes cache back to disk atomically, safe for concurrent read only runs */
+	bool SaveCache();
+
+	static FString GetDefaultCachePath();
+private:
+	struct FCachedResult
+	{
+		int64 FileSize = 0;
+		FDateTime ModificationTime;
+		FString Error;
+
+		friend FArchive& operator<<(FArchive& Ar, FCachedResult& Result)
+		{
+			return Ar << Result.FileSize << Result.ModificationTime << Result.Error;
+		}
+	};
+
+	/** Returns error text, or empty string for valid package */
+	static FString ValidatePackage(const FString& PackageFile, TArray<uint8>& Buffer);
+	void LoadCache();
+
+	TMap<FString, FCachedResult> Cache;
+	int32 BatchSize;
+	bool bCacheLoaded;
+};
@@ -0,0 +1,33 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "StructsContainer.h"
+// Engine Headers
+#include "CoreMinimal.h"
+
+class UPackage;
+
+/**
+ * Fixes up all redirectors under root path
+ *
+ * Referencers of every redirector are collected once from asset registry, then loaded in batches
+ * and resaved, dependencies before their referencers. Loading a package already follows redirectors,
+ * so resaving it is enough to point it at final destination.
+ * Redirectors whose referencers were all resaved are deleted together at the end.
+ */
+class FProjectCleanerRedirectorFixup
+{
+public:
+	explicit FProjectCleanerRedirectorFixup(const FName InRootPath, const int32 InBatchSize = 256);
+
+	FCleanerRedirectorFixupResult Run() const;
+private:
+	/** Issues async load for every package and waits for all of them at once */
+	static void LoadPackages(const TArray<FName>& PackageNames, TArray<UPackage*>& OutPackages);
+	bool IsUnderRootPath(const FName PackageName) const;
+
+	FName RootPath;
+	FString RootPathPrefix;
+	int32 BatchSize;
+};
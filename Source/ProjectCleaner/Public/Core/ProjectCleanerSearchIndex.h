@@ -0,0 +1,26 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Trigram index over list of strings, used for case insensitive substring search in result tabs
+ * Every trigram maps to sorted list of entries containing it, so query only verifies
+ * entries that contain all trigrams of search text instead of scanning all of them
+ */
+class PROJECTCLEANER_API FProjectCleanerSearchIndex
+{
+public:
+	void Build(const TArray<FString>& InEntries);
+	void Reset();
+	/** Fills OutIndices with ascending indices of entries that contain SearchText */
+	void Query(const FString& SearchText, TArray<int32>& OutIndices) const;
+	int32 Num() const;
+private:
+	static uint64 MakeTrigram(const TCHAR* Chars);
+
+	/* lowercase copies of indexed strings, needed for verifying candidates */
+	TArray<FString> Entries;
+	TMap<uint64, TArray<int32>> Postings;
+};
@@ -0,0 +1,58 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+// Engine Headers
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "HAL/LowLevelMemTracker.h"
+
+/**
+ * Profiling hooks of plugin
+ * Insights: enable "ProjectCleaner" channel (-trace=cpu,counters,ProjectCleaner)
+ * Console: "stat ProjectCleaner" shows same counters live
+ */
+UE_TRACE_CHANNEL_EXTERN(ProjectCleanerChannel, PROJECTCLEANER_API);
+
+DECLARE_STATS_GROUP(TEXT("ProjectCleaner"), STATGROUP_ProjectCleaner, STATCAT_Advanced);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Files Visited"), STAT_ProjectCleaner_FilesVisited, STATGROUP_ProjectCleaner, PROJECTCLEANER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Registry Queries"), STAT_ProjectCleaner_RegistryQueries, STATGROUP_ProjectCleaner, PROJECTCLEANER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Dependency Edges Traversed"), STAT_ProjectCleaner_DependencyEdges, STATGROUP_ProjectCleaner, PROJECTCLEANER_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Bytes Scanned For Indirect Refs"), STAT_ProjectCleaner_BytesScanned, STATGROUP_ProjectCleaner, PROJECTCLEANER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Assets Deleted"), STAT_ProjectCleaner_AssetsDeleted, STATGROUP_ProjectCleaner, PROJECTCLEANER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Assets Deleted Per Second"), STAT_ProjectCleaner_AssetsDeletedPerSecond, STATGROUP_ProjectCleaner, PROJECTCLEANER_API);
+
+TRACE_DECLARE_INT_COUNTER_EXTERN(ProjectCleaner_FilesVisited);
+TRACE_DECLARE_INT_COUNTER_EXTERN(ProjectCleaner_RegistryQueries);
+TRACE_DECLARE_INT_COUNTER_EXTERN(ProjectCleaner_DependencyEdges);
+TRACE_DECLARE_INT_COUNTER_EXTERN(ProjectCleaner_BytesScanned);
+TRACE_DECLARE_INT_COUNTER_EXTERN(ProjectCleaner_AssetsDeleted);
+TRACE_DECLARE_FLOAT_COUNTER_EXTERN(ProjectCleaner_AssetsDeletedPerSecond);
+
+LLM_DECLARE_TAG_API(ProjectCleaner, PROJECTCLEANER_API);
+
+/** CPU scope visible both in Insights (on plugin channel) and in "stat ProjectCleaner" */
+#define PROJECTCLEANER_SCOPE(Name) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, ProjectCleanerChannel); \
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT(#Name), STAT_ProjectCleaner_##Name, STATGROUP_ProjectCleaner)
+
+#define PROJECTCLEANER_COUNTER_ADD(Counter, Amount) \
+	INC_DWORD_STAT_BY(STAT_ProjectCleaner_##Counter, Amount); \
+	TRACE_COUNTER_ADD(ProjectCleaner_##Counter, Amount)
+
+#define PROJECTCLEANER_COUNTER_RESET(Counter) \
+	SET_DWORD_STAT(STAT_ProjectCleaner_##Counter, 0); \
+	TRACE_COUNTER_SET(ProjectCleaner_##Counter, 0)
+
+/** Byte counters are 64 bit memory stats, scanned Source and Config trees easily exceed 4 GB */
+#define PROJECTCLEANER_BYTES_COUNTER_ADD(Counter, Amount) \
+	INC_MEMORY_STAT_BY(STAT_ProjectCleaner_##Counter, static_cast<int64>(Amount)); \
+	TRACE_COUNTER_ADD(ProjectCleaner_##Counter, static_cast<int64>(Amount))
+
+#define PROJECTCLEANER_BYTES_COUNTER_RESET(Counter) \
+	SET_MEMORY_STAT(STAT_ProjectCleaner_##Counter, 0); \
+	TRACE_COUNTER_SET(ProjectCleaner_##Counter, 0)
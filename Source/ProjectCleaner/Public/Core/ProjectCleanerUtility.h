@@ -6,9 +6,9 @@
 // Engine Headers
 #include "CoreMinimal.h"
 
-class UIndirectAsset;
 class FAssetRegistryModule;
 struct FAssetData;
+struct FCleanerFootprint;
 
 /**
  * This class responsible for different utility operations in unreal engine context
@@ -16,19 +16,28 @@ struct FAssetData;
 class PROJECTCLEANER_API ProjectCleanerUtility
 {
 public:
-	static int64 GetTotalSize(const TArray<FAssetData>& Assets);
 	static FName GetClassName(const FAssetData& AssetData);
 	static FText GetDeletionProgressText(const int32 DeletedAssetNum, const int32 Total, const bool bShowPercent);
+	static FText GetFootprintText(const FCleanerFootprint& Footprint);
 	static FString ConvertAbsolutePathToInternal(const FString& InPath);
 	static FString ConvertInternalToAbsolutePath(const FString& InPath);
 	static void SaveAllAssets(const bool PromptUser);
 	static void UpdateAssetRegistry(bool bSyncScan);
+	static bool LoadAssetRegistryFromFile(const FString& FilePath);
+	/**
+	 * Writes file under unique temporary name and renames it over given path
+	 * Readers see either old or new file, never partially written one, and concurrent writers never mix their content
+	 */
+	static bool SaveFileAtomically(const FString& FilePath, TFunctionRef<void(FArchive&)> Serialize);
 	static void FocusOnGameFolder();
 	static bool FindEmptyFoldersInPath(const FString& FolderPath, TSet<FName>& EmptyFolders);
 	static int32 DeleteAssets(TArray<FAssetData>& Assets, const bool ForceDelete);
 	static bool IsEngineExtension(const FString& Extension);
+	/** Split package files (.uexp, .ubulk, .uptnl), they only make sense next to .uasset or .umap with same stem */
+	static bool IsEngineCompanionExtension(const FString& Extension);
+	/** File path without any extension, "C:/Content/T_Rock.m.ubulk" => "C:/Content/T_Rock" */
+	static FString GetPackageFileStem(const FString& FilePath);
 	static bool IsUnderMegascansFolder(const FAssetData& AssetData);
-	static bool HasIndirectlyUsedAssets(const FString& FileContent);
 private:
 	static FString ConvertPathInternal(const FString& From, const FString To, const FString& Path);
 };
\ No newline at end of file
@@ -33,6 +33,12 @@ public:
 
 	UPROPERTY(DisplayName = "Delete Empty Folders After Assets Deleted", EditAnywhere, Category = "CleanerConfigs")
 	bool bAutomaticallyDeleteEmptyFolders = true;
+
+	UPROPERTY(DisplayName = "Validate Package Files", EditAnywhere, Category = "CleanerConfigs", meta = (ToolTip = "Read header of every package file and report truncated or broken ones as corrupted. By Default false"))
+	bool bValidatePackages = false;
+
+	UPROPERTY(DisplayName = "Find Duplicate Assets", EditAnywhere, Category = "CleanerConfigs", meta = (ToolTip = "Find assets with same content in different packages. By Default false"))
+	bool bFindDuplicates = false;
 	
 	UPROPERTY(DisplayName = "Paths", EditAnywhere, Category = "CleanerConfigs|ExcludeOptions", meta = (ContentDir))
 	TArray<FDirectoryPath> Paths;
@@ -41,47 +47,60 @@ public:
 	TArray<UClass*> Classes;
 };
 
-UCLASS(Transient)
-class UIndirectAsset : public UObject
+/**
+ * UI list rows. Plain structs shared between list and row widgets, so no UObject created per row
+ */
+struct FCleanerIndirectAssetRow
 {
-	GENERATED_BODY()
-public:
-	UPROPERTY(DisplayName = "AssetName", VisibleAnywhere, Category="AssetUsedIndirectly")
 	FString AssetName;
-
-	UPROPERTY(DisplayName = "AssetPath", VisibleAnywhere, Category="AssetUsedIndirectly")
 	FString AssetPath;
-
-	UPROPERTY(DisplayName = "FilePath where asset used", VisibleAnywhere, Category="AssetUsedIndirectly")
 	FString FilePath;
-
-	UPROPERTY(DisplayName = "Line where asset used", VisibleAnywhere, Category="AssetUsedIndirectly")
 	int32 LineNum;
-
-	UPROPERTY(DisplayName = "AssetData", VisibleAnywhere, Category="AssetUsedIndirectly")
 	FAssetData AssetData;
+
+	FCleanerIndirectAssetRow(): LineNum(0) {}
 };
 
-UCLASS(Transient)
-class UCorruptedFile : public UObject
+struct FCleanerCorruptedFileRow
 {
-	GENERATED_BODY()
-public:
-	UPROPERTY(DisplayName = "Name", VisibleAnywhere, Category = "CorruptedFile")
 	FString Name;
-	UPROPERTY(DisplayName = "AbsolutePath", VisibleAnywhere, Category = "CorruptedFile")
 	FString AbsolutePath;
 };
 
-UCLASS(Transient)
-class UNonEngineFile : public UObject
+struct FCleanerDuplicateAssetRow
 {
-	GENERATED_BODY()
-public:
-	UPROPERTY(DisplayName = "FileName", VisibleAnywhere, Category = "NonEngineFile")
-	FString FileName;
+	int32 GroupIndex;
+	int32 GroupAssetsNum;
+	int64 Size;
+	FString AssetName;
+	FString AssetPath;
+	FString AssetClass;
+	float GroupSimilarity;
+	FAssetData AssetData;
+
+	FCleanerDuplicateAssetRow(): GroupIndex(0), GroupAssetsNum(0), Size(0), GroupSimilarity(1.0f) {}
+};
+
+enum class ECleanerBiggestWinType : uint8
+{
+	UnusedAsset,
+	NonEngineFile,
+	UnusedFolder,
+};
+
+struct FCleanerBiggestWinRow
+{
+	ECleanerBiggestWinType Type;
+	/** Package name, absolute file path or folder path, depending on type */
+	FName Name;
+	int64 Size;
 
-	UPROPERTY(DisplayName = "FilePath", VisibleAnywhere, Category = "NonEngineFile")
+	FCleanerBiggestWinRow(): Type(ECleanerBiggestWinType::UnusedAsset), Name(NAME_None), Size(0) {}
+};
+
+struct FCleanerNonEngineFileRow
+{
+	FString FileName;
 	FString FilePath;
 };
 
@@ -94,6 +113,102 @@ struct FIndirectAsset
 	FIndirectAsset(): File(FString{}), Line(0), RelativePath(NAME_None) {}
 };
 
+/**
+ * Aggregated asset usage for single folder (recursive) or asset class
+ */
+struct FCleanerAggregateStats
+{
+	FName Name;
+	FName ParentPath;
+	int32 AssetsNum;
+	int32 UnusedAssetsNum;
+	int64 TotalSize;
+	int64 UnusedSize;
+
+	FCleanerAggregateStats(): Name(NAME_None), ParentPath(NAME_None), AssetsNum(0), UnusedAssetsNum(0), TotalSize(0), UnusedSize(0) {}
+};
+
+/**
+ * Measurements of single analysis pipeline stage
+ * Memory is ProjectCleaner LLM tag when running with -llm, otherwise process used physical memory
+ * PeakMemoryGrowth is high water mark of that memory during stage above its value at stage start
+ */
+struct FCleanerStageStats
+{
+	FName Name;
+	double WallTime;
+	double CpuTime;
+	int64 MemoryDelta;
+	int64 PeakMemoryGrowth;
+	int64 ItemsProcessed;
+
+	FCleanerStageStats(): Name(NAME_None), WallTime(0.0), CpuTime(0.0), MemoryDelta(0), PeakMemoryGrowth(0), ItemsProcessed(0) {}
+
+	double GetThroughput() const
+	{
+		return WallTime > 0.0 ? ItemsProcessed / WallTime : 0.0;
+	}
+};
+
+struct FCleanerAnalysisReport
+{
+	FDateTime StartTime;
+	double TotalWallTime;
+	double TotalCpuTime;
+	int64 PeakUsedMemory;
+	TArray<FCleanerStageStats> Stages;
+	/** Stages that were not run, because they would modify project (read only mode) */
+	TArray<FName> SkippedStages;
+
+	FCleanerAnalysisReport(): StartTime(0), TotalWallTime(0.0), TotalCpuTime(0.0), PeakUsedMemory(0) {}
+};
+
+struct FCleanerRedirectorFixupResult
+{
+	int32 RedirectorsNum;
+	int32 ReferencersNum;
+	int32 SavedPackagesNum;
+	int32 FailedPackagesNum;
+	int32 DeletedRedirectorsNum;
+
+	FCleanerRedirectorFixupResult(): RedirectorsNum(0), ReferencersNum(0), SavedPackagesNum(0), FailedPackagesNum(0), DeletedRedirectorsNum(0) {}
+};
+
+struct FCleanerDuplicateGroup
+{
+	FName AssetClass;
+	/** Size of package content after header, same for every asset of exact group, of first asset for near duplicates */
+	int64 ContentSize;
+	/** Disk size of all packages in group except first one */
+	int64 WastedSize;
+	/** Lowest estimated content similarity between grouped assets, 1 for byte identical group */
+	float Similarity;
+	TArray<FAssetData> Assets;
+
+	FCleanerDuplicateGroup(): ContentSize(0), WastedSize(0), Similarity(1.0f) {}
+};
+
+struct FCleanerPackageHeaderAsset
+{
+	FName AssetName;
+	FName AssetClass;
+	/** Object paths of blueprint generated class and its parent, none for other assets */
+	FName GeneratedClass;
+	FName ParentClass;
+};
+
+struct FCleanerPackageHeader
+{
+	FName PackageName;
+	/** Hard and soft package dependencies, script packages are skipped */
+	TArray<FName> Dependencies;
+	TArray<FCleanerPackageHeaderAsset> Assets;
+	int64 FileSize;
+	bool bValid;
+
+	FCleanerPackageHeader(): FileSize(0), bValid(false) {}
+};
+
 struct FStandardCleanerText
 {
 	constexpr static TCHAR* AssetsDeleteWindowTitle = TEXT("Confirm deletion");
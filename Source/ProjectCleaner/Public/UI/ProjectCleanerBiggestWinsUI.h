@@ -0,0 +1,101 @@
+﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "StructsContainer.h"
+// Engine Headers
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+
+class FProjectCleanerManager;
+class FCleanerTopK;
+
+class SBiggestWinUISelectionRow : public SMultiColumnTableRow<TSharedPtr<FCleanerBiggestWinRow>>
+{
+public:
+
+	SLATE_BEGIN_ARGS(SBiggestWinUISelectionRow) {}
+		SLATE_ARGUMENT(TSharedPtr<FCleanerBiggestWinRow>, SelectedRowItem)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTableView)
+	{
+		SelectedRowItem = InArgs._SelectedRowItem;
+		
+		SMultiColumnTableRow<TSharedPtr<FCleanerBiggestWinRow>>::Construct(
+			SMultiColumnTableRow<TSharedPtr<FCleanerBiggestWinRow>>::FArguments()
+			.Padding(
+				FMargin(0.f, 2.f, 0.f, 0.f)),
+			InOwnerTableView
+		);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& InColumnName) override
+	{
+		TSharedPtr<SWidget> ColumnWidget;
+
+		if (InColumnName == TEXT("Category"))
+		{
+			ColumnWidget = SNew(STextBlock).Text(GetCategoryText(SelectedRowItem->Type));
+		}
+		else if (InColumnName == TEXT("Path"))
+		{
+			ColumnWidget = SNew(STextBlock).Text(FText::FromName(SelectedRowItem->Name));
+		}
+		else if (InColumnName == TEXT("Size"))
+		{
+			ColumnWidget = SNew(STextBlock).Text(FText::AsMemory(SelectedRowItem->Size));
+		}
+		else 
+		{
+			ColumnWidget = SNew(STextBlock).Text(FText::FromString("No Data"));
+		}
+
+		return ColumnWidget.ToSharedRef();
+	}
+private:
+	static FText GetCategoryText(const ECleanerBiggestWinType Type)
+	{
+		switch (Type)
+		{
+			case ECleanerBiggestWinType::UnusedAsset: return FText::FromString(TEXT("Unused Asset"));
+			case ECleanerBiggestWinType::NonEngineFile: return FText::FromString(TEXT("Non Engine File"));
+			case ECleanerBiggestWinType::UnusedFolder: return FText::FromString(TEXT("Unused Folder"));
+			default: return FText::GetEmpty();
+		}
+	}
+
+	TSharedPtr<FCleanerBiggestWinRow> SelectedRowItem;
+};
+
+/**
+ * Biggest unused assets, non engine files and folders with most unused bytes
+ * Rows come from bounded heaps filled during analysis, nothing is sorted here
+ */
+class SProjectCleanerBiggestWinsUI : public SCompoundWidget
+{
+public:
+	
+	SLATE_BEGIN_ARGS(SProjectCleanerBiggestWinsUI) {}
+		SLATE_ARGUMENT(FProjectCleanerManager*, CleanerManager);
+	SLATE_END_ARGS()
+	
+	void Construct(const FArguments& InArgs);
+	void SetCleanerManager(FProjectCleanerManager* CleanerManagerPtr);
+	void UpdateUI();
+	void MarkDirty();
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+private:
+	void AddRows(const ECleanerBiggestWinType Type, const FCleanerTopK& TopK);
+	TSharedRef<ITableRow> OnGenerateRow(
+		TSharedPtr<FCleanerBiggestWinRow> InItem,
+		const TSharedRef<STableViewBase>& OwnerTable
+	) const;
+	void OnMouseDoubleClick(TSharedPtr<FCleanerBiggestWinRow> Item) const;
+
+	/** Data **/
+	TArray<TSharedPtr<FCleanerBiggestWinRow>> BiggestWins;
+	TSharedPtr<SListView<TSharedPtr<FCleanerBiggestWinRow>>> ListView;
+	bool bDirty = false;
+	FProjectCleanerManager* CleanerManager = nullptr;
+};
\ No newline at end of file
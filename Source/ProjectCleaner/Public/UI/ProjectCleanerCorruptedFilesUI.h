@@ -3,26 +3,27 @@
 #pragma once
 
 #include "StructsContainer.h"
+#include "Core/ProjectCleanerSearchIndex.h"
 // Engine Headers
 #include "CoreMinimal.h"
 #include "Widgets/SCompoundWidget.h"
 
 class FProjectCleanerManager;
 
-class SCorruptedFileUISelectionRow : public SMultiColumnTableRow<TWeakObjectPtr<UCorruptedFile>>
+class SCorruptedFileUISelectionRow : public SMultiColumnTableRow<TSharedPtr<FCleanerCorruptedFileRow>>
 {
 public:
 
 	SLATE_BEGIN_ARGS(SCorruptedFileUISelectionRow) {}
-		SLATE_ARGUMENT(TWeakObjectPtr<UCorruptedFile>, SelectedRowItem)
+		SLATE_ARGUMENT(TSharedPtr<FCleanerCorruptedFileRow>, SelectedRowItem)
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTableView)
 	{
 		SelectedRowItem = InArgs._SelectedRowItem;
 		
-		SMultiColumnTableRow<TWeakObjectPtr<UCorruptedFile>>::Construct(
-			SMultiColumnTableRow<TWeakObjectPtr<UCorruptedFile>>::FArguments()
+		SMultiColumnTableRow<TSharedPtr<FCleanerCorruptedFileRow>>::Construct(
+			SMultiColumnTableRow<TSharedPtr<FCleanerCorruptedFileRow>>::FArguments()
 			.Padding(
 				FMargin(0.f, 2.f, 0.f, 0.f)),
 			InOwnerTableView
@@ -49,7 +50,7 @@ public:
 		return ColumnWidget.ToSharedRef();
 	}
 private:
-	TWeakObjectPtr<UCorruptedFile> SelectedRowItem;
+	TSharedPtr<FCleanerCorruptedFileRow> SelectedRowItem;
 };
 
 class SProjectCleanerCorruptedFilesUI : public SCompoundWidget
@@ -63,15 +64,29 @@ public:
 	void Construct(const FArguments& InArgs);
 	void SetCleanerManager(FProjectCleanerManager* CleanerManagerPtr);
 	void UpdateUI();
+	void MarkDirty();
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
 private:
 	TSharedRef<ITableRow> OnGenerateRow(
-		TWeakObjectPtr<UCorruptedFile> InItem,
+		TSharedPtr<FCleanerCorruptedFileRow> InItem,
 		const TSharedRef<STableViewBase>& OwnerTable
 	) const;
-	void OnMouseDoubleClick(TWeakObjectPtr<UCorruptedFile> Item) const;
+	void OnMouseDoubleClick(TSharedPtr<FCleanerCorruptedFileRow> Item) const;
+	void OnFilterTextChanged(const FText& InFilterText);
+	void ApplyFilter();
+	void OnSort(EColumnSortPriority::Type SortPriority, const FName& ColumnName, EColumnSortMode::Type InSortMode);
+	EColumnSortMode::Type GetSortMode(const FName ColumnName) const;
+	void SortRows();
 
 	/** Data **/
-	TArray<TWeakObjectPtr<UCorruptedFile>> CorruptedFiles;
-	TSharedPtr<SListView<TWeakObjectPtr<UCorruptedFile>>> ListView;
+	TArray<TSharedPtr<FCleanerCorruptedFileRow>> CorruptedFiles;
+	TArray<TSharedPtr<FCleanerCorruptedFileRow>> FilteredCorruptedFiles;
+	TMap<FName, TSharedPtr<FCleanerCorruptedFileRow>> RowsByFile;
+	FProjectCleanerSearchIndex SearchIndex;
+	TSharedPtr<SListView<TSharedPtr<FCleanerCorruptedFileRow>>> ListView;
+	FString FilterText;
+	FName SortColumn = TEXT("AbsolutePath");
+	EColumnSortMode::Type SortMode = EColumnSortMode::Ascending;
+	bool bDirty = false;
 	FProjectCleanerManager* CleanerManager = nullptr;
 };
\ No newline at end of file
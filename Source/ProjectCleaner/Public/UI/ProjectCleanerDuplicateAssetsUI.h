@@ -0,0 +1,118 @@
+﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "StructsContainer.h"
+#include "Core/ProjectCleanerSearchIndex.h"
+// Engine Headers
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+
+class FProjectCleanerManager;
+
+class SDuplicateAssetUISelectionRow : public SMultiColumnTableRow<TSharedPtr<FCleanerDuplicateAssetRow>>
+{
+public:
+
+	SLATE_BEGIN_ARGS(SDuplicateAssetUISelectionRow) {}
+		SLATE_ARGUMENT(TSharedPtr<FCleanerDuplicateAssetRow>, SelectedRowItem)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTableView)
+	{
+		SelectedRowItem = InArgs._SelectedRowItem;
+		
+		SMultiColumnTableRow<TSharedPtr<FCleanerDuplicateAssetRow>>::Construct(
+			SMultiColumnTableRow<TSharedPtr<FCleanerDuplicateAssetRow>>::FArguments()
+			.Padding(
+				FMargin(0.f, 2.f, 0.f, 0.f)),
+			InOwnerTableView
+		);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& InColumnName) override
+	{
+		TSharedPtr<SWidget> ColumnWidget;
+
+		if (InColumnName == TEXT("Group"))
+		{
+			// near duplicates show how similar they are, exact ones are byte identical
+			ColumnWidget = SNew(STextBlock).Text(SelectedRowItem->GroupSimilarity < 1.0f
+				? FText::Format(
+					FText::FromString(TEXT("#{0} ({1} assets, {2} similar)")),
+					FText::AsNumber(SelectedRowItem->GroupIndex + 1),
+					FText::AsNumber(SelectedRowItem->GroupAssetsNum),
+					FText::AsPercent(SelectedRowItem->GroupSimilarity)
+				)
+				: FText::Format(
+					FText::FromString(TEXT("#{0} ({1} assets)")),
+					FText::AsNumber(SelectedRowItem->GroupIndex + 1),
+					FText::AsNumber(SelectedRowItem->GroupAssetsNum)
+				));
+		}
+		else if (InColumnName == TEXT("Name"))
+		{
+			ColumnWidget = SNew(STextBlock).Text(FText::FromString(SelectedRowItem->AssetName));
+		}
+		else if (InColumnName == TEXT("Path"))
+		{
+			ColumnWidget = SNew(STextBlock).Text(FText::FromString(SelectedRowItem->AssetPath));
+		}
+		else if (InColumnName == TEXT("Class"))
+		{
+			ColumnWidget = SNew(STextBlock).Text(FText::FromString(SelectedRowItem->AssetClass));
+		}
+		else if (InColumnName == TEXT("Size"))
+		{
+			ColumnWidget = SNew(STextBlock).Text(FText::AsMemory(SelectedRowItem->Size));
+		}
+		else 
+		{
+			ColumnWidget = SNew(STextBlock).Text(FText::FromString("No Data"));
+		}
+
+		return ColumnWidget.ToSharedRef();
+	}
+private:
+	TSharedPtr<FCleanerDuplicateAssetRow> SelectedRowItem;
+};
+
+class SProjectCleanerDuplicateAssetsUI : public SCompoundWidget
+{
+public:
+	
+	SLATE_BEGIN_ARGS(SProjectCleanerDuplicateAssetsUI) {}
+		SLATE_ARGUMENT(FProjectCleanerManager*, CleanerManager);
+	SLATE_END_ARGS()
+	
+	void Construct(const FArguments& InArgs);
+	void SetCleanerManager(FProjectCleanerManager* CleanerManagerPtr);
+	void UpdateUI();
+	void MarkDirty();
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+private:
+	TSharedRef<ITableRow> OnGenerateRow(
+		TSharedPtr<FCleanerDuplicateAssetRow> InItem,
+		const TSharedRef<STableViewBase>& OwnerTable
+	) const;
+	void OnMouseDoubleClick(TSharedPtr<FCleanerDuplicateAssetRow> Item) const;
+	void OnFilterTextChanged(const FText& InFilterText);
+	void ApplyFilter();
+	void OnSort(EColumnSortPriority::Type SortPriority, const FName& ColumnName, EColumnSortMode::Type InSortMode);
+	EColumnSortMode::Type GetSortMode(const FName ColumnName) const;
+	void SortRows();
+	FText GetSummaryText() const;
+
+	/** Data **/
+	TArray<TSharedPtr<FCleanerDuplicateAssetRow>> DuplicateAssets;
+	TArray<TSharedPtr<FCleanerDuplicateAssetRow>> FilteredDuplicateAssets;
+	FProjectCleanerSearchIndex SearchIndex;
+	TSharedPtr<SListView<TSharedPtr<FCleanerDuplicateAssetRow>>> ListView;
+	FString FilterText;
+	FName SortColumn = TEXT("Group");
+	EColumnSortMode::Type SortMode = EColumnSortMode::Ascending;
+	int32 GroupsNum = 0;
+	int64 WastedSize = 0;
+	bool bDirty = false;
+	FProjectCleanerManager* CleanerManager = nullptr;
+};
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "Core/ProjectCleanerSearchIndex.h"
 // Engine Headers
 #include "CoreMinimal.h"
 #include "Widgets/SCompoundWidget.h"
@@ -22,12 +23,18 @@ public:
 	void Construct(const FArguments& InArgs);
 	void SetCleanerManager(FProjectCleanerManager* CleanerManagerPtr);
 	void UpdateUI();
+	void MarkDirty();
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
 private:
 	
 	void RegisterCommands();
 
 	/* AssetPickerConfig */
 	void GenerateFilter();
+	void OnSearchTextChanged(const FText& InSearchText);
+	void RebuildSearchIndex();
+	void UpdateSearchMatches();
+	bool OnShouldFilterAsset(const FAssetData& AssetData) const;
 	TSharedPtr<SWidget> OnGetAssetContextMenu(const TArray<FAssetData>& SelectedAssets) const;
 	TSharedPtr<SWidget> OnGetFolderContextMenu(
 		const TArray<FString>& SelectedPaths,
@@ -45,6 +52,15 @@ private:
 
 	/* Data */
 	FGetCurrentSelectionDelegate GetCurrentSelectionDelegate;
+	FRefreshAssetViewDelegate RefreshAssetViewDelegate;
+	FSetARFilterDelegate SetFilterDelegate;
+	TSharedPtr<class SBox> AssetPickerBox;
+
+	/* Search */
+	FString SearchText;
+	TArray<FName> SearchPackages;
+	TSet<FName> SearchMatches;
+	FProjectCleanerSearchIndex SearchIndex;
 	TSharedPtr<FUICommandList> Commands;
 
 	/* PathPickerConfig */
@@ -53,6 +69,7 @@ private:
 	void OnPathSelected(const FString& Path);
 
 	/* ProjectCleanerManager */
+	bool bDirty = false;
 	FProjectCleanerManager* CleanerManager = nullptr;
 	
 	class FContentBrowserModule* ContentBrowserModule = nullptr;
@@ -5,23 +5,24 @@
 #include "CoreMinimal.h"
 #include "Widgets/SCompoundWidget.h"
 #include "StructsContainer.h"
+#include "Core/ProjectCleanerSearchIndex.h"
 
 class FProjectCleanerManager;
 
-class SIndirectAssetsUISelectionRow : public SMultiColumnTableRow<TWeakObjectPtr<UIndirectAsset>>
+class SIndirectAssetsUISelectionRow : public SMultiColumnTableRow<TSharedPtr<FCleanerIndirectAssetRow>>
 {
 public:
 	
 	SLATE_BEGIN_ARGS(SIndirectAssetsUISelectionRow){}
-		SLATE_ARGUMENT(TWeakObjectPtr<UIndirectAsset>, SelectedRowItem)
+		SLATE_ARGUMENT(TSharedPtr<FCleanerIndirectAssetRow>, SelectedRowItem)
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTableView)
 	{
 		SelectedRowItem = InArgs._SelectedRowItem;
 
-		SMultiColumnTableRow<TWeakObjectPtr<UIndirectAsset>>::Construct(
-		SMultiColumnTableRow<TWeakObjectPtr<UIndirectAsset>>::FArguments()
+		SMultiColumnTableRow<TSharedPtr<FCleanerIndirectAssetRow>>::Construct(
+		SMultiColumnTableRow<TSharedPtr<FCleanerIndirectAssetRow>>::FArguments()
 		.Padding(
 			FMargin(0.f, 2.f, 0.f, 0.f)),
 			InOwnerTableView
@@ -57,7 +58,7 @@ public:
 	}
 
 private:
-	TWeakObjectPtr<UIndirectAsset> SelectedRowItem;
+	TSharedPtr<FCleanerIndirectAssetRow> SelectedRowItem;
 };
 
 class SProjectCleanerIndirectAssetsUI : public SCompoundWidget
@@ -71,13 +72,29 @@ public:
 	void Construct(const FArguments& InArgs);
 	void SetCleanerManager(FProjectCleanerManager* CleanerManagerPtr);
 	void UpdateUI();
+	void MarkDirty();
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
 private:
 	TSharedRef<ITableRow> OnGenerateRow(
-		TWeakObjectPtr<UIndirectAsset> InItem,
+		TSharedPtr<FCleanerIndirectAssetRow> InItem,
 		const TSharedRef<STableViewBase>& OwnerTable
 	) const;
-	void OnMouseDoubleClick(TWeakObjectPtr<UIndirectAsset> Item) const;
-	TArray<TWeakObjectPtr<UIndirectAsset>> IndirectAssets;
-	TSharedPtr<SListView<TWeakObjectPtr<UIndirectAsset>>> ListView;
+	void OnMouseDoubleClick(TSharedPtr<FCleanerIndirectAssetRow> Item) const;
+	void OnFilterTextChanged(const FText& InFilterText);
+	void ApplyFilter();
+	void OnSort(EColumnSortPriority::Type SortPriority, const FName& ColumnName, EColumnSortMode::Type InSortMode);
+	EColumnSortMode::Type GetSortMode(const FName ColumnName) const;
+	void SortRows();
+
+	/** Data **/
+	TArray<TSharedPtr<FCleanerIndirectAssetRow>> IndirectAssets;
+	TArray<TSharedPtr<FCleanerIndirectAssetRow>> FilteredIndirectAssets;
+	TMap<FName, TSharedPtr<FCleanerIndirectAssetRow>> RowsByAsset;
+	FProjectCleanerSearchIndex SearchIndex;
+	TSharedPtr<SListView<TSharedPtr<FCleanerIndirectAssetRow>>> ListView;
+	FString FilterText;
+	FName SortColumn = TEXT("AssetPath");
+	EColumnSortMode::Type SortMode = EColumnSortMode::Ascending;
+	bool bDirty = false;
 	FProjectCleanerManager* CleanerManager = nullptr;
 };
\ No newline at end of file
@@ -30,7 +30,10 @@ private:
 	TSharedRef<SDockTab> OnExcludedAssetsTabSpawn(const FSpawnTabArgs& SpawnTabArgs);
 	TSharedRef<SDockTab> OnNonEngineFilesTabSpawn(const FSpawnTabArgs& SpawnTabArgs);
 	TSharedRef<SDockTab> OnCorruptedFilesTabSpawn(const FSpawnTabArgs& SpawnTabArgs);
+	TSharedRef<SDockTab> OnDuplicateAssetsTabSpawn(const FSpawnTabArgs& SpawnTabArgs);
+	TSharedRef<SDockTab> OnBiggestWinsTabSpawn(const FSpawnTabArgs& SpawnTabArgs);
 	TSharedRef<SDockTab> OnIndirectAssetsTabSpawn(const FSpawnTabArgs& SpawnTabArgs);
+	TSharedRef<SDockTab> OnSpaceBreakdownTabSpawn(const FSpawnTabArgs& SpawnTabArgs);
 	
 	/* Btn Callbacks */
 	FReply OnRefreshBtnClick() const;
@@ -43,8 +46,11 @@ private:
 	TWeakPtr<class SProjectCleanerNonEngineFilesUI> NonEngineFilesUI;
 	TWeakPtr<class SProjectCleanerConfigsUI> CleanerConfigsUI;
 	TWeakPtr<class SProjectCleanerCorruptedFilesUI> CorruptedFilesUI;
+	TWeakPtr<class SProjectCleanerDuplicateAssetsUI> DuplicateAssetsUI;
+	TWeakPtr<class SProjectCleanerBiggestWinsUI> BiggestWinsUI;
 	TWeakPtr<class SProjectCleanerIndirectAssetsUI> IndirectAssetsUI;
 	TWeakPtr<class SProjectCleanerExcludedAssetsUI> ExcludedAssetsUI;
+	TWeakPtr<class SProjectCleanerSpaceBreakdownUI> SpaceBreakdownUI;
 	TSharedPtr<class FTabManager> TabManager;
 	TSharedPtr<FTabManager::FLayout> TabLayout;
 
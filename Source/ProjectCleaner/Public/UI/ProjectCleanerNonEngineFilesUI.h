@@ -5,23 +5,24 @@
 #include "CoreMinimal.h"
 #include "Widgets/SCompoundWidget.h"
 #include "StructsContainer.h"
+#include "Core/ProjectCleanerSearchIndex.h"
 
 class FProjectCleanerManager;
 
-class SNonEngineFilesUISelectionRow : public SMultiColumnTableRow<TWeakObjectPtr<UNonEngineFile>>
+class SNonEngineFilesUISelectionRow : public SMultiColumnTableRow<TSharedPtr<FCleanerNonEngineFileRow>>
 {
 public:
 	
 	SLATE_BEGIN_ARGS(SNonEngineFilesUISelectionRow) {}
-		SLATE_ARGUMENT(TWeakObjectPtr<UNonEngineFile>, SelectedRowItem)
+		SLATE_ARGUMENT(TSharedPtr<FCleanerNonEngineFileRow>, SelectedRowItem)
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTableView)
 	{
 		SelectedRowItem = InArgs._SelectedRowItem;
 
-		SMultiColumnTableRow<TWeakObjectPtr<UNonEngineFile>>::Construct(
-			SMultiColumnTableRow<TWeakObjectPtr<UNonEngineFile>>::FArguments()
+		SMultiColumnTableRow<TSharedPtr<FCleanerNonEngineFileRow>>::Construct(
+			SMultiColumnTableRow<TSharedPtr<FCleanerNonEngineFileRow>>::FArguments()
 			.Padding(
 				FMargin(0.f, 2.f, 0.f, 0.f)),
 			InOwnerTableView
@@ -49,7 +50,7 @@ public:
 	}
 
 private:
-	TWeakObjectPtr<UNonEngineFile> SelectedRowItem;
+	TSharedPtr<FCleanerNonEngineFileRow> SelectedRowItem;
 };
 
 
@@ -64,15 +65,29 @@ public:
 	void Construct(const FArguments& InArgs);
 	void SetCleanerManager(FProjectCleanerManager* CleanerManagerPtr);
 	void UpdateUI();
+	void MarkDirty();
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
 private:
 	TSharedRef<ITableRow> OnGenerateRow(
-		TWeakObjectPtr<UNonEngineFile> InItem,
+		TSharedPtr<FCleanerNonEngineFileRow> InItem,
 		const TSharedRef<STableViewBase>& OwnerTable
 	) const;
-	void OnMouseDoubleClick(TWeakObjectPtr<UNonEngineFile> Item) const;
+	void OnMouseDoubleClick(TSharedPtr<FCleanerNonEngineFileRow> Item) const;
+	void OnFilterTextChanged(const FText& InFilterText);
+	void ApplyFilter();
+	void OnSort(EColumnSortPriority::Type SortPriority, const FName& ColumnName, EColumnSortMode::Type InSortMode);
+	EColumnSortMode::Type GetSortMode(const FName ColumnName) const;
+	void SortRows();
 
 	/** Data **/
-	TArray<TWeakObjectPtr<UNonEngineFile>> NonEngineFiles;
-	TSharedPtr<SListView<TWeakObjectPtr<UNonEngineFile>>> ListView;
+	TArray<TSharedPtr<FCleanerNonEngineFileRow>> NonEngineFiles;
+	TArray<TSharedPtr<FCleanerNonEngineFileRow>> FilteredNonEngineFiles;
+	TMap<FName, TSharedPtr<FCleanerNonEngineFileRow>> RowsByFile;
+	FProjectCleanerSearchIndex SearchIndex;
+	TSharedPtr<SListView<TSharedPtr<FCleanerNonEngineFileRow>>> ListView;
+	FString FilterText;
+	FName SortColumn = TEXT("FilePath");
+	EColumnSortMode::Type SortMode = EColumnSortMode::Ascending;
+	bool bDirty = false;
 	FProjectCleanerManager* CleanerManager = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,108 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "StructsContainer.h"
+// Engine Headers
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+#include "Widgets/Views/SHeaderRow.h"
+
+class FProjectCleanerManager;
+
+class SSpaceBreakdownUISelectionRow : public SMultiColumnTableRow<TSharedPtr<FCleanerAggregateStats>>
+{
+public:
+
+	SLATE_BEGIN_ARGS(SSpaceBreakdownUISelectionRow) {}
+		SLATE_ARGUMENT(TSharedPtr<FCleanerAggregateStats>, SelectedRowItem)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTableView)
+	{
+		SelectedRowItem = InArgs._SelectedRowItem;
+
+		SMultiColumnTableRow<TSharedPtr<FCleanerAggregateStats>>::Construct(
+			SMultiColumnTableRow<TSharedPtr<FCleanerAggregateStats>>::FArguments()
+			.Padding(
+				FMargin(0.f, 2.f, 0.f, 0.f)),
+			InOwnerTableView
+		);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& InColumnName) override
+	{
+		TSharedPtr<SWidget> ColumnWidget;
+
+		if (InColumnName == TEXT("Name"))
+		{
+			ColumnWidget = SNew(STextBlock).Text(FText::FromName(SelectedRowItem->Name));
+		}
+		else if (InColumnName == TEXT("AssetsNum"))
+		{
+			ColumnWidget = SNew(STextBlock).Text(FText::AsNumber(SelectedRowItem->AssetsNum));
+		}
+		else if (InColumnName == TEXT("UnusedAssetsNum"))
+		{
+			ColumnWidget = SNew(STextBlock).Text(FText::AsNumber(SelectedRowItem->UnusedAssetsNum));
+		}
+		else if (InColumnName == TEXT("TotalSize"))
+		{
+			ColumnWidget = SNew(STextBlock).Text(FText::AsMemory(SelectedRowItem->TotalSize));
+		}
+		else if (InColumnName == TEXT("UnusedSize"))
+		{
+			ColumnWidget = SNew(STextBlock).Text(FText::AsMemory(SelectedRowItem->UnusedSize));
+		}
+		else
+		{
+			ColumnWidget = SNew(STextBlock).Text(FText::FromString("No Data"));
+		}
+
+		return ColumnWidget.ToSharedRef();
+	}
+
+private:
+	TSharedPtr<FCleanerAggregateStats> SelectedRowItem;
+};
+
+/**
+ * Shows how much space used and wasted by every folder and asset class in project
+ */
+class SProjectCleanerSpaceBreakdownUI : public SCompoundWidget
+{
+public:
+
+	SLATE_BEGIN_ARGS(SProjectCleanerSpaceBreakdownUI) {}
+		SLATE_ARGUMENT(FProjectCleanerManager*, CleanerManager)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+	void SetCleanerManager(FProjectCleanerManager* CleanerManagerPtr);
+	void UpdateUI();
+	void MarkDirty();
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+private:
+	TSharedRef<SHeaderRow> CreateHeaderRow(const FText& NameColumnText, const bool bFolders);
+	TSharedRef<ITableRow> OnGenerateRow(
+		TSharedPtr<FCleanerAggregateStats> InItem,
+		const TSharedRef<STableViewBase>& OwnerTable
+	) const;
+	void OnFolderDoubleClick(TSharedPtr<FCleanerAggregateStats> Item) const;
+	void OnSort(EColumnSortPriority::Type SortPriority, const FName& ColumnName, EColumnSortMode::Type SortMode, const bool bFolders);
+	EColumnSortMode::Type GetSortMode(const FName ColumnName, const bool bFolders) const;
+	static void SortRows(TArray<TSharedPtr<FCleanerAggregateStats>>& Rows, const FName& ColumnName, const EColumnSortMode::Type SortMode);
+
+	/** Data **/
+	TArray<TSharedPtr<FCleanerAggregateStats>> Folders;
+	TArray<TSharedPtr<FCleanerAggregateStats>> Classes;
+	TSharedPtr<SListView<TSharedPtr<FCleanerAggregateStats>>> FoldersListView;
+	TSharedPtr<SListView<TSharedPtr<FCleanerAggregateStats>>> ClassesListView;
+	FName FoldersSortColumn = TEXT("UnusedSize");
+	FName ClassesSortColumn = TEXT("UnusedSize");
+	EColumnSortMode::Type FoldersSortMode = EColumnSortMode::Descending;
+	EColumnSortMode::Type ClassesSortMode = EColumnSortMode::Descending;
+	bool bDirty = false;
+	FProjectCleanerManager* CleanerManager = nullptr;
+};
@@ -23,6 +23,7 @@ private:
 	FText GetTotalProjectSize() const;
 	FText GetTotalUnusedAssetsSize() const;
 	FText GetNonEngineFilesNum() const;
+	FText GetOrphanedFilesText() const;
 	FText GetIndirectAssetsNum() const;
 	FText GetEmptyFoldersNum() const;
 	FText GetCorruptedAssetsNum() const;
@@ -30,6 +31,8 @@ private:
 	TOptional<float> GetPercentRatio() const;
 	FSlateColor GetProgressBarColor() const;
 	FText GetProgressBarText() const;
+	FText GetAnalysisTimeText() const;
+	FText GetAnalysisReportText() const;
 	
 	/** Data **/
 	FProjectCleanerManager* CleanerManager = nullptr;
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "Core/ProjectCleanerSearchIndex.h"
 #include "CoreMinimal.h"
 #include "Widgets/SCompoundWidget.h"
 #include "IContentBrowserSingleton.h"
@@ -20,6 +21,8 @@ public:
 	void Construct(const FArguments& InArgs);
 	void SetCleanerManager(FProjectCleanerManager* CleanerManagerPtr);
 	void UpdateUI();
+	void MarkDirty();
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
 
 private:
 	/* UI */
@@ -35,8 +38,20 @@ private:
 	struct FARFilter Filter;
 	FGetCurrentSelectionDelegate CurrentSelectionDelegate;
 	FRefreshAssetViewDelegate RefreshAssetViewDelegate;
+	FSetARFilterDelegate SetFilterDelegate;
+	TSharedPtr<class SBox> AssetPickerBox;
+
+	/* Search */
+	FString SearchText;
+	TArray<FName> SearchPackages;
+	TSet<FName> SearchMatches;
+	FProjectCleanerSearchIndex SearchIndex;
 	
 	void GenerateFilter();
+	void OnSearchTextChanged(const FText& InSearchText);
+	void RebuildSearchIndex();
+	void UpdateSearchMatches();
+	bool OnShouldFilterAsset(const FAssetData& AssetData) const;
 	TSharedPtr<SWidget> OnGetFolderContextMenu(
 		const TArray<FString>& SelectedPaths,
 		FContentBrowserMenuExtender_SelectedPaths InMenuExtender,
@@ -51,8 +66,10 @@ private:
 	struct FPathPickerConfig PathPickerConfig;
 	FName SelectedPath = NAME_None;
 	void OnPathSelected(const FString& Path);
+	FText GetSelectedPathStatsText() const;
 
 	/* ContentBrowserModule */
 	class FContentBrowserModule* ContentBrowserModule = nullptr;
+	bool bDirty = false;
 	class FProjectCleanerManager* CleanerManager = nullptr;
 };
\ No newline at end of file
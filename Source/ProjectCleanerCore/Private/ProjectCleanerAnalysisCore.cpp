@@ -0,0 +1,703 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "ProjectCleanerAnalysisCore.h"
+
+// FCleanerDependencyGraph
+void FCleanerDependencyGraph::Build(const int32 NodesNum, const TArray<TPair<int32, int32>>& Edges)
+{
+	Offsets.Reset(NodesNum + 1);
+	Offsets.SetNumZeroed(NodesNum + 1);
+	Targets.Reset(Edges.Num());
+	Targets.SetNumUninitialized(Edges.Num());
+
+	// counting sort by source node, keeps edges of every node in insertion order
+	for (const auto& Edge : Edges)
+	{
+		check(Edge.Key >= 0 && Edge.Key < NodesNum && Edge.Value >= 0 && Edge.Value < NodesNum);
+		++Offsets[Edge.Key + 1];
+	}
+
+	for (int32 Node = 0; Node < NodesNum; ++Node)
+	{
+		Offsets[Node + 1] += Offsets[Node];
+	}
+
+	TArray<int32> Cursors{Offsets.GetData(), NodesNum};
+	for (const auto& Edge : Edges)
+	{
+		Targets[Cursors[Edge.Key]++] = Edge.Value;
+	}
+}
+
+void FCleanerDependencyGraph::Reset()
+{
+	Offsets.Reset();
+	Targets.Reset();
+}
+
+FCleanerDependencyGraph FCleanerDependencyGraph::Reverse() const
+{
+	const int32 NodesNum = GetNodesNum();
+
+	TArray<TPair<int32, int32>> ReversedEdges;
+	ReversedEdges.Reserve(Targets.Num());
+	for (int32 Node = 0; Node < NodesNum; ++Node)
+	{
+		for (const int32 Target : GetEdges(Node))
+		{
+			ReversedEdges.Emplace(Target, Node);
+		}
+	}
+
+	FCleanerDependencyGraph Reversed;
+	Reversed.Build(NodesNum, ReversedEdges);
+	return Reversed;
+}
+
+int32 FCleanerDependencyGraph::GetNodesNum() const
+{
+	return FMath::Max(0, Offsets.Num() - 1);
+}
+
+int32 FCleanerDependencyGraph::GetEdgesNum() const
+{
+	return Targets.Num();
+}
+
+TArrayView<const int32> FCleanerDependencyGraph::GetEdges(const int32 Node) const
+{
+	return TArrayView<const int32>{Targets.GetData() + Offsets[Node], Offsets[Node + 1] - Offsets[Node]};
+}
+
+void FCleanerDependencyGraph::FindReachable(const TArray<int32>& Roots, TBitArray<>& OutReachable) const
+{
+	const int32 NodesNum = GetNodesNum();
+	OutReachable.Init(false, NodesNum);
+
+	TArray<int32> Stack;
+	Stack.Reserve(Roots.Num());
+
+	for (const int32 Root : Roots)
+	{
+		if (Root < 0 || Root >= NodesNum || OutReachable[Root]) continue;
+
+		OutReachable[Root] = true;
+		Stack.Add(Root);
+	}
+
+	while (Stack.Num() > 0)
+	{
+		const int32 Node = Stack.Pop(false);
+		for (const int32 Dependency : GetEdges(Node))
+		{
+			if (OutReachable[Dependency]) continue;
+
+			OutReachable[Dependency] = true;
+			Stack.Add(Dependency);
+		}
+	}
+}
+
+int32 FCleanerDependencyGraph::FindComponents(TArray<int32>& OutComponents) const
+{
+	const int32 NodesNum = GetNodesNum();
+	OutComponents.Init(INDEX_NONE, NodesNum);
+
+	// Tarjan with explicit call stack, long dependency chains would overflow real one
+	TArray<int32> Order;
+	Order.Init(INDEX_NONE, NodesNum);
+	TArray<int32> LowLink;
+	LowLink.SetNumUninitialized(NodesNum);
+	TBitArray<> OnStack{false, NodesNum};
+	TArray<int32> Stack;
+	/** Node and offset of its next edge to visit */
+	TArray<TPair<int32, int32>> CallStack;
+	int32 NextOrder = 0;
+	int32 ComponentsNum = 0;
+
+	const auto Enter = [&] (const int32 Node)
+	{
+		Order[Node] = NextOrder;
+		LowLink[Node] = NextOrder;
+		++NextOrder;
+		Stack.Add(Node);
+		OnStack[Node] = true;
+		CallStack.Emplace(Node, Offsets[Node]);
+	};
+
+	for (int32 Root = 0; Root < NodesNum; ++Root)
+	{
+		if (Order[Root] != INDEX_NONE) continue;
+
+		Enter(Root);
+		while (CallStack.Num() > 0)
+		{
+			const int32 Node = CallStack.Last().Key;
+			const int32 EdgeOffset = CallStack.Last().Value;
+
+			if (EdgeOffset < Offsets[Node + 1])
+			{
+				++CallStack.Last().Value;
+
+				const int32 Dependency = Targets[EdgeOffset];
+				if (Order[Dependency] == INDEX_NONE)
+				{
+					Enter(Dependency);
+				}
+				else if (OnStack[Dependency])
+				{
+					LowLink[Node] = FMath::Min(LowLink[Node], Order[Dependency]);
+				}
+				continue;
+			}
+
+			// all dependencies visited, node is root of component if nothing on stack below it is reachable
+			if (LowLink[Node] == Order[Node])
+			{
+				int32 Member;
+				do
+				{
+					Member = Stack.Pop(false);
+					OnStack[Member] = false;
+					OutComponents[Member] = ComponentsNum;
+				}
+				while (Member != Node);
+
+				++ComponentsNum;
+			}
+
+			CallStack.Pop(false);
+			if (CallStack.Num() > 0)
+			{
+				const int32 Parent = CallStack.Last().Key;
+				LowLink[Parent] = FMath::Min(LowLink[Parent], LowLink[Node]);
+			}
+		}
+	}
+
+	return ComponentsNum;
+}
+
+FCleanerDependencyGraph FCleanerDependencyGraph::Condense(const TArray<int32>& Components, const int32 ComponentsNum) const
+{
+	const int32 NodesNum = GetNodesNum();
+	check(Components.Num() == NodesNum);
+
+	TArray<TPair<int32, int32>> ComponentEdges;
+	ComponentEdges.Reserve(Targets.Num());
+	for (int32 Node = 0; Node < NodesNum; ++Node)
+	{
+		for (const int32 Dependency : GetEdges(Node))
+		{
+			if (Components[Node] != Components[Dependency])
+			{
+				ComponentEdges.Emplace(Components[Node], Components[Dependency]);
+			}
+		}
+	}
+
+	// many packages of one component often depend on same packages of another one
+	ComponentEdges.Sort([] (const TPair<int32, int32>& A, const TPair<int32, int32>& B)
+	{
+		return A.Key != B.Key ? A.Key < B.Key : A.Value < B.Value;
+	});
+
+	int32 UniqueNum = 0;
+	for (int32 i = 0; i < ComponentEdges.Num(); ++i)
+	{
+		if (UniqueNum > 0 && ComponentEdges[UniqueNum - 1] == ComponentEdges[i]) continue;
+
+		ComponentEdges[UniqueNum++] = ComponentEdges[i];
+	}
+	ComponentEdges.SetNum(UniqueNum, false);
+
+	FCleanerDependencyGraph Condensed;
+	Condensed.Build(ComponentsNum, ComponentEdges);
+	return Condensed;
+}
+
+// FCleanerPathTrie
+FCleanerPathTrie::FCleanerPathTrie()
+{
+	Reset();
+}
+
+void FCleanerPathTrie::Add(const FString& Path)
+{
+	TArray<FString> Segments;
+	Path.ParseIntoArray(Segments, TEXT("/"), true);
+
+	int32 Current = 0;
+	for (auto& Segment : Segments)
+	{
+		if (const int32* Child = Nodes[Current].Children.Find(Segment))
+		{
+			Current = *Child;
+			continue;
+		}
+
+		const int32 Child = Nodes.AddDefaulted();
+		Nodes[Current].Children.Add(MoveTemp(Segment), Child);
+		Current = Child;
+	}
+
+	Nodes[Current].bTerminal = true;
+}
+
+void FCleanerPathTrie::Reset()
+{
+	Nodes.Reset();
+	Nodes.AddDefaulted();
+}
+
+bool FCleanerPathTrie::IsEmpty() const
+{
+	return Nodes.Num() == 1 && !Nodes[0].bTerminal;
+}
+
+bool FCleanerPathTrie::ContainsPrefixOf(const FString& Path) const
+{
+	int32 Current = 0;
+	int32 SegmentStart = 0;
+	const int32 Len = Path.Len();
+
+	while (!Nodes[Current].bTerminal)
+	{
+		while (SegmentStart < Len && Path[SegmentStart] == TEXT('/'))
+		{
+			++SegmentStart;
+		}
+
+		if (SegmentStart >= Len) return false;
+
+		int32 SegmentEnd = SegmentStart;
+		while (SegmentEnd < Len && Path[SegmentEnd] != TEXT('/'))
+		{
+			++SegmentEnd;
+		}
+
+		const int32* Child = Nodes[Current].Children.Find(Path.Mid(SegmentStart, SegmentEnd - SegmentStart));
+		if (!Child) return false;
+
+		Current = *Child;
+		SegmentStart = SegmentEnd;
+	}
+
+	return true;
+}
+
+// FCleanerContentFiles
+bool FCleanerContentFiles::IsPackageExtension(const FString& Extension)
+{
+	return Extension.Equals(TEXT("uasset")) || Extension.Equals(TEXT("umap"));
+}
+
+bool FCleanerContentFiles::IsCompanionExtension(const FString& Extension)
+{
+	static const TCHAR* CompanionExtensions[] = {
+		TEXT("uexp"),
+		TEXT("ubulk"),
+		TEXT("uptnl"),
+	};
+
+	for (const TCHAR* CompanionExtension : CompanionExtensions)
+	{
+		if (Extension.Equals(CompanionExtension, ESearchCase::IgnoreCase))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+FString FCleanerContentFiles::GetPackageFileStem(const FString& FilePath)
+{
+	// package names can not contain dots, so everything after first dot of file name is extension (.m.ubulk)
+	int32 SlashIndex = INDEX_NONE;
+	FilePath.FindLastChar(TEXT('/'), SlashIndex);
+
+	const int32 DotIndex = FilePath.Find(TEXT("."), ESearchCase::CaseSensitive, ESearchDir::FromStart, SlashIndex + 1);
+	return DotIndex == INDEX_NONE ? FilePath : FilePath.Left(DotIndex);
+}
+
+// FCleanerClassHierarchy
+void FCleanerClassHierarchy::Add(const FName ClassName, const FName ParentClassName)
+{
+	if (ClassName.IsNone() || ParentClassName.IsNone() || ClassName == ParentClassName) return;
+
+	Parents.Add(ClassName, ParentClassName);
+}
+
+void FCleanerClassHierarchy::Reset()
+{
+	Parents.Reset();
+}
+
+int32 FCleanerClassHierarchy::Num() const
+{
+	return Parents.Num();
+}
+
+bool FCleanerClassHierarchy::IsChildOfAny(const FName ClassName, const TSet<FName>& BaseClassNames) const
+{
+	// walk is bounded by number of known classes, so broken data with parent cycle still ends
+	FName Current = ClassName;
+	for (int32 Depth = 0; Depth <= Parents.Num() && !Current.IsNone(); ++Depth)
+	{
+		if (BaseClassNames.Contains(Current)) return true;
+
+		Current = Parents.FindRef(Current);
+	}
+
+	return false;
+}
+
+// FCleanerIndirectReferenceMatcher
+namespace ProjectCleanerAnalysisCore
+{
+	bool IsWordChar(const TCHAR Char)
+	{
+		return (Char >= TEXT('a') && Char <= TEXT('z')) || (Char >= TEXT('A') && Char <= TEXT('Z')) || (Char >= TEXT('0') && Char <= TEXT('9')) || Char == TEXT('_');
+	}
+
+	bool IsPathChar(const TCHAR Char)
+	{
+		return IsWordChar(Char) || Char == TEXT('.') || Char == TEXT('/');
+	}
+}
+
+void FCleanerIndirectReferenceMatcher::FindReferences(const FString& Content, TArray<FCleanerIndirectReference>& OutReferences)
+{
+	const int32 Len = Content.Len();
+	int32 Line = 1;
+
+	for (int32 Index = 0; Index < Len; ++Index)
+	{
+		const TCHAR Char = Content[Index];
+		if (Char == TEXT('\n'))
+		{
+			++Line;
+			continue;
+		}
+
+		if (Char != TEXT('/')) continue;
+
+		const int32 End = MatchAt(Content, Index);
+		if (End == INDEX_NONE) continue;
+
+		FCleanerIndirectReference& Reference = OutReferences.AddDefaulted_GetRef();
+		Reference.ObjectPath = Content.Mid(Index, End - Index);
+		Reference.Line = Line;
+
+		// if ObjectPath ends with "_C" , then its probably blueprint, so we trim that
+		Reference.ObjectPath.RemoveFromEnd(TEXT("_C"), ESearchCase::CaseSensitive);
+
+		// reference never contains line breaks, so skipping it keeps line counter valid
+		Index = End - 1;
+	}
+}
+
+int32 FCleanerIndirectReferenceMatcher::MatchAt(const FString& Content, const int32 Index)
+{
+	using namespace ProjectCleanerAnalysisCore;
+
+	static const TCHAR Prefix[] = TEXT("/Game");
+	constexpr int32 PrefixLen = UE_ARRAY_COUNT(Prefix) - 1;
+
+	const int32 Len = Content.Len();
+	if (Index + PrefixLen >= Len) return INDEX_NONE;
+	if (FCString::Strncmp(*Content + Index, Prefix, PrefixLen) != 0) return INDEX_NONE;
+
+	int32 End = Index + PrefixLen;
+	while (End < Len && IsPathChar(Content[End]))
+	{
+		++End;
+	}
+
+	// word boundary at end of match means trailing '.' and '/' are not part of it
+	while (End > Index + PrefixLen && !IsWordChar(Content[End - 1]))
+	{
+		--End;
+	}
+
+	return End > Index + PrefixLen ? End : INDEX_NONE;
+}
+
+// FCleanerDeletionPlanner
+void FCleanerDeletionPlanner::Plan(const FCleanerDependencyGraph& Graph, const TBitArray<>& Deletable, const int32 BucketSize, TArray<TArray<int32>>& OutBuckets)
+{
+	OutBuckets.Reset();
+
+	const int32 NodesNum = Graph.GetNodesNum();
+	check(Deletable.Num() == NodesNum);
+
+	// number of deletable referencers every deletable node still waits for
+	TArray<int32> PendingReferencers;
+	PendingReferencers.SetNumZeroed(NodesNum);
+	int32 DeletableNum = 0;
+	for (TConstSetBitIterator<> It(Deletable); It; ++It)
+	{
+		++DeletableNum;
+		for (const int32 Dependency : Graph.GetEdges(It.GetIndex()))
+		{
+			if (Dependency != It.GetIndex() && Deletable[Dependency])
+			{
+				++PendingReferencers[Dependency];
+			}
+		}
+	}
+
+	TBitArray<> Planned{false, NodesNum};
+	TArray<int32> Ready;
+	int32 ReadyHead = 0;
+	for (TConstSetBitIterator<> It(Deletable); It; ++It)
+	{
+		if (PendingReferencers[It.GetIndex()] == 0)
+		{
+			Ready.Add(It.GetIndex());
+		}
+	}
+
+	TArray<int32> Bucket;
+	Bucket.Reserve(BucketSize);
+	int32 PlannedNum = 0;
+
+	const auto FlushBucket = [&] (const bool bForce)
+	{
+		if (Bucket.Num() > 0 && (bForce || Bucket.Num() >= BucketSize))
+		{
+			OutBuckets.Add(MoveTemp(Bucket));
+			Bucket.Reset();
+			Bucket.Reserve(BucketSize);
+		}
+	};
+
+	const auto ReleaseDependencies = [&] (const int32 Node)
+	{
+		for (const int32 Dependency : Graph.GetEdges(Node))
+		{
+			if (Dependency == Node || !Deletable[Dependency] || Planned[Dependency]) continue;
+
+			if (--PendingReferencers[Dependency] == 0)
+			{
+				Ready.Add(Dependency);
+			}
+		}
+	};
+
+	// referencers are only needed when cycles are found
+	TOptional<FCleanerDependencyGraph> Referencers;
+	int32 NextUnplanned = 0;
+	TArray<int32> Group;
+	TArray<int32> Stack;
+
+	while (PlannedNum < DeletableNum)
+	{
+		while (ReadyHead < Ready.Num())
+		{
+			const int32 Node = Ready[ReadyHead++];
+			if (Planned[Node]) continue;
+
+			Planned[Node] = true;
+			++PlannedNum;
+			Bucket.Add(Node);
+			ReleaseDependencies(Node);
+			FlushBucket(false);
+		}
+
+		if (PlannedNum == DeletableNum) break;
+
+		// every remaining node waits for someone, so there is a cycle, taking first node with all its referencers
+		while (!Deletable[NextUnplanned] || Planned[NextUnplanned])
+		{
+			++NextUnplanned;
+		}
+
+		if (!Referencers.IsSet())
+		{
+			Referencers.Emplace(Graph.Reverse());
+		}
+
+		Group.Reset();
+		Stack.Reset();
+		Stack.Add(NextUnplanned);
+		Planned[NextUnplanned] = true;
+		while (Stack.Num() > 0)
+		{
+			const int32 Node = Stack.Pop(false);
+			Group.Add(Node);
+
+			for (const int32 Referencer : Referencers->GetEdges(Node))
+			{
+				if (!Deletable[Referencer] || Planned[Referencer]) continue;
+
+				Planned[Referencer] = true;
+				Stack.Add(Referencer);
+			}
+		}
+
+		PlannedNum += Group.Num();
+		Bucket.Append(Group);
+		for (const int32 Node : Group)
+		{
+			ReleaseDependencies(Node);
+		}
+		FlushBucket(false);
+	}
+
+	FlushBucket(true);
+}
+
+// FCleanerFootprintCalculator
+void FCleanerFootprintCalculator::Build(const FCleanerDependencyGraph& Graph, const TArray<int64>& NodeSizes)
+{
+	check(NodeSizes.Num() == Graph.GetNodesNum());
+
+	const int32 ComponentsNum = Graph.FindComponents(Components);
+
+	ComponentSizes.Reset(ComponentsNum);
+	ComponentSizes.SetNumZeroed(ComponentsNum);
+	ComponentNodesNum.Reset(ComponentsNum);
+	ComponentNodesNum.SetNumZeroed(ComponentsNum);
+	for (int32 Node = 0; Node < Components.Num(); ++Node)
+	{
+		ComponentSizes[Components[Node]] += NodeSizes[Node];
+		++ComponentNodesNum[Components[Node]];
+	}
+
+	Dependencies = Graph.Condense(Components, ComponentsNum);
+	Referencers = Dependencies.Reverse();
+}
+
+void FCleanerFootprintCalculator::Reset()
+{
+	Components.Reset();
+	ComponentSizes.Reset();
+	ComponentNodesNum.Reset();
+	Dependencies.Reset();
+	Referencers.Reset();
+}
+
+int32 FCleanerFootprintCalculator::GetComponentsNum() const
+{
+	return ComponentSizes.Num();
+}
+
+void FCleanerFootprintCalculator::Calculate(const TArray<int32>& Nodes, FCleanerFootprint& OutFootprint) const
+{
+	OutFootprint = FCleanerFootprint{};
+
+	const int32 ComponentsNum = ComponentSizes.Num();
+	if (ComponentsNum == 0) return;
+
+	// node in cycle can only go away together with whole cycle, so selection grows to whole components
+	TBitArray<> Selected{false, ComponentsNum};
+	TArray<int32> Roots;
+	for (const int32 Node : Nodes)
+	{
+		if (!Components.IsValidIndex(Node) || Selected[Components[Node]]) continue;
+
+		Selected[Components[Node]] = true;
+		Roots.Add(Components[Node]);
+	}
+
+	TBitArray<> Reachable;
+	Dependencies.FindReachable(Roots, Reachable);
+
+	// component referenced from outside of reachable set is shared, and so is everything it depends on
+	// selected components go away with selection, so sharing does not pass through them
+	TBitArray<> Shared{false, ComponentsNum};
+	TArray<int32> Stack;
+	for (TConstSetBitIterator<> It(Reachable); It; ++It)
+	{
+		const int32 Component = It.GetIndex();
+		if (Selected[Component]) continue;
+
+		for (const int32 Referencer : Referencers.GetEdges(Component))
+		{
+			if (!Reachable[Referencer])
+			{
+				Shared[Component] = true;
+				Stack.Add(Component);
+				break;
+			}
+		}
+	}
+
+	while (Stack.Num() > 0)
+	{
+		const int32 Component = Stack.Pop(false);
+		for (const int32 Dependency : Dependencies.GetEdges(Component))
+		{
+			if (Shared[Dependency] || Selected[Dependency]) continue;
+
+			Shared[Dependency] = true;
+			Stack.Add(Dependency);
+		}
+	}
+
+	for (TConstSetBitIterator<> It(Reachable); It; ++It)
+	{
+		const int32 Component = It.GetIndex();
+		OutFootprint.TransitiveSize += ComponentSizes[Component];
+		OutFootprint.TransitiveNum += ComponentNodesNum[Component];
+
+		if (!Shared[Component])
+		{
+			OutFootprint.ExclusiveSize += ComponentSizes[Component];
+			OutFootprint.ExclusiveNum += ComponentNodesNum[Component];
+		}
+	}
+}
+
+// FCleanerTopK
+namespace ProjectCleanerAnalysisCore
+{
+	struct FSmallerSizeFirst
+	{
+		bool operator()(const FCleanerTopK::FEntry& A, const FCleanerTopK::FEntry& B) const
+		{
+			return A.Size < B.Size;
+		}
+	};
+}
+
+FCleanerTopK::FCleanerTopK(const int32 InCapacity)
+{
+	Reset(InCapacity);
+}
+
+void FCleanerTopK::Reset(const int32 InCapacity)
+{
+	Capacity = FMath::Max(0, InCapacity);
+	Heap.Reset(Capacity);
+}
+
+void FCleanerTopK::Add(const FName Name, const int64 Size)
+{
+	if (Heap.Num() < Capacity)
+	{
+		Heap.HeapPush(FEntry{Name, Size}, ProjectCleanerAnalysisCore::FSmallerSizeFirst{});
+		return;
+	}
+
+	if (Capacity == 0 || Size <= Heap.HeapTop().Size) return;
+
+	Heap.HeapPopDiscard(ProjectCleanerAnalysisCore::FSmallerSizeFirst{}, false);
+	Heap.HeapPush(FEntry{Name, Size}, ProjectCleanerAnalysisCore::FSmallerSizeFirst{});
+}
+
+int32 FCleanerTopK::Num() const
+{
+	return Heap.Num();
+}
+
+void FCleanerTopK::GetSorted(TArray<FEntry>& OutEntries) const
+{
+	OutEntries = Heap;
+	OutEntries.Sort([] (const FEntry& A, const FEntry& B)
+	{
+		return A.Size > B.Size;
+	});
+}
@@ -0,0 +1,157 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "ProjectCleanerCoreBenchmark.h"
+// Engine Headers
+#include "Math/RandomStream.h"
+
+bool FCleanerCoreBenchmarkSettings::ParseTopology(const FString& Value, ECleanerFixtureTopology& OutTopology)
+{
+	for (const auto Topology : {ECleanerFixtureTopology::Mixed, ECleanerFixtureTopology::Chain, ECleanerFixtureTopology::FanOut, ECleanerFixtureTopology::Cycle})
+	{
+		if (Value.Equals(TopologyToString(Topology), ESearchCase::IgnoreCase))
+		{
+			OutTopology = Topology;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+const TCHAR* FCleanerCoreBenchmarkSettings::TopologyToString(const ECleanerFixtureTopology Topology)
+{
+	switch (Topology)
+	{
+		case ECleanerFixtureTopology::Chain: return TEXT("Chain");
+		case ECleanerFixtureTopology::FanOut: return TEXT("FanOut");
+		case ECleanerFixtureTopology::Cycle: return TEXT("Cycle");
+		default: return TEXT("Mixed");
+	}
+}
+
+FCleanerCoreBenchmark::FCleanerCoreBenchmark(const FCleanerCoreBenchmarkSettings& InSettings) :
+	Settings(InSettings)
+{
+	Settings.NodesNum = FMath::Max(1, Settings.NodesNum);
+	Settings.ClusterSize = FMath::Max(1, Settings.ClusterSize);
+	Settings.FanOut = FMath::Max(1, Settings.FanOut);
+	Settings.NodesPerFolder = FMath::Max(1, Settings.NodesPerFolder);
+
+	const int32 NodesNum = Settings.NodesNum;
+	FRandomStream Random{Settings.Seed};
+
+	// same cluster shapes as generated fixture
+	for (int32 First = 0, ClusterIndex = 0; First < NodesNum; First += Settings.ClusterSize, ++ClusterIndex)
+	{
+		const int32 Num = FMath::Min(Settings.ClusterSize, NodesNum - First);
+		const ECleanerFixtureTopology Topology = Settings.Topology == ECleanerFixtureTopology::Mixed
+			? static_cast<ECleanerFixtureTopology>(1 + ClusterIndex % 3)
+			: Settings.Topology;
+
+		for (int32 i = 0; i < Num; ++i)
+		{
+			if (Topology == ECleanerFixtureTopology::Chain && i + 1 < Num)
+			{
+				Edges.Emplace(First + i, First + i + 1);
+			}
+			else if (Topology == ECleanerFixtureTopology::FanOut)
+			{
+				for (int32 Child = i * Settings.FanOut + 1; Child <= i * Settings.FanOut + Settings.FanOut && Child < Num; ++Child)
+				{
+					Edges.Emplace(First + i, First + Child);
+				}
+			}
+			else if (Topology == ECleanerFixtureTopology::Cycle && Num > 1)
+			{
+				Edges.Emplace(First + i, First + (i + 1) % Num);
+			}
+		}
+
+		if (Random.FRand() < Settings.IndirectRatio)
+		{
+			Roots.Add(First);
+		}
+	}
+
+	NodeSizes.Reserve(NodesNum);
+	PackagePaths.Reserve(NodesNum);
+	for (int32 Node = 0; Node < NodesNum; ++Node)
+	{
+		NodeSizes.Add(1024 + Random.RandHelper(1024 * 1024));
+		PackagePaths.Add(FString::Printf(TEXT("%s/F%04d"), *Settings.RootPath, Node / Settings.NodesPerFolder));
+	}
+
+	// every tenth line of generated file references one of packages
+	for (int32 Line = 0; Line < NodesNum; ++Line)
+	{
+		FileContent += Line % 10 == 0
+			? FString::Printf(TEXT("+Assets=%s/A%07d.A%07d\n"), *PackagePaths[Line], Line, Line)
+			: FString::Printf(TEXT("; synthetic config line %d without references\n"), Line);
+	}
+}
+
+void FCleanerCoreBenchmark::AddStages(TFunctionRef<void(const FName Name, TFunction<int64()> Work)> AddStage)
+{
+	AddStage(TEXT("Core_BuildGraph"), [this] ()
+	{
+		Graph.Build(Settings.NodesNum, Edges);
+		return Graph.GetEdgesNum();
+	});
+	AddStage(TEXT("Core_Reachability"), [this] ()
+	{
+		Graph.FindReachable(Roots, Reachable);
+		return Graph.GetNodesNum();
+	});
+	AddStage(TEXT("Core_ReverseGraph"), [this] ()
+	{
+		return Graph.Reverse().GetEdgesNum();
+	});
+	AddStage(TEXT("Core_PlanDeletion"), [this] ()
+	{
+		TBitArray<> Deletable = Reachable;
+		Deletable.BitwiseNOT();
+		FCleanerDeletionPlanner::Plan(Graph, Deletable, 500, Buckets);
+		return Deletable.CountSetBits();
+	});
+	AddStage(TEXT("Core_PathTrie"), [this] ()
+	{
+		Trie.Reset();
+		ExcludedNum = 0;
+
+		// excluding every second folder
+		for (int32 Node = 0; Node < Settings.NodesNum; Node += Settings.NodesPerFolder * 2)
+		{
+			Trie.Add(PackagePaths[Node]);
+		}
+
+		for (const auto& PackagePath : PackagePaths)
+		{
+			ExcludedNum += Trie.ContainsPrefixOf(PackagePath) ? 1 : 0;
+		}
+		return PackagePaths.Num();
+	});
+	AddStage(TEXT("Core_IndirectMatcher"), [this] ()
+	{
+		References.Reset();
+		FCleanerIndirectReferenceMatcher::FindReferences(FileContent, References);
+		return FileContent.Len();
+	});
+	AddStage(TEXT("Core_Footprint"), [this] ()
+	{
+		FootprintCalculator.Build(Graph, NodeSizes);
+		FootprintCalculator.Calculate(Roots, Footprint);
+		return FootprintCalculator.GetComponentsNum();
+	});
+}
+
+FString FCleanerCoreBenchmark::GetSummary() const
+{
+	return FString::Printf(TEXT("%d reachable, %d buckets, %d excluded, %d references, %d components, %lld bytes exclusive footprint"),
+		Reachable.CountSetBits(),
+		Buckets.Num(),
+		ExcludedNum,
+		References.Num(),
+		FootprintCalculator.GetComponentsNum(),
+		Footprint.ExclusiveSize
+	);
+}
@@ -0,0 +1,6 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+// Engine Headers
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, ProjectCleanerCore);
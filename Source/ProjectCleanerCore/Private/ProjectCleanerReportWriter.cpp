@@ -0,0 +1,356 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "ProjectCleanerReportWriter.h"
+// Engine Headers
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+DEFINE_LOG_CATEGORY_STATIC(LogProjectCleanerReport, Log, All);
+
+namespace ProjectCleanerReportWriter
+{
+	constexpr int32 GzipChunkSize = 64 * 1024;
+
+	// every column any category can have, csv rows leave columns of other categories empty
+	const TCHAR* CsvColumns[] = {
+		TEXT("category"),
+		TEXT("path"),
+		TEXT("name"),
+		TEXT("class"),
+		TEXT("size_bytes"),
+		TEXT("unused_size_bytes"),
+		TEXT("assets"),
+		TEXT("unused_assets"),
+		TEXT("file"),
+		TEXT("line"),
+		TEXT("destination"),
+		TEXT("group"),
+		TEXT("similarity"),
+		TEXT("wall_time_sec"),
+		TEXT("cpu_time_sec"),
+		TEXT("memory_delta_bytes"),
+		TEXT("items"),
+	};
+
+	int32 FindCsvColumn(const TCHAR* Column)
+	{
+		for (int32 i = 0; i < UE_ARRAY_COUNT(CsvColumns); ++i)
+		{
+			if (FCString::Strcmp(CsvColumns[i], Column) == 0)
+			{
+				return i;
+			}
+		}
+
+		return INDEX_NONE;
+	}
+}
+
+struct FProjectCleanerReportWriter::FGzipStream
+{
+	z_stream Stream;
+	TArray<uint8> Output;
+};
+
+FProjectCleanerReportWriter::FProjectCleanerReportWriter(const ECleanerReportFormat InFormat, const bool bInCompress) :
+	Format(InFormat),
+	bCompress(bInCompress)
+{
+}
+
+FProjectCleanerReportWriter::~FProjectCleanerReportWriter()
+{
+	if (FileWriter.IsValid())
+	{
+		Close();
+	}
+}
+
+bool FProjectCleanerReportWriter::Open(const FString& FilePath)
+{
+	FileWriter.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!FileWriter.IsValid())
+	{
+		UE_LOG(LogProjectCleanerReport, Error, TEXT("Failed to create report file %s"), *FilePath);
+		return false;
+	}
+
+	if (bCompress)
+	{
+		GzipStream = MakeUnique<FGzipStream>();
+		FMemory::Memzero(GzipStream->Stream);
+		GzipStream->Output.SetNumUninitialized(ProjectCleanerReportWriter::GzipChunkSize);
+
+		// window bits 15 + 16 makes zlib write gzip header instead of raw zlib one
+		if (deflateInit2(&GzipStream->Stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		{
+			UE_LOG(LogProjectCleanerReport, Error, TEXT("Failed to initialize report compression"));
+			GzipStream.Reset();
+			FileWriter.Reset();
+			return false;
+		}
+	}
+
+	bFailed = false;
+	bFirstCategory = true;
+	RowsNum = 0;
+
+	if (Format == ECleanerReportFormat::Json)
+	{
+		Write(TEXT("{"));
+	}
+	else if (Format == ECleanerReportFormat::Csv)
+	{
+		FString Header;
+		for (const TCHAR* Column : ProjectCleanerReportWriter::CsvColumns)
+		{
+			Header += Header.IsEmpty() ? Column : FString{TEXT(",")} + Column;
+		}
+		Write(Header + TEXT("\n"));
+	}
+
+	return !bFailed;
+}
+
+bool FProjectCleanerReportWriter::Close()
+{
+	if (!FileWriter.IsValid()) return false;
+
+	if (Format == ECleanerReportFormat::Json)
+	{
+		Write(TEXT("\n}\n"));
+	}
+
+	if (GzipStream.IsValid())
+	{
+		bFailed |= !FlushCompressed(true);
+		deflateEnd(&GzipStream->Stream);
+		GzipStream.Reset();
+	}
+
+	bFailed |= !FileWriter->Close();
+	FileWriter.Reset();
+
+	return !bFailed;
+}
+
+void FProjectCleanerReportWriter::BeginCategory(const TCHAR* InCategory)
+{
+	Category = InCategory;
+	bFirstRow = true;
+
+	if (Format == ECleanerReportFormat::Json)
+	{
+		Write(FString::Printf(TEXT("%s\n\t\"%s\": ["), bFirstCategory ? TEXT("") : TEXT(","), *EscapeJson(Category)));
+	}
+
+	bFirstCategory = false;
+}
+
+void FProjectCleanerReportWriter::EndCategory()
+{
+	if (Format == ECleanerReportFormat::Json)
+	{
+		Write(bFirstRow ? TEXT("]") : TEXT("\n\t]"));
+	}
+}
+
+void FProjectCleanerReportWriter::BeginRow()
+{
+	Row.Reset();
+	bFirstField = true;
+
+	if (Format == ECleanerReportFormat::Csv)
+	{
+		CsvRow.Reset();
+		CsvRow.SetNum(UE_ARRAY_COUNT(ProjectCleanerReportWriter::CsvColumns));
+		CsvRow[0] = EscapeCsv(Category);
+		return;
+	}
+
+	Row += Format == ECleanerReportFormat::Json ? (bFirstRow ? TEXT("\n\t\t{") : TEXT(",\n\t\t{")) : TEXT("{");
+	if (Format == ECleanerReportFormat::NdJson)
+	{
+		AddString(TEXT("category"), Category);
+	}
+}
+
+void FProjectCleanerReportWriter::AddString(const TCHAR* Column, const FString& Value)
+{
+	AddField(Column, TEXT("\"") + EscapeJson(Value) + TEXT("\""), EscapeCsv(Value));
+}
+
+void FProjectCleanerReportWriter::AddInteger(const TCHAR* Column, const int64 Value)
+{
+	const FString Text = LexToString(Value);
+	AddField(Column, Text, Text);
+}
+
+void FProjectCleanerReportWriter::AddNumber(const TCHAR* Column, const double Value)
+{
+	const FString Text = FString::Printf(TEXT("%.6f"), Value);
+	AddField(Column, Text, Text);
+}
+
+void FProjectCleanerReportWriter::EndRow()
+{
+	if (Format == ECleanerReportFormat::Csv)
+	{
+		Row = FString::Join(CsvRow, TEXT(",")) + TEXT("\n");
+	}
+	else
+	{
+		Row += Format == ECleanerReportFormat::NdJson ? TEXT("}\n") : TEXT("}");
+	}
+
+	Write(Row);
+	bFirstRow = false;
+	++RowsNum;
+}
+
+int64 FProjectCleanerReportWriter::GetRowsNum() const
+{
+	return RowsNum;
+}
+
+bool FProjectCleanerReportWriter::ParseFormat(const FString& Value, ECleanerReportFormat& OutFormat)
+{
+	if (Value.Equals(TEXT("json"), ESearchCase::IgnoreCase))
+	{
+		OutFormat = ECleanerReportFormat::Json;
+		return true;
+	}
+
+	if (Value.Equals(TEXT("csv"), ESearchCase::IgnoreCase))
+	{
+		OutFormat = ECleanerReportFormat::Csv;
+		return true;
+	}
+
+	if (Value.Equals(TEXT("ndjson"), ESearchCase::IgnoreCase))
+	{
+		OutFormat = ECleanerReportFormat::NdJson;
+		return true;
+	}
+
+	return false;
+}
+
+FString FProjectCleanerReportWriter::GetDefaultReportPath(const ECleanerReportFormat Format, const bool bCompress)
+{
+	const TCHAR* Extension = Format == ECleanerReportFormat::Csv ? TEXT("csv") : Format == ECleanerReportFormat::NdJson ? TEXT("ndjson") : TEXT("json");
+	return FPaths::ProjectSavedDir() / TEXT("ProjectCleaner") / FString::Printf(TEXT("Report.%s%s"), Extension, bCompress ? TEXT(".gz") : TEXT(""));
+}
+
+void FProjectCleanerReportWriter::AddField(const TCHAR* Column, const FString& JsonValue, const FString& CsvValue)
+{
+	if (Format == ECleanerReportFormat::Csv)
+	{
+		const int32 ColumnIndex = ProjectCleanerReportWriter::FindCsvColumn(Column);
+		ensureMsgf(ColumnIndex != INDEX_NONE, TEXT("Unknown report column %s"), Column);
+		if (ColumnIndex != INDEX_NONE)
+		{
+			CsvRow[ColumnIndex] = CsvValue;
+		}
+		return;
+	}
+
+	Row += FString::Printf(TEXT("%s\"%s\": %s"), bFirstField ? TEXT("") : TEXT(", "), Column, *JsonValue);
+	bFirstField = false;
+}
+
+void FProjectCleanerReportWriter::Write(const FString& Text)
+{
+	if (bFailed || !FileWriter.IsValid()) return;
+
+	const FTCHARToUTF8 Utf8{*Text};
+	if (!WriteBytes(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length()))
+	{
+		bFailed = true;
+	}
+}
+
+bool FProjectCleanerReportWriter::WriteBytes(const uint8* Data, const int64 Size)
+{
+	if (!GzipStream.IsValid())
+	{
+		FileWriter->Serialize(const_cast<uint8*>(Data), Size);
+		return !FileWriter->IsError();
+	}
+
+	GzipStream->Stream.next_in = const_cast<Bytef*>(Data);
+	GzipStream->Stream.avail_in = static_cast<uInt>(Size);
+	return FlushCompressed(false);
+}
+
+bool FProjectCleanerReportWriter::FlushCompressed(const bool bFinish)
+{
+	z_stream& Stream = GzipStream->Stream;
+
+	// deflate until it consumed all input, or until end of stream when finishing
+	int32 Result = Z_OK;
+	do
+	{
+		Stream.next_out = GzipStream->Output.GetData();
+		Stream.avail_out = GzipStream->Output.Num();
+
+		Result = deflate(&Stream, bFinish ? Z_FINISH : Z_NO_FLUSH);
+		if (Result == Z_STREAM_ERROR)
+		{
+			return false;
+		}
+
+		const int32 Produced = GzipStream->Output.Num() - Stream.avail_out;
+		if (Produced > 0)
+		{
+			FileWriter->Serialize(GzipStream->Output.GetData(), Produced);
+		}
+	}
+	while (Stream.avail_out == 0 || (bFinish && Result != Z_STREAM_END));
+
+	return !FileWriter->IsError();
+}
+
+FString FProjectCleanerReportWriter::EscapeJson(const FString& Value)
+{
+	FString Escaped;
+	Escaped.Reserve(Value.Len());
+
+	for (const TCHAR Char : Value)
+	{
+		switch (Char)
+		{
+			case TEXT('"'): Escaped += TEXT("\\\""); break;
+			case TEXT('\\'): Escaped += TEXT("\\\\"); break;
+			case TEXT('\n'): Escaped += TEXT("\\n"); break;
+			case TEXT('\r'): Escaped += TEXT("\\r"); break;
+			case TEXT('\t'): Escaped += TEXT("\\t"); break;
+			default:
+				if (Char < 0x20)
+				{
+					Escaped += FString::Printf(TEXT("\\u%04x"), static_cast<int32>(Char));
+				}
+				else
+				{
+					Escaped.AppendChar(Char);
+				}
+		}
+	}
+
+	return Escaped;
+}
+
+FString FProjectCleanerReportWriter::EscapeCsv(const FString& Value)
+{
+	int32 Index;
+	if (!Value.FindChar(TEXT(','), Index) && !Value.FindChar(TEXT('"'), Index) && !Value.FindChar(TEXT('\n'), Index))
+	{
+		return Value;
+	}
+
+	return TEXT("\"") + Value.Replace(TEXT("\""), TEXT("\"\"")) + TEXT("\"");
+}
@@ -0,0 +1,423 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "ProjectCleanerAnalysisCore.h"
+// Engine Headers
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ProjectCleanerAnalysisCoreSpec
+{
+	constexpr EAutomationTestFlags::Type TestFlags = static_cast<EAutomationTestFlags::Type>(EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter);
+
+	FCleanerDependencyGraph MakeGraph(const int32 NodesNum, const TArray<TPair<int32, int32>>& Edges)
+	{
+		FCleanerDependencyGraph Graph;
+		Graph.Build(NodesNum, Edges);
+		return Graph;
+	}
+
+	/** Bucket index of every node, INDEX_NONE for nodes that are not planned */
+	TArray<int32> GetNodeBuckets(const int32 NodesNum, const TArray<TArray<int32>>& Buckets)
+	{
+		TArray<int32> NodeBuckets;
+		NodeBuckets.Init(INDEX_NONE, NodesNum);
+		for (int32 Bucket = 0; Bucket < Buckets.Num(); ++Bucket)
+		{
+			for (const int32 Node : Buckets[Bucket])
+			{
+				NodeBuckets[Node] = Bucket;
+			}
+		}
+
+		return NodeBuckets;
+	}
+}
+
+BEGIN_DEFINE_SPEC(FCleanerDependencyGraphSpec, "ProjectCleaner.Core.DependencyGraph", ProjectCleanerAnalysisCoreSpec::TestFlags)
+END_DEFINE_SPEC(FCleanerDependencyGraphSpec)
+
+void FCleanerDependencyGraphSpec::Define()
+{
+	using namespace ProjectCleanerAnalysisCoreSpec;
+
+	Describe("Build", [this]()
+	{
+		It("should keep edges of every node in insertion order", [this]()
+		{
+			const FCleanerDependencyGraph Graph = MakeGraph(3, {{2, 0}, {0, 2}, {0, 1}});
+
+			TestEqual(TEXT("Nodes"), Graph.GetNodesNum(), 3);
+			TestEqual(TEXT("Edges"), Graph.GetEdgesNum(), 3);
+			TestEqual(TEXT("Edges of 0"), Graph.GetEdges(0).Num(), 2);
+			TestEqual(TEXT("First edge of 0"), Graph.GetEdges(0)[0], 2);
+			TestEqual(TEXT("Second edge of 0"), Graph.GetEdges(0)[1], 1);
+			TestEqual(TEXT("Edges of 1"), Graph.GetEdges(1).Num(), 0);
+		});
+	});
+
+	Describe("FindReachable", [this]()
+	{
+		It("should mark roots and everything they depend on", [this]()
+		{
+			const FCleanerDependencyGraph Graph = MakeGraph(5, {{0, 1}, {1, 2}, {3, 4}});
+
+			TBitArray<> Reachable;
+			Graph.FindReachable({0}, Reachable);
+
+			TestTrue(TEXT("Root"), Reachable[0]);
+			TestTrue(TEXT("Direct dependency"), Reachable[1]);
+			TestTrue(TEXT("Transitive dependency"), Reachable[2]);
+			TestFalse(TEXT("Unrelated node"), Reachable[3]);
+			TestFalse(TEXT("Dependency of unrelated node"), Reachable[4]);
+		});
+
+		It("should ignore invalid roots", [this]()
+		{
+			const FCleanerDependencyGraph Graph = MakeGraph(2, {{0, 1}});
+
+			TBitArray<> Reachable;
+			Graph.FindReachable({INDEX_NONE, 5}, Reachable);
+
+			TestEqual(TEXT("Reachable"), Reachable.CountSetBits(), 0);
+		});
+	});
+
+	Describe("FindComponents", [this]()
+	{
+		// 0 -> 1 -> 2 -> 0 cycle depends on 3 <-> 4 cycle, 5 is alone
+		const TArray<TPair<int32, int32>> Edges{{0, 1}, {1, 2}, {2, 0}, {2, 3}, {3, 4}, {4, 3}};
+
+		It("should put every node of cycle into one component", [this, Edges]()
+		{
+			const FCleanerDependencyGraph Graph = MakeGraph(6, Edges);
+
+			TArray<int32> Components;
+			TestEqual(TEXT("Components"), Graph.FindComponents(Components), 3);
+			TestEqual(TEXT("0 and 1"), Components[0], Components[1]);
+			TestEqual(TEXT("0 and 2"), Components[0], Components[2]);
+			TestEqual(TEXT("3 and 4"), Components[3], Components[4]);
+			TestNotEqual(TEXT("0 and 3"), Components[0], Components[3]);
+			TestNotEqual(TEXT("5 and 0"), Components[5], Components[0]);
+			TestNotEqual(TEXT("5 and 3"), Components[5], Components[3]);
+		});
+
+		It("should number components in reverse topological order", [this, Edges]()
+		{
+			const FCleanerDependencyGraph Graph = MakeGraph(6, Edges);
+
+			TArray<int32> Components;
+			Graph.FindComponents(Components);
+
+			TestTrue(TEXT("Dependency component comes first"), Components[3] < Components[0]);
+		});
+
+		It("should handle long chains without recursion", [this]()
+		{
+			constexpr int32 NodesNum = 200000;
+			TArray<TPair<int32, int32>> Edges;
+			for (int32 Node = 0; Node + 1 < NodesNum; ++Node)
+			{
+				Edges.Emplace(Node, Node + 1);
+			}
+			Edges.Emplace(NodesNum - 1, 0);
+
+			TArray<int32> Components;
+			TestEqual(TEXT("Components"), MakeGraph(NodesNum, Edges).FindComponents(Components), 1);
+		});
+	});
+
+	Describe("Condense", [this]()
+	{
+		It("should connect components once and drop edges inside them", [this]()
+		{
+			const FCleanerDependencyGraph Graph = MakeGraph(4, {{0, 1}, {1, 0}, {0, 2}, {1, 2}, {1, 3}, {2, 3}, {3, 2}});
+
+			TArray<int32> Components;
+			const int32 ComponentsNum = Graph.FindComponents(Components);
+			const FCleanerDependencyGraph Condensed = Graph.Condense(Components, ComponentsNum);
+
+			TestEqual(TEXT("Components"), ComponentsNum, 2);
+			TestEqual(TEXT("Edges"), Condensed.GetEdgesNum(), 1);
+			TestEqual(TEXT("Edges of cycle 0-1"), Condensed.GetEdges(Components[0]).Num(), 1);
+			TestEqual(TEXT("Edge target"), Condensed.GetEdges(Components[0])[0], Components[2]);
+		});
+	});
+}
+
+BEGIN_DEFINE_SPEC(FCleanerPathTrieSpec, "ProjectCleaner.Core.PathTrie", ProjectCleanerAnalysisCoreSpec::TestFlags)
+END_DEFINE_SPEC(FCleanerPathTrieSpec)
+
+void FCleanerPathTrieSpec::Define()
+{
+	It("should match added path and paths under it", [this]()
+	{
+		FCleanerPathTrie Trie;
+		Trie.Add(TEXT("/Game/Props"));
+
+		TestTrue(TEXT("/Game/Props"), Trie.ContainsPrefixOf(TEXT("/Game/Props")));
+		TestTrue(TEXT("/Game/Props/"), Trie.ContainsPrefixOf(TEXT("/Game/Props/")));
+		TestTrue(TEXT("/Game/Props/Chairs"), Trie.ContainsPrefixOf(TEXT("/Game/Props/Chairs")));
+		TestTrue(TEXT("Different case"), Trie.ContainsPrefixOf(TEXT("/game/props/Chairs")));
+	});
+
+	It("should match whole segments only", [this]()
+	{
+		FCleanerPathTrie Trie;
+		Trie.Add(TEXT("/Game/Props"));
+
+		TestFalse(TEXT("/Game/PropsOld"), Trie.ContainsPrefixOf(TEXT("/Game/PropsOld")));
+		TestFalse(TEXT("/Game/PropsOld/Chairs"), Trie.ContainsPrefixOf(TEXT("/Game/PropsOld/Chairs")));
+		TestFalse(TEXT("/Game/Prop"), Trie.ContainsPrefixOf(TEXT("/Game/Prop")));
+		TestFalse(TEXT("Parent"), Trie.ContainsPrefixOf(TEXT("/Game")));
+	});
+
+	It("should be empty until path is added", [this]()
+	{
+		FCleanerPathTrie Trie;
+		TestTrue(TEXT("New"), Trie.IsEmpty());
+		TestFalse(TEXT("Nothing matches"), Trie.ContainsPrefixOf(TEXT("/Game")));
+
+		Trie.Add(TEXT("/Game/Maps"));
+		TestFalse(TEXT("After Add"), Trie.IsEmpty());
+
+		Trie.Reset();
+		TestTrue(TEXT("After Reset"), Trie.IsEmpty());
+	});
+}
+
+BEGIN_DEFINE_SPEC(FCleanerContentFilesSpec, "ProjectCleaner.Core.ContentFiles", ProjectCleanerAnalysisCoreSpec::TestFlags)
+END_DEFINE_SPEC(FCleanerContentFilesSpec)
+
+void FCleanerContentFilesSpec::Define()
+{
+	It("should sort extensions into package and companion files", [this]()
+	{
+		TestTrue(TEXT("uasset"), FCleanerContentFiles::IsPackageExtension(TEXT("uasset")));
+		TestTrue(TEXT("umap"), FCleanerContentFiles::IsPackageExtension(TEXT("umap")));
+		TestFalse(TEXT("uexp is not package"), FCleanerContentFiles::IsPackageExtension(TEXT("uexp")));
+		TestTrue(TEXT("uexp"), FCleanerContentFiles::IsCompanionExtension(TEXT("uexp")));
+		TestTrue(TEXT("UBULK"), FCleanerContentFiles::IsCompanionExtension(TEXT("UBULK")));
+		TestFalse(TEXT("txt"), FCleanerContentFiles::IsCompanionExtension(TEXT("txt")));
+	});
+
+	It("should give same stem to package and its companion files", [this]()
+	{
+		TestEqual(TEXT("Package"), FCleanerContentFiles::GetPackageFileStem(TEXT("C:/Content/T_Rock.uasset")), FString{TEXT("C:/Content/T_Rock")});
+		TestEqual(TEXT("Mip tail"), FCleanerContentFiles::GetPackageFileStem(TEXT("C:/Content/T_Rock.m.ubulk")), FString{TEXT("C:/Content/T_Rock")});
+		TestEqual(TEXT("Dot in folder"), FCleanerContentFiles::GetPackageFileStem(TEXT("C:/My.Project/Content/T_Rock.uexp")), FString{TEXT("C:/My.Project/Content/T_Rock")});
+	});
+}
+
+BEGIN_DEFINE_SPEC(FCleanerClassHierarchySpec, "ProjectCleaner.Core.ClassHierarchy", ProjectCleanerAnalysisCoreSpec::TestFlags)
+END_DEFINE_SPEC(FCleanerClassHierarchySpec)
+
+void FCleanerClassHierarchySpec::Define()
+{
+	It("should match classes deeper in hierarchy", [this]()
+	{
+		FCleanerClassHierarchy Hierarchy;
+		Hierarchy.Add(TEXT("BP_Grandchild_C"), TEXT("BP_Child_C"));
+		Hierarchy.Add(TEXT("BP_Child_C"), TEXT("PrimaryDataAsset"));
+
+		const TSet<FName> BaseClasses{TEXT("PrimaryDataAsset")};
+		TestTrue(TEXT("Base"), Hierarchy.IsChildOfAny(TEXT("PrimaryDataAsset"), BaseClasses));
+		TestTrue(TEXT("Child"), Hierarchy.IsChildOfAny(TEXT("BP_Child_C"), BaseClasses));
+		TestTrue(TEXT("Grandchild"), Hierarchy.IsChildOfAny(TEXT("BP_Grandchild_C"), BaseClasses));
+		TestFalse(TEXT("Unknown"), Hierarchy.IsChildOfAny(TEXT("BP_Other_C"), BaseClasses));
+	});
+
+	It("should end walk on parent cycle", [this]()
+	{
+		FCleanerClassHierarchy Hierarchy;
+		Hierarchy.Add(TEXT("A"), TEXT("B"));
+		Hierarchy.Add(TEXT("B"), TEXT("A"));
+
+		TestFalse(TEXT("Cycle"), Hierarchy.IsChildOfAny(TEXT("A"), TSet<FName>{TEXT("C")}));
+	});
+}
+
+BEGIN_DEFINE_SPEC(FCleanerIndirectReferenceMatcherSpec, "ProjectCleaner.Core.IndirectReferenceMatcher", ProjectCleanerAnalysisCoreSpec::TestFlags)
+END_DEFINE_SPEC(FCleanerIndirectReferenceMatcherSpec)
+
+void FCleanerIndirectReferenceMatcherSpec::Define()
+{
+	It("should report 1-based line of every reference", [this]()
+	{
+		const FString Content =
+			TEXT("[/Script/Engine.GameMapsSettings]\n")
+			TEXT("GameDefaultMap=/Game/Maps/Main.Main\n")
+			TEXT("\n")
+			TEXT("Texture=/Game/UI/T_Icon.T_Icon Sound=/Game/Audio/S_Click.S_Click\n");
+
+		TArray<FCleanerIndirectReference> References;
+		FCleanerIndirectReferenceMatcher::FindReferences(Content, References);
+
+		if (!TestEqual(TEXT("References"), References.Num(), 3)) return;
+
+		TestEqual(TEXT("First path"), References[0].ObjectPath, FString{TEXT("/Game/Maps/Main.Main")});
+		TestEqual(TEXT("First line"), References[0].Line, 2);
+		TestEqual(TEXT("Second path"), References[1].ObjectPath, FString{TEXT("/Game/UI/T_Icon.T_Icon")});
+		TestEqual(TEXT("Second line"), References[1].Line, 4);
+		TestEqual(TEXT("Third line"), References[2].Line, 4);
+	});
+
+	It("should remove blueprint class suffix", [this]()
+	{
+		TArray<FCleanerIndirectReference> References;
+		FCleanerIndirectReferenceMatcher::FindReferences(TEXT("LoadClass(\"/Game/Blueprints/BP_Hero.BP_Hero_C\")"), References);
+
+		if (!TestEqual(TEXT("References"), References.Num(), 1)) return;
+
+		TestEqual(TEXT("Path"), References[0].ObjectPath, FString{TEXT("/Game/Blueprints/BP_Hero.BP_Hero")});
+	});
+
+	It("should end reference at word boundary", [this]()
+	{
+		TArray<FCleanerIndirectReference> References;
+		FCleanerIndirectReferenceMatcher::FindReferences(TEXT("See /Game/Maps/. and /Game/ or /Game"), References);
+
+		if (!TestEqual(TEXT("References"), References.Num(), 1)) return;
+
+		TestEqual(TEXT("Path"), References[0].ObjectPath, FString{TEXT("/Game/Maps")});
+	});
+}
+
+BEGIN_DEFINE_SPEC(FCleanerDeletionPlannerSpec, "ProjectCleaner.Core.DeletionPlanner", ProjectCleanerAnalysisCoreSpec::TestFlags)
+END_DEFINE_SPEC(FCleanerDeletionPlannerSpec)
+
+void FCleanerDeletionPlannerSpec::Define()
+{
+	using namespace ProjectCleanerAnalysisCoreSpec;
+
+	It("should put referencers into earlier buckets than their dependencies", [this]()
+	{
+		// chain 0 -> 1 -> 2, 3 is not deletable and depends on 2
+		const FCleanerDependencyGraph Graph = MakeGraph(4, {{0, 1}, {1, 2}, {3, 2}});
+		TBitArray<> Deletable{true, 4};
+		Deletable[3] = false;
+
+		TArray<TArray<int32>> Buckets;
+		FCleanerDeletionPlanner::Plan(Graph, Deletable, 1, Buckets);
+		const TArray<int32> NodeBuckets = GetNodeBuckets(4, Buckets);
+
+		TestEqual(TEXT("Buckets"), Buckets.Num(), 3);
+		TestTrue(TEXT("0 before 1"), NodeBuckets[0] < NodeBuckets[1]);
+		TestTrue(TEXT("1 before 2"), NodeBuckets[1] < NodeBuckets[2]);
+		TestEqual(TEXT("Not deletable node"), NodeBuckets[3], INDEX_NONE);
+	});
+
+	It("should keep cycle together with its referencers and before its dependencies", [this]()
+	{
+		// 0 references cycle 1 <-> 2, which depends on 3
+		const FCleanerDependencyGraph Graph = MakeGraph(4, {{0, 1}, {1, 2}, {2, 1}, {2, 3}});
+		const TBitArray<> Deletable{true, 4};
+
+		TArray<TArray<int32>> Buckets;
+		FCleanerDeletionPlanner::Plan(Graph, Deletable, 1, Buckets);
+		const TArray<int32> NodeBuckets = GetNodeBuckets(4, Buckets);
+
+		int32 PlannedNum = 0;
+		for (const auto& Bucket : Buckets)
+		{
+			PlannedNum += Bucket.Num();
+		}
+
+		TestEqual(TEXT("Planned nodes"), PlannedNum, 4);
+		TestEqual(TEXT("Cycle in one bucket"), NodeBuckets[1], NodeBuckets[2]);
+		TestTrue(TEXT("Referencer not after cycle"), NodeBuckets[0] <= NodeBuckets[1]);
+		TestTrue(TEXT("Dependency after cycle"), NodeBuckets[3] > NodeBuckets[1]);
+	});
+
+	It("should fill buckets up to given size", [this]()
+	{
+		const FCleanerDependencyGraph Graph = MakeGraph(5, {});
+		const TBitArray<> Deletable{true, 5};
+
+		TArray<TArray<int32>> Buckets;
+		FCleanerDeletionPlanner::Plan(Graph, Deletable, 2, Buckets);
+
+		if (!TestEqual(TEXT("Buckets"), Buckets.Num(), 3)) return;
+
+		TestEqual(TEXT("First bucket"), Buckets[0].Num(), 2);
+		TestEqual(TEXT("Last bucket"), Buckets[2].Num(), 1);
+	});
+}
+
+BEGIN_DEFINE_SPEC(FCleanerFootprintCalculatorSpec, "ProjectCleaner.Core.FootprintCalculator", ProjectCleanerAnalysisCoreSpec::TestFlags)
+END_DEFINE_SPEC(FCleanerFootprintCalculatorSpec)
+
+void FCleanerFootprintCalculatorSpec::Define()
+{
+	using namespace ProjectCleanerAnalysisCoreSpec;
+
+	// 0 and 1 both depend on 2, which depends on 3
+	const TArray<TPair<int32, int32>> Edges{{0, 2}, {1, 2}, {2, 3}};
+	const TArray<int64> Sizes{1, 2, 4, 8};
+
+	It("should not count shared dependencies as exclusive", [this, Edges, Sizes]()
+	{
+		FCleanerFootprintCalculator Calculator;
+		Calculator.Build(MakeGraph(4, Edges), Sizes);
+
+		FCleanerFootprint Footprint;
+		Calculator.Calculate({0}, Footprint);
+
+		TestEqual(TEXT("Transitive size"), Footprint.TransitiveSize, static_cast<int64>(13));
+		TestEqual(TEXT("Transitive num"), Footprint.TransitiveNum, 3);
+		TestEqual(TEXT("Exclusive size"), Footprint.ExclusiveSize, static_cast<int64>(1));
+		TestEqual(TEXT("Exclusive num"), Footprint.ExclusiveNum, 1);
+	});
+
+	It("should own dependencies shared by selected nodes only", [this, Edges, Sizes]()
+	{
+		FCleanerFootprintCalculator Calculator;
+		Calculator.Build(MakeGraph(4, Edges), Sizes);
+
+		FCleanerFootprint Footprint;
+		Calculator.Calculate({0, 1}, Footprint);
+
+		TestEqual(TEXT("Transitive size"), Footprint.TransitiveSize, static_cast<int64>(15));
+		TestEqual(TEXT("Exclusive size"), Footprint.ExclusiveSize, static_cast<int64>(15));
+	});
+
+	It("should select whole cycle", [this]()
+	{
+		FCleanerFootprintCalculator Calculator;
+		Calculator.Build(MakeGraph(3, {{0, 1}, {1, 0}, {1, 2}}), {1, 2, 4});
+
+		FCleanerFootprint Footprint;
+		Calculator.Calculate({0}, Footprint);
+
+		TestEqual(TEXT("Components"), Calculator.GetComponentsNum(), 2);
+		TestEqual(TEXT("Exclusive size"), Footprint.ExclusiveSize, static_cast<int64>(7));
+		TestEqual(TEXT("Exclusive num"), Footprint.ExclusiveNum, 3);
+	});
+}
+
+BEGIN_DEFINE_SPEC(FCleanerTopKSpec, "ProjectCleaner.Core.TopK", ProjectCleanerAnalysisCoreSpec::TestFlags)
+END_DEFINE_SPEC(FCleanerTopKSpec)
+
+void FCleanerTopKSpec::Define()
+{
+	It("should keep biggest entries sorted", [this]()
+	{
+		FCleanerTopK TopK{2};
+		TopK.Add(TEXT("A"), 5);
+		TopK.Add(TEXT("B"), 1);
+		TopK.Add(TEXT("C"), 7);
+		TopK.Add(TEXT("D"), 3);
+
+		TArray<FCleanerTopK::FEntry> Entries;
+		TopK.GetSorted(Entries);
+
+		if (!TestEqual(TEXT("Entries"), Entries.Num(), 2)) return;
+
+		TestTrue(TEXT("First"), Entries[0].Name == TEXT("C"));
+		TestEqual(TEXT("First size"), Entries[0].Size, static_cast<int64>(7));
+		TestTrue(TEXT("Second"), Entries[1].Name == TEXT("A"));
+		TestEqual(TEXT("Second size"), Entries[1].Size, static_cast<int64>(5));
+	});
+}
+
+#endif
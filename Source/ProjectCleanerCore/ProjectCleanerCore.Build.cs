@@ -0,0 +1,24 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class ProjectCleanerCore : ModuleRules
+{
+	public ProjectCleanerCore(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+
+		// Core only, module is linked into standalone programs that never load editor
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+			}
+		);
+
+
+		// report compression
+		AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib");
+	}
+}
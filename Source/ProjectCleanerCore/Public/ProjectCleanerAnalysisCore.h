@@ -0,0 +1,186 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+// Engine Headers
+#include "CoreMinimal.h"
+
+/**
+ * Analysis algorithms working on plain data only
+ * Module depends on Core only, so it is built and unit tested in standalone programs without editor
+ */
+
+/**
+ * Package dependency graph in compressed sparse row form
+ * Nodes are plain indices, edge A -> B means A depends on B
+ */
+class PROJECTCLEANERCORE_API FCleanerDependencyGraph
+{
+public:
+	void Build(const int32 NodesNum, const TArray<TPair<int32, int32>>& Edges);
+	void Reset();
+	/** Same graph with every edge flipped, dependencies become referencers */
+	FCleanerDependencyGraph Reverse() const;
+
+	int32 GetNodesNum() const;
+	int32 GetEdgesNum() const;
+	TArrayView<const int32> GetEdges(const int32 Node) const;
+
+	/** Marks every node reachable from given roots, roots included */
+	void FindReachable(const TArray<int32>& Roots, TBitArray<>& OutReachable) const;
+	/**
+	 * Strongly connected components, returns their number
+	 * Component ids are in reverse topological order, component depends only on components with smaller ids
+	 */
+	int32 FindComponents(TArray<int32>& OutComponents) const;
+	/** Graph of components, components are connected if any of their nodes are, without self edges */
+	FCleanerDependencyGraph Condense(const TArray<int32>& Components, const int32 ComponentsNum) const;
+private:
+	/** Edges of node N are Targets[Offsets[N]] .. Targets[Offsets[N + 1] - 1] */
+	TArray<int32> Offsets;
+	TArray<int32> Targets;
+};
+
+/**
+ * Set of paths matched by whole segments
+ * "/Game/Props" contains "/Game/Props" and "/Game/Props/Chairs", but not "/Game/PropsOld"
+ */
+class PROJECTCLEANERCORE_API FCleanerPathTrie
+{
+public:
+	FCleanerPathTrie();
+
+	void Add(const FString& Path);
+	void Reset();
+	bool IsEmpty() const;
+	/** True if given path is one of added paths or is under one of them */
+	bool ContainsPrefixOf(const FString& Path) const;
+private:
+	struct FNode
+	{
+		/** Segment keys are compared case insensitive, same as package paths */
+		TMap<FString, int32> Children;
+		bool bTerminal = false;
+	};
+
+	TArray<FNode> Nodes;
+};
+
+/**
+ * Kinds of files found in Content folder, same rules for editor analysis and standalone programs
+ */
+class PROJECTCLEANERCORE_API FCleanerContentFiles
+{
+public:
+	/** .uasset and .umap, extension without dot */
+	static bool IsPackageExtension(const FString& Extension);
+	/** .uexp, .ubulk and .uptnl, written next to package file and part of its footprint */
+	static bool IsCompanionExtension(const FString& Extension);
+	/** Path without extensions, same for package file and all its companion files */
+	static FString GetPackageFileStem(const FString& FilePath);
+};
+
+/**
+ * Class hierarchy known by parent class names only, e.g. blueprint classes of serialized asset registry
+ * Classes without known parent end the walk, so native hierarchy must be added to be followed
+ */
+class PROJECTCLEANERCORE_API FCleanerClassHierarchy
+{
+public:
+	void Add(const FName ClassName, const FName ParentClassName);
+	void Reset();
+	int32 Num() const;
+	/** True if class is one of given classes or derives from one of them */
+	bool IsChildOfAny(const FName ClassName, const TSet<FName>& BaseClassNames) const;
+private:
+	TMap<FName, FName> Parents;
+};
+
+struct FCleanerIndirectReference
+{
+	/** Referenced path, with blueprint "_C" suffix removed */
+	FString ObjectPath;
+	/** 1-based */
+	int32 Line = 0;
+};
+
+/**
+ * Finds "/Game/..." references in source and config files
+ * Hand written equivalent of \/Game([A-Za-z0-9_.\/]+)\b pattern, tracking line numbers in same pass
+ */
+class PROJECTCLEANERCORE_API FCleanerIndirectReferenceMatcher
+{
+public:
+	static void FindReferences(const FString& Content, TArray<FCleanerIndirectReference>& OutReferences);
+private:
+	/** Returns end of reference starting at Index, or INDEX_NONE if there is no reference */
+	static int32 MatchAt(const FString& Content, const int32 Index);
+};
+
+/**
+ * Orders deletion so no package is deleted before packages that reference it
+ */
+class PROJECTCLEANERCORE_API FCleanerDeletionPlanner
+{
+public:
+	/**
+	 * Splits deletable nodes into buckets of about BucketSize nodes
+	 * Node always lands in same or later bucket than its referencers
+	 * Nodes in dependency cycles are kept in one bucket together with all their referencers
+	 */
+	static void Plan(const FCleanerDependencyGraph& Graph, const TBitArray<>& Deletable, const int32 BucketSize, TArray<TArray<int32>>& OutBuckets);
+};
+
+struct FCleanerFootprint
+{
+	/** Given nodes and everything they depend on */
+	int64 TransitiveSize = 0;
+	int32 TransitiveNum = 0;
+	/** Part of transitive footprint nothing else depends on, it goes away together with given nodes */
+	int64 ExclusiveSize = 0;
+	int32 ExclusiveNum = 0;
+};
+
+/**
+ * Transitive and exclusive footprint of any set of nodes
+ * Graph is condensed into DAG of strongly connected components once, queries walk components only
+ */
+class PROJECTCLEANERCORE_API FCleanerFootprintCalculator
+{
+public:
+	void Build(const FCleanerDependencyGraph& Graph, const TArray<int64>& NodeSizes);
+	void Reset();
+	int32 GetComponentsNum() const;
+	void Calculate(const TArray<int32>& Nodes, FCleanerFootprint& OutFootprint) const;
+private:
+	TArray<int32> Components;
+	TArray<int64> ComponentSizes;
+	TArray<int32> ComponentNodesNum;
+	FCleanerDependencyGraph Dependencies;
+	FCleanerDependencyGraph Referencers;
+};
+
+/**
+ * Keeps only K biggest entries out of streamed ones
+ * Min heap on size, so every new entry is compared with smallest kept entry only
+ */
+class PROJECTCLEANERCORE_API FCleanerTopK
+{
+public:
+	struct FEntry
+	{
+		FName Name;
+		int64 Size = 0;
+	};
+
+	explicit FCleanerTopK(const int32 InCapacity = 0);
+
+	void Reset(const int32 InCapacity);
+	void Add(const FName Name, const int64 Size);
+	int32 Num() const;
+	/** Kept entries, biggest first */
+	void GetSorted(TArray<FEntry>& OutEntries) const;
+private:
+	TArray<FEntry> Heap;
+	int32 Capacity;
+};
@@ -0,0 +1,68 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+#include "ProjectCleanerAnalysisCore.h"
+// Engine Headers
+#include "CoreMinimal.h"
+
+enum class ECleanerFixtureTopology : uint8
+{
+	Mixed,
+	Chain,
+	FanOut,
+	Cycle,
+};
+
+/**
+ * Shape of generated in-memory package graph, same meaning as in synthetic benchmark project
+ */
+struct FCleanerCoreBenchmarkSettings
+{
+	FString RootPath = TEXT("/Game/ProjectCleanerBench");
+	int32 NodesNum = 10000;
+	ECleanerFixtureTopology Topology = ECleanerFixtureTopology::Mixed;
+	int32 ClusterSize = 64;
+	int32 FanOut = 8;
+	int32 NodesPerFolder = 500;
+	/** Fraction of clusters whose root is referenced from generated config file */
+	float IndirectRatio = 0.1f;
+	int32 Seed = 0;
+
+	static bool ParseTopology(const FString& Value, ECleanerFixtureTopology& OutTopology);
+	static const TCHAR* TopologyToString(const ECleanerFixtureTopology Topology);
+};
+
+/**
+ * Analysis core algorithms timed on generated graph, no assets or files involved
+ * Stages are handed to caller, so editor commandlet and standalone programs measure them their own way
+ */
+class PROJECTCLEANERCORE_API FCleanerCoreBenchmark
+{
+public:
+	explicit FCleanerCoreBenchmark(const FCleanerCoreBenchmarkSettings& InSettings);
+
+	/** Adds stages of single iteration in order, every stage returns number of items it processed */
+	void AddStages(TFunctionRef<void(const FName Name, TFunction<int64()> Work)> AddStage);
+	/** Results of last run iteration */
+	FString GetSummary() const;
+private:
+	FCleanerCoreBenchmarkSettings Settings;
+
+	/* Generated input */
+	TArray<TPair<int32, int32>> Edges;
+	TArray<int32> Roots;
+	TArray<int64> NodeSizes;
+	TArray<FString> PackagePaths;
+	FString FileContent;
+
+	/* Results of current iteration */
+	FCleanerDependencyGraph Graph;
+	TBitArray<> Reachable;
+	TArray<TArray<int32>> Buckets;
+	FCleanerPathTrie Trie;
+	int32 ExcludedNum = 0;
+	TArray<FCleanerIndirectReference> References;
+	FCleanerFootprintCalculator FootprintCalculator;
+	FCleanerFootprint Footprint;
+};
@@ -0,0 +1,70 @@
+// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+// Engine Headers
+#include "CoreMinimal.h"
+
+enum class ECleanerReportFormat : uint8
+{
+	Json,
+	Csv,
+	NdJson,
+};
+
+/**
+ * Streams report rows straight to file, optionally gzip compressed
+ * Only current row is kept in memory, so report size does not affect memory usage
+ * Shared by editor analysis and standalone analyzer program, so both write same report
+ *
+ * Json   - {"category": [{row}, ...], ...}
+ * NdJson - one {"category": "...", ...} object per line
+ * Csv    - single table, every category uses its own subset of columns
+ */
+class PROJECTCLEANERCORE_API FProjectCleanerReportWriter
+{
+public:
+	FProjectCleanerReportWriter(const ECleanerReportFormat InFormat, const bool bInCompress);
+	~FProjectCleanerReportWriter();
+
+	bool Open(const FString& FilePath);
+	/** Finishes document and flushes compressed stream, false if any write failed */
+	bool Close();
+
+	void BeginCategory(const TCHAR* Category);
+	void EndCategory();
+	void BeginRow();
+	void AddString(const TCHAR* Column, const FString& Value);
+	void AddInteger(const TCHAR* Column, const int64 Value);
+	void AddNumber(const TCHAR* Column, const double Value);
+	void EndRow();
+
+	int64 GetRowsNum() const;
+
+	static bool ParseFormat(const FString& Value, ECleanerReportFormat& OutFormat);
+	static FString GetDefaultReportPath(const ECleanerReportFormat Format, const bool bCompress);
+private:
+	void AddField(const TCHAR* Column, const FString& JsonValue, const FString& CsvValue);
+	void Write(const FString& Text);
+	bool WriteBytes(const uint8* Data, const int64 Size);
+	bool FlushCompressed(const bool bFinish);
+	static FString EscapeJson(const FString& Value);
+	static FString EscapeCsv(const FString& Value);
+
+	ECleanerReportFormat Format;
+	bool bCompress;
+	bool bFailed = false;
+	bool bFirstCategory = true;
+	bool bFirstRow = true;
+	bool bFirstField = true;
+	int64 RowsNum = 0;
+	FString Category;
+	/** Current row only */
+	FString Row;
+	TArray<FString> CsvRow;
+	TUniquePtr<FArchive> FileWriter;
+
+	/** zlib state lives in cpp, so zlib headers do not leak into plugin */
+	struct FGzipStream;
+	TUniquePtr<FGzipStream> GzipStream;
+};